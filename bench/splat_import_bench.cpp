@@ -0,0 +1,350 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Import benchmark suite.
+ *
+ * Generates deterministic synthetic `.ply` files (see `splat_ply_generator.h`)
+ * and measures each stage of the importer, reporting splats/s, GB/s and the
+ * ratio to a `memcpy` of the same bytes (the roofline for any stage that has
+ * to touch the whole file). Results are written as JSON so runs can be
+ * compared over time.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. \
+ *       bench/splat_import_bench.cpp bench/splat_ply_generator.cpp \
+ *       import/splat_logging.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_import_bench
+ *
+ * Usage:
+ *
+ *   splat_import_bench [--quick] [--repetitions <n>] [--max-splats <n>]
+ *                      [--output <file.json>]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "bench/splat_ply_generator.h"
+#include "import/ply/splat_ply_conversion.h"
+#include "import/ply/splat_ply_parsing.h"
+#include "import/splat_logging.h"
+
+namespace bench {
+namespace {
+/**
+ * Minimal stand-ins for engine vector types, as accepted by `convert_splat`.
+ */
+struct Float3 {
+  Float3() = default;
+  Float3(float x, float y, float z) : x(x), y(y), z(z) {}
+  float x = 0.f, y = 0.f, z = 0.f;
+};
+
+struct Float4 {
+  Float4() = default;
+  Float4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+  float x = 0.f, y = 0.f, z = 0.f, w = 0.f;
+};
+
+struct Color {
+  Color() = default;
+  Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a) : r(r), g(g), b(b), a(a) {}
+  uint8_t r = 0, g = 0, b = 0, a = 0;
+};
+
+struct Options {
+  uint32_t repetitions = 5;
+  uint64_t max_splats = 20'000'000;
+  bool quick = false;
+  const char* output = nullptr;
+};
+
+struct StageResult {
+  std::string name;
+  double seconds_min = 0.;
+  double seconds_median = 0.;
+  uint64_t items = 0;
+  uint64_t bytes = 0;
+};
+
+struct ConfigResult {
+  std::string config;
+  PlySettings settings;
+  uint64_t file_bytes = 0;
+  double memcpy_seconds = 0.;
+  std::vector<StageResult> stages;
+};
+
+/**
+ * Keeps results observable, so the optimizer can't remove measured work.
+ */
+volatile uint64_t sink = 0;
+
+/**
+ * Times `fn` `repetitions` times, returning (min, median) in seconds.
+ */
+std::pair<double, double> measure(uint32_t repetitions,
+                                  const std::function<void()>& fn) {
+  std::vector<double> times;
+  for (uint32_t i = 0; i < repetitions; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    times.push_back(std::chrono::duration<double>(end - start).count());
+  }
+  std::sort(times.begin(), times.end());
+  return {times.front(), times[times.size() / 2]};
+}
+
+/**
+ * Measures a conversion helper in isolation over `values`, converting one raw
+ * value per iteration.
+ */
+template <typename F>
+StageResult measure_helper(const char* name, const std::vector<float>& values,
+                           uint32_t repetitions, F&& helper) {
+  StageResult result{name};
+  auto [min, median] = measure(repetitions, [&]() {
+    uint64_t acc = 0;
+    for (float value : values) {
+      acc += static_cast<uint64_t>(helper(import::PropertyType(value)));
+    }
+    sink = sink + acc;
+  });
+  result.seconds_min = min;
+  result.seconds_median = median;
+  result.items = values.size();
+  result.bytes = values.size() * sizeof(float);
+  return result;
+}
+
+/**
+ * Measures all stages over a file generated with `settings`.
+ *
+ * @return Whether the file parses and validates. Otherwise no stage is timed,
+ * as each would return early and report near-zero times.
+ */
+bool run_config(const PlySettings& settings, uint32_t repetitions,
+                ConfigResult& result) {
+  result.config = describe(settings);
+  result.settings = settings;
+
+  std::vector<uint8_t> file = generate_ply(settings);
+  result.file_bytes = file.size();
+  {
+    import::ply::SplatParserPly parser;
+    import::Metadata metadata;
+    if (!parser.parse_metadata(file, metadata) ||
+        !import::ply::validate_metadata(metadata)) {
+      fprintf(stderr, "Unable to parse the generated file for %s.\n",
+              result.config.c_str());
+      return false;
+    }
+  }
+
+  // Roofline: a straight copy of the file, into already-faulted memory.
+  std::vector<uint8_t> copy(file.size(), 1);
+  result.memcpy_seconds = measure(repetitions, [&]() {
+                            std::memcpy(copy.data(), file.data(), file.size());
+                            sink = sink + copy[copy.size() / 2];
+                          }).first;
+
+  // `parse_metadata`.
+  {
+    StageResult stage{"parse_metadata"};
+    auto [min, median] = measure(repetitions, [&]() {
+      import::ply::SplatParserPly parser;
+      import::Metadata metadata;
+      bool success = parser.parse_metadata(file, metadata);
+      sink = sink + (success ? metadata.num_splats : 0);
+    });
+    stage.seconds_min = min;
+    stage.seconds_median = median;
+    stage.items = settings.num_splats;
+    stage.bytes = file.size() - settings.num_splats *
+                                    get_num_properties(settings) *
+                                    sizeof(float);
+    result.stages.push_back(stage);
+  }
+
+  // `parse_data` + `convert_splat`.
+  {
+    std::vector<Float3> positions(settings.num_splats);
+    std::vector<Float4> rotations(settings.num_splats);
+    std::vector<Float3> scales(settings.num_splats);
+    std::vector<Color> colors(settings.num_splats);
+
+    StageResult stage{"parse_data+convert_splat"};
+    auto [min, median] = measure(repetitions, [&]() {
+      import::ply::SplatParserPly parser;
+      import::Metadata metadata;
+      parser.parse_metadata(file, metadata);
+      parser.parse_data([&](uint64_t index, import::GetPropertyFn get) {
+        import::ply::convert_splat<Float3, Float4, Color>(
+            index, get, positions, rotations, scales, colors);
+      });
+      sink = sink + colors.back().a;
+    });
+    stage.seconds_min = min;
+    stage.seconds_median = median;
+    stage.items = settings.num_splats;
+    stage.bytes = file.size();
+    result.stages.push_back(stage);
+  }
+
+  // Conversion helpers, one raw value per splat.
+  {
+    std::vector<float> values(settings.num_splats);
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = -4.f + 8.f * static_cast<float>(i % 4096) / 4096.f;
+    }
+
+    result.stages.push_back(measure_helper(
+        "to<float>", values, repetitions,
+        [](import::PropertyType v) { return import::to<float>(v) > 0.f; }));
+    result.stages.push_back(
+        measure_helper("to_color_linear", values, repetitions,
+                       [](import::PropertyType v) {
+                         return import::to_color_linear(v);
+                       }));
+    result.stages.push_back(
+        measure_helper("to_alpha_linear", values, repetitions,
+                       [](import::PropertyType v) {
+                         return import::to_alpha_linear(v);
+                       }));
+    result.stages.push_back(
+        measure_helper("to_scale_linear", values, repetitions,
+                       [](import::PropertyType v) {
+                         return import::to_scale_linear(v) > 1.f;
+                       }));
+  }
+
+  return true;
+}
+
+void write_json(FILE* out, const Options& options,
+                const std::vector<ConfigResult>& results) {
+  fprintf(out, "{\n  \"schema\": 1,\n  \"repetitions\": %u,\n",
+          options.repetitions);
+  fprintf(out, "  \"results\": [\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const ConfigResult& config = results[i];
+    double memcpy_gbps = config.file_bytes / config.memcpy_seconds / 1e9;
+
+    fprintf(out, "    {\n");
+    fprintf(out, "      \"config\": \"%s\",\n", config.config.c_str());
+    fprintf(out, "      \"num_splats\": %llu,\n",
+            static_cast<unsigned long long>(config.settings.num_splats));
+    fprintf(out, "      \"file_bytes\": %llu,\n",
+            static_cast<unsigned long long>(config.file_bytes));
+    fprintf(out, "      \"memcpy_gbps\": %.4f,\n", memcpy_gbps);
+    fprintf(out, "      \"stages\": [\n");
+    for (size_t j = 0; j < config.stages.size(); ++j) {
+      const StageResult& stage = config.stages[j];
+      double gbps = stage.bytes / stage.seconds_min / 1e9;
+      fprintf(out,
+              "        {\"name\": \"%s\", \"seconds_min\": %.9f, "
+              "\"seconds_median\": %.9f, \"splats_per_second\": %.1f, "
+              "\"gbps\": %.4f, \"roofline_ratio\": %.6f}%s\n",
+              stage.name.c_str(), stage.seconds_min, stage.seconds_median,
+              stage.items / stage.seconds_min, gbps, gbps / memcpy_gbps,
+              j + 1 < config.stages.size() ? "," : "");
+    }
+    fprintf(out, "      ]\n    }%s\n", i + 1 < results.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+}
+
+void print_log(Level level, const char* message) {
+  fprintf(stderr, "%s: %s\n", level == Level::ERROR ? "error" : "warning",
+          message);
+}
+}  // namespace
+}  // namespace bench
+
+int main(int argc, char** argv) {
+  using namespace bench;
+
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--quick") {
+      options.quick = true;
+    } else if (arg == "--repetitions" && i + 1 < argc) {
+      options.repetitions = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--max-splats" && i + 1 < argc) {
+      options.max_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--output" && i + 1 < argc) {
+      options.output = argv[++i];
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--quick] [--repetitions <n>] [--max-splats <n>] "
+              "[--output <file.json>]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+  if (options.quick) {
+    options.max_splats = std::min<uint64_t>(options.max_splats, 1'000'000);
+    options.repetitions = std::min(options.repetitions, 3u);
+  }
+
+  set_log_recv(print_log);
+
+  std::vector<PlySettings> configs;
+
+  // Scaling with splat count, for the common layout.
+  for (uint64_t num_splats : {10'000ull, 100'000ull, 1'000'000ull,
+                              5'000'000ull, 20'000'000ull}) {
+    if (num_splats <= options.max_splats) {
+      configs.push_back(PlySettings{.num_splats = num_splats});
+    }
+  }
+
+  // Layout variations, at a fixed count.
+  uint64_t variant_splats = std::min<uint64_t>(1'000'000, options.max_splats);
+  configs.push_back({.num_splats = variant_splats,
+                     .endianness = std::endian::big});
+  configs.push_back({.num_splats = variant_splats,
+                     .order = PropertyOrder::Reversed});
+  configs.push_back({.num_splats = variant_splats,
+                     .order = PropertyOrder::Shuffled});
+  configs.push_back({.num_splats = variant_splats, .num_extra_properties = 8});
+  for (uint32_t sh_degree = 1; sh_degree <= 3; ++sh_degree) {
+    configs.push_back({.num_splats = variant_splats, .sh_degree = sh_degree});
+  }
+
+  std::vector<ConfigResult> results;
+  for (const PlySettings& settings : configs) {
+    fprintf(stderr, "Running %s, %llu splats...\n", describe(settings).c_str(),
+            static_cast<unsigned long long>(settings.num_splats));
+    if (!run_config(settings, options.repetitions, results.emplace_back())) {
+      return 1;
+    }
+  }
+
+  FILE* out = stdout;
+  if (options.output) {
+    out = fopen(options.output, "w");
+    if (!out) {
+      fprintf(stderr, "Unable to open %s.\n", options.output);
+      return 1;
+    }
+  }
+  write_json(out, options, results);
+  if (out != stdout) {
+    fclose(out);
+  }
+
+  return 0;
+}
\ No newline at end of file
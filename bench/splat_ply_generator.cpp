@@ -0,0 +1,162 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_ply_generator.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bench {
+namespace {
+/**
+ * SplitMix64. Small, fast and fully specified, so output is identical
+ * everywhere (unlike `std::uniform_real_distribution`).
+ */
+class Rng {
+ public:
+  explicit Rng(uint64_t seed) : state(seed) {}
+
+  uint64_t next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  float uniform(float min, float max) {
+    float t = static_cast<float>(next() >> 40) / static_cast<float>(1 << 24);
+    return min + (max - min) * t;
+  }
+
+ private:
+  uint64_t state;
+};
+
+enum class Kind { Position, Normal, DC, Rest, Opacity, Scale, Rotation, Extra };
+
+struct GeneratedProperty {
+  std::string name;
+  Kind kind;
+};
+
+std::vector<GeneratedProperty> get_properties(const PlySettings& settings) {
+  std::vector<GeneratedProperty> properties{
+      {"x", Kind::Position},  {"y", Kind::Position},  {"z", Kind::Position},
+      {"nx", Kind::Normal},   {"ny", Kind::Normal},   {"nz", Kind::Normal},
+      {"f_dc_0", Kind::DC},   {"f_dc_1", Kind::DC},   {"f_dc_2", Kind::DC}};
+
+  uint32_t sh_degree = std::min(settings.sh_degree, 3u);
+  uint32_t num_rest = 3 * ((sh_degree + 1) * (sh_degree + 1) - 1);
+  for (uint32_t i = 0; i < num_rest; ++i) {
+    properties.push_back({"f_rest_" + std::to_string(i), Kind::Rest});
+  }
+
+  properties.push_back({"opacity", Kind::Opacity});
+  for (uint32_t i = 0; i < 3; ++i) {
+    properties.push_back({"scale_" + std::to_string(i), Kind::Scale});
+  }
+  for (uint32_t i = 0; i < 4; ++i) {
+    properties.push_back({"rot_" + std::to_string(i), Kind::Rotation});
+  }
+  for (uint32_t i = 0; i < settings.num_extra_properties; ++i) {
+    properties.push_back({"extra_" + std::to_string(i), Kind::Extra});
+  }
+
+  switch (settings.order) {
+    case PropertyOrder::Canonical: {
+      break;
+    }
+    case PropertyOrder::Reversed: {
+      std::reverse(properties.begin(), properties.end());
+      break;
+    }
+    case PropertyOrder::Shuffled: {
+      // Fisher-Yates, with our own RNG for reproducibility.
+      Rng rng(settings.seed ^ 0xD15EA5Eull);
+      for (size_t i = properties.size() - 1; i > 0; --i) {
+        std::swap(properties[i], properties[rng.next() % (i + 1)]);
+      }
+      break;
+    }
+  }
+
+  return properties;
+}
+
+float generate_value(Kind kind, Rng& rng) {
+  switch (kind) {
+    case Kind::Position:
+      return rng.uniform(-50.f, 50.f);
+    case Kind::Normal:
+      return 0.f;
+    case Kind::DC:
+      return rng.uniform(-2.f, 2.f);
+    case Kind::Rest:
+      return rng.uniform(-.3f, .3f);
+    case Kind::Opacity:
+      return rng.uniform(-6.f, 6.f);
+    case Kind::Scale:
+      return rng.uniform(-7.f, -1.f);
+    case Kind::Rotation:
+      return rng.uniform(-1.f, 1.f);
+    case Kind::Extra:
+      return rng.uniform(-1.f, 1.f);
+  }
+  return 0.f;
+}
+}  // namespace
+
+uint32_t get_num_properties(const PlySettings& settings) {
+  return static_cast<uint32_t>(get_properties(settings).size());
+}
+
+std::string describe(const PlySettings& settings) {
+  const char* order = settings.order == PropertyOrder::Canonical ? "canonical"
+                      : settings.order == PropertyOrder::Reversed
+                          ? "reversed"
+                          : "shuffled";
+  const char* endianness =
+      settings.endianness == std::endian::little ? "le" : "be";
+  return std::string(endianness) + "/" + order + "/x" +
+         std::to_string(settings.num_extra_properties) + "/sh" +
+         std::to_string(settings.sh_degree);
+}
+
+std::vector<uint8_t> generate_ply(const PlySettings& settings) {
+  std::vector<GeneratedProperty> properties = get_properties(settings);
+
+  std::string header = "ply\nformat ";
+  header += settings.endianness == std::endian::little
+                ? "binary_little_endian"
+                : "binary_big_endian";
+  header += " 1.0\ncomment generated by splat bench\n";
+  header += "element vertex " + std::to_string(settings.num_splats) + "\n";
+  for (const GeneratedProperty& property : properties) {
+    header += "property float " + property.name + "\n";
+  }
+  header += "end_header\n";
+
+  size_t splat_size = properties.size() * sizeof(float);
+  std::vector<uint8_t> file(header.size() + settings.num_splats * splat_size);
+  std::memcpy(file.data(), header.data(), header.size());
+
+  bool swap = settings.endianness != std::endian::native;
+  uint8_t* out = file.data() + header.size();
+  Rng rng(settings.seed);
+  for (uint64_t i = 0; i < settings.num_splats; ++i) {
+    for (const GeneratedProperty& property : properties) {
+      float value = generate_value(property.kind, rng);
+      uint32_t bits = std::bit_cast<uint32_t>(value);
+      if (swap) {
+        bits = (bits >> 24) | ((bits >> 8) & 0xFF00) |
+               ((bits << 8) & 0xFF0000) | (bits << 24);
+      }
+      std::memcpy(out, &bits, sizeof(bits));
+      out += sizeof(bits);
+    }
+  }
+
+  return file;
+}
+}  // namespace bench
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+/**
+ * Order in which properties are written to the generated header.
+ */
+enum class PropertyOrder {
+  /**
+   * Order written by the reference 3DGS implementation: x, y, z, normals,
+   * f_dc_*, f_rest_*, opacity, scale_*, rot_*.
+   */
+  Canonical,
+  /**
+   * Canonical order, reversed.
+   */
+  Reversed,
+  /**
+   * Deterministic shuffle, derived from the generator seed.
+   */
+  Shuffled
+};
+
+/**
+ * Parameters of a synthetic `.ply` file.
+ */
+struct PlySettings {
+  uint64_t num_splats = 100'000;
+  std::endian endianness = std::endian::little;
+  PropertyOrder order = PropertyOrder::Canonical;
+  /**
+   * Number of extra properties unknown to the importer (written as
+   * `extra_<n>`), which must be skipped.
+   */
+  uint32_t num_extra_properties = 0;
+  /**
+   * Spherical harmonics degree [0, 3]. Degrees above 0 add 3 * ((d + 1)^2 - 1)
+   * `f_rest_<n>` properties, which the importer currently ignores.
+   */
+  uint32_t sh_degree = 0;
+  uint64_t seed = 0x5EED;
+};
+
+/**
+ * Generates a binary `.ply` 3DGS asset. Output is fully determined by
+ * `settings`, so results are comparable across runs and machines.
+ *
+ * Values are drawn from plausible ranges for trained scenes (e.g. log scales
+ * in [-7, -1], logit opacities in [-6, 6]).
+ *
+ * @param settings - Shape of the generated file.
+ * @return The complete file.
+ */
+std::vector<uint8_t> generate_ply(const PlySettings& settings);
+
+/**
+ * @param settings - Shape of the generated file.
+ * @return Number of properties per splat.
+ */
+uint32_t get_num_properties(const PlySettings& settings);
+
+/**
+ * @param settings - Shape of the generated file.
+ * @return Short, human readable description, e.g. "le/canonical/x0/sh0".
+ */
+std::string describe(const PlySettings& settings);
+}  // namespace bench
\ No newline at end of file
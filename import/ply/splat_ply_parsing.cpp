@@ -13,6 +13,7 @@
 #include <unordered_set>
 
 #include "import/splat_logging.h"
+#include "import/splat_tracing.h"
 
 namespace import::ply {
 namespace {
@@ -366,6 +367,8 @@ bool SplatParserPly::parse_header() {
 
 bool SplatParserPly::parse_metadata(std::span<const uint8_t> ply_buffer,
                                     Metadata& metadata) {
+  SPLAT_TRACE_STAGE(TraceStage::ParseMetadata);
+
   buffer = ply_buffer;
 
   if (!parse_header()) {
@@ -387,10 +390,15 @@ bool SplatParserPly::parse_metadata(std::span<const uint8_t> ply_buffer,
   }
   metadata.num_splats = num_splats;
 
+  SPLAT_TRACE_COUNT(TraceStage::ParseMetadata,
+                    ply_buffer.size() - buffer.size(), num_splats);
+
   return true;
 }
 
 bool SplatParserPly::parse_data(ParseSplatFn parse_splat) {
+  SPLAT_TRACE_STAGE(TraceStage::ParseData);
+
   GetPropertyFn get;
   // This pointer will be updated by calls to `get`.
   const uint8_t* splat = &buffer[0];
@@ -424,6 +432,8 @@ bool SplatParserPly::parse_data(ParseSplatFn parse_splat) {
     splat += splat_size;
   }
 
+  SPLAT_TRACE_COUNT(TraceStage::ParseData, buffer.size(), num_splats);
+
   return true;
 }
 }  // namespace import::ply
\ No newline at end of file
@@ -0,0 +1,238 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_cache.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include "import/splat_hash.h"
+#include "import/splat_logging.h"
+
+namespace import {
+namespace {
+/**
+ * Bump whenever the entry layout below changes.
+ */
+constexpr uint32_t cache_magic = 0x434C5053;  // "SPLC"
+constexpr uint32_t cache_version = 1;
+
+/**
+ * Entry layout (native endianness; the cache is local to a machine):
+ *
+ * u32 magic
+ * u32 version
+ * u64 source_hash
+ * u64 source_size
+ * u64 settings_hash
+ * u64 num_buffers
+ * u64 buffer_sizes[num_buffers]
+ * u8  buffer_data[...]
+ * u64 checksum (of all preceding bytes)
+ */
+struct EntryHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t source_hash;
+  uint64_t source_size;
+  uint64_t settings_hash;
+  uint64_t num_buffers;
+};
+
+/**
+ * Seeds for the key hashes, so that a source and settings with identical bytes
+ * don't produce identical halves of the key.
+ */
+constexpr uint64_t source_seed = 0;
+constexpr uint64_t settings_seed = 0x5E77111665ull;
+
+template <typename T>
+void append(std::vector<uint8_t>& out, const T& value) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool consume(std::span<const uint8_t>& in, T& value) {
+  if (in.size() < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&value, in.data(), sizeof(T));
+  in = in.subspan(sizeof(T));
+  return true;
+}
+}  // namespace
+
+SplatImportCache::SplatImportCache(std::filesystem::path directory)
+    : directory(std::move(directory)) {}
+
+ImportCacheKey SplatImportCache::make_key(std::span<const uint8_t> source,
+                                          std::span<const uint8_t> settings) {
+  return ImportCacheKey{hash_buffer(source, source_seed), source.size(),
+                        hash_buffer(settings, settings_seed)};
+}
+
+std::filesystem::path SplatImportCache::get_entry_path(
+    const ImportCacheKey& key) const {
+  char name[64];
+  snprintf(name, sizeof(name), "%016llx%016llx.splatcache",
+           static_cast<unsigned long long>(key.source_hash),
+           static_cast<unsigned long long>(key.settings_hash));
+  return directory / name;
+}
+
+bool SplatImportCache::load(const ImportCacheKey& key,
+                            ImportBuffers& buffers) const {
+  std::filesystem::path path = get_entry_path(key);
+
+  std::error_code ec;
+  uintmax_t file_size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return false;  // Cache miss.
+  }
+
+  std::vector<uint8_t> file(file_size);
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream.read(reinterpret_cast<char*>(file.data()), file.size())) {
+    log_warn("Unable to read import cache entry %s.", path.string().c_str());
+    return false;
+  }
+
+  std::span<const uint8_t> in(file);
+  EntryHeader header;
+  if (!consume(in, header) || header.magic != cache_magic ||
+      header.version != cache_version) {
+    // Stale layout; will be overwritten on store.
+    return false;
+  }
+  if (header.source_hash != key.source_hash ||
+      header.source_size != key.source_size ||
+      header.settings_hash != key.settings_hash) {
+    // Hash collision on the file name. Vanishingly unlikely, but cheap to
+    // check.
+    return false;
+  }
+
+  uint64_t checksum;
+  if (file.size() < sizeof(checksum)) {
+    return false;
+  }
+  std::memcpy(&checksum, file.data() + file.size() - sizeof(checksum),
+              sizeof(checksum));
+  if (checksum != hash_buffer(std::span<const uint8_t>(file).first(
+                      file.size() - sizeof(checksum)))) {
+    log_warn("Corrupt import cache entry %s. Ignoring.",
+             path.string().c_str());
+    return false;
+  }
+
+  std::vector<uint64_t> sizes(header.num_buffers);
+  uint64_t total_size = 0;
+  for (uint64_t& size : sizes) {
+    if (!consume(in, size)) {
+      log_warn("Truncated import cache entry %s.", path.string().c_str());
+      return false;
+    }
+    total_size += size;
+  }
+  if (total_size + sizeof(checksum) != in.size()) {
+    log_warn("Import cache entry %s has unexpected size.",
+             path.string().c_str());
+    return false;
+  }
+
+  buffers.resize(header.num_buffers);
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    buffers[i].assign(in.begin(), in.begin() + sizes[i]);
+    in = in.subspan(sizes[i]);
+  }
+
+  return true;
+}
+
+bool SplatImportCache::store(const ImportCacheKey& key,
+                             const ImportBuffers& buffers) const {
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec) {
+    log_error("Unable to create import cache directory %s: %s.",
+              directory.string().c_str(), ec.message().c_str());
+    return false;
+  }
+
+  size_t total_size = sizeof(EntryHeader) +
+                      buffers.size() * sizeof(uint64_t) + sizeof(uint64_t);
+  for (const std::vector<uint8_t>& buffer : buffers) {
+    total_size += buffer.size();
+  }
+
+  std::vector<uint8_t> file;
+  file.reserve(total_size);
+  append(file, EntryHeader{cache_magic, cache_version, key.source_hash,
+                           key.source_size, key.settings_hash,
+                           buffers.size()});
+  for (const std::vector<uint8_t>& buffer : buffers) {
+    append(file, static_cast<uint64_t>(buffer.size()));
+  }
+  for (const std::vector<uint8_t>& buffer : buffers) {
+    file.insert(file.end(), buffer.begin(), buffer.end());
+  }
+  append(file, hash_buffer(file));
+
+  // Unique per writer, so concurrent stores of the same key don't interleave.
+  std::filesystem::path path = get_entry_path(key);
+  std::filesystem::path temp_path = path;
+  temp_path += "." +
+               std::to_string(std::hash<std::thread::id>{}(
+                                  std::this_thread::get_id()) ^
+                              static_cast<size_t>(
+                                  std::chrono::steady_clock::now()
+                                      .time_since_epoch()
+                                      .count())) +
+               ".tmp";
+
+  {
+    std::ofstream stream(temp_path, std::ios::binary | std::ios::trunc);
+    if (!stream.write(reinterpret_cast<const char*>(file.data()),
+                      file.size())) {
+      log_error("Unable to write import cache entry %s.",
+                temp_path.string().c_str());
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    log_error("Unable to commit import cache entry %s: %s.",
+              path.string().c_str(), ec.message().c_str());
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+
+  return true;
+}
+
+bool SplatImportCache::load_or_import(std::span<const uint8_t> source,
+                                      std::span<const uint8_t> settings,
+                                      ImportFn import_fn,
+                                      ImportBuffers& buffers) const {
+  ImportCacheKey key = make_key(source, settings);
+  if (load(key, buffers)) {
+    return true;
+  }
+
+  buffers.clear();
+  if (!import_fn(buffers)) {
+    return false;
+  }
+
+  if (!store(key, buffers)) {
+    log_warn("Import succeeded, but could not be cached.");
+  }
+  return true;
+}
+}  // namespace import
\ No newline at end of file
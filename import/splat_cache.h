@@ -0,0 +1,115 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace import {
+/**
+ * Identifies a single import: the content of the source asset, plus whatever
+ * settings affect the packed output.
+ */
+struct ImportCacheKey {
+  uint64_t source_hash = 0;
+  uint64_t source_size = 0;
+  uint64_t settings_hash = 0;
+
+  bool operator==(const ImportCacheKey&) const = default;
+};
+
+/**
+ * Packed runtime buffers produced by an import (e.g. positions, covariances,
+ * colors). Their meaning and order are defined by the caller; the cache treats
+ * them as opaque bytes.
+ */
+typedef std::vector<std::vector<uint8_t>> ImportBuffers;
+
+/**
+ * Function type that should be implemented to import a 3DGS asset on a cache
+ * miss. Fills `buffers` with the packed runtime data, and returns whether the
+ * import succeeded.
+ */
+typedef std::function<bool(ImportBuffers& buffers)> ImportFn;
+
+/**
+ * Optional, content-addressed, on-disk cache of imported splat assets.
+ *
+ * Entries are keyed by a hash of the source file and the import settings, so
+ * re-importing unchanged content (re-cooks, CI, the same `.ply` in multiple
+ * maps) costs a hash of the source plus a copy of the cached buffers.
+ *
+ * Entries are written to a temporary file and renamed into place, so
+ * concurrent importers sharing a directory never observe a partial entry.
+ */
+class SplatImportCache {
+ public:
+  /**
+   * @param directory - Directory holding cache entries. Created on first
+   * store, if needed.
+   */
+  SPLAT_EXPORT_API explicit SplatImportCache(std::filesystem::path directory);
+
+  /**
+   * Builds the key for a source asset.
+   *
+   * @param source - The full contents of the source asset (e.g. `.ply` file).
+   * @param settings - Serialized import settings. Anything that changes the
+   * packed output (including the packing format version) should be included,
+   * else stale entries will be returned.
+   * @return Key identifying this import.
+   */
+  SPLAT_EXPORT_API static ImportCacheKey make_key(
+      std::span<const uint8_t> source, std::span<const uint8_t> settings);
+
+  /**
+   * Looks up a previous import.
+   *
+   * @param key - Key from `make_key`.
+   * @param buffers - Upon success, contains the cached buffers.
+   * @return Whether a valid entry was found.
+   */
+  SPLAT_EXPORT_API bool load(const ImportCacheKey& key,
+                             ImportBuffers& buffers) const;
+
+  /**
+   * Stores the result of an import.
+   *
+   * @param key - Key from `make_key`.
+   * @param buffers - Packed buffers to store.
+   * @return Whether the entry was written.
+   */
+  SPLAT_EXPORT_API bool store(const ImportCacheKey& key,
+                              const ImportBuffers& buffers) const;
+
+  /**
+   * Returns cached buffers if present, else runs `import_fn` and stores its
+   * result. A failure to store is logged, but does not fail the import.
+   *
+   * @param source - The full contents of the source asset.
+   * @param settings - Serialized import settings. See `make_key`.
+   * @param import_fn - Called on a cache miss to perform the import.
+   * @param buffers - Upon success, contains the packed buffers.
+   * @return Whether buffers were loaded or imported successfully.
+   */
+  SPLAT_EXPORT_API bool load_or_import(std::span<const uint8_t> source,
+                                       std::span<const uint8_t> settings,
+                                       ImportFn import_fn,
+                                       ImportBuffers& buffers) const;
+
+  /**
+   * @param key - Key from `make_key`.
+   * @return Path of the entry for `key`, whether or not it exists.
+   */
+  SPLAT_EXPORT_API std::filesystem::path get_entry_path(
+      const ImportCacheKey& key) const;
+
+ private:
+  std::filesystem::path directory;
+};
+}  // namespace import
\ No newline at end of file
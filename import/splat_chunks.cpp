@@ -0,0 +1,149 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_chunks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "import/splat_covariance.h"
+#include "import/splat_logging.h"
+#include "import/splat_morton.h"
+#include "import/splat_tracing.h"
+
+namespace import {
+namespace {
+/**
+ * Minimum number of chunks per task.
+ */
+constexpr size_t min_chunks_per_task = 1 << 7;
+
+/**
+ * Chunks' worth of splats per block. Blocks are split into chunks in
+ * parallel, and always start a chunk, so that chunks don't depend on
+ * scheduling.
+ */
+constexpr size_t chunks_per_block = 1 << 8;
+
+/**
+ * Splits splats [begin, end), in Morton order, into chunks.
+ *
+ * @param first_splats - Output. First splat of each chunk is appended.
+ */
+void split_block(std::span<const Float3> positions,
+                 std::span<const Float3> scales,
+                 std::span<const uint32_t> order,
+                 size_t begin, size_t end, const ChunkSettings& settings,
+                 std::vector<uint32_t>& first_splats) {
+  size_t first = begin;
+  Float3 min;
+  Float3 max;
+  double total_scale = 0.;
+  for (size_t i = begin; i < end; ++i) {
+    uint32_t source = order[i];
+    const Float3& position = positions[source];
+    const Float3& scale = scales[source];
+    float largest_scale = std::max(std::max(scale.x, scale.y), scale.z);
+    if (i > first) {
+      // Span the chunk would have with the splat, and the limit on it.
+      float max_span = settings.max_span_scales *
+                       static_cast<float>((total_scale + largest_scale) /
+                                          static_cast<double>(i - first + 1));
+      bool is_too_wide = false;
+      for (uint32_t axis = 0; axis < 3; ++axis) {
+        is_too_wide |= std::max(max[axis], position[axis]) -
+                           std::min(min[axis], position[axis]) >
+                       max_span;
+      }
+      if (i - first == settings.splats_per_chunk ||
+          (settings.max_span_scales > 0.f && is_too_wide)) {
+        first = i;
+      }
+    }
+    if (i == first) {
+      first_splats.push_back(static_cast<uint32_t>(i));
+      min = max = position;
+      total_scale = 0.;
+    }
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], position[axis]);
+      max[axis] = std::max(max[axis], position[axis]);
+    }
+    total_scale += largest_scale;
+  }
+}
+}  // namespace
+
+bool build_chunks(std::span<const Float3> positions,
+                  std::span<const Float4> rotations,
+                  std::span<const Float3> scales,
+                  const ChunkSettings& settings, SplatChunks& chunks) {
+  SPLAT_TRACE_STAGE(TraceStage::BuildChunks);
+  chunks = SplatChunks();
+  size_t num_splats = positions.size();
+  if (num_splats > std::numeric_limits<uint32_t>::max()) {
+    log_error("Too many splats (%zu) to build chunks for", num_splats);
+    return false;
+  }
+  if (settings.splats_per_chunk == 0) {
+    log_error("Chunks must hold at least 1 splat");
+    return false;
+  }
+
+  std::vector<std::pair<uint64_t, uint32_t>> keys;
+  sort_morton(positions, keys);
+  chunks.order.resize(num_splats);
+  for (size_t i = 0; i < num_splats; ++i) {
+    chunks.order[i] = keys[i].second;
+  }
+
+  size_t block_splats = settings.splats_per_chunk * chunks_per_block;
+  size_t num_blocks = (num_splats + block_splats - 1) / block_splats;
+  std::vector<std::vector<uint32_t>> block_first_splats(num_blocks);
+  parallel_for(num_blocks, 1, [&](size_t begin, size_t end) {
+    for (size_t block = begin; block < end; ++block) {
+      split_block(positions, scales, chunks.order, block * block_splats,
+                  std::min((block + 1) * block_splats, num_splats), settings,
+                  block_first_splats[block]);
+    }
+  });
+  for (const std::vector<uint32_t>& first_splats : block_first_splats) {
+    for (uint32_t first_splat : first_splats) {
+      chunks.chunks.emplace_back().first_splat = first_splat;
+    }
+  }
+
+  size_t num_chunks = chunks.chunks.size();
+  parallel_for(num_chunks, min_chunks_per_task, [&](size_t begin, size_t end) {
+    for (size_t c = begin; c < end; ++c) {
+      SplatChunk& chunk = chunks.chunks[c];
+      size_t first = chunk.first_splat;
+      size_t last = c + 1 < num_chunks ? chunks.chunks[c + 1].first_splat
+                                       : num_splats;
+      chunk.num_splats = static_cast<uint32_t>(last - first);
+      for (size_t i = first; i < last; ++i) {
+        // The extent of an ellipsoid along an axis is the square root of its
+        // variance along that axis.
+        uint32_t source = chunks.order[i];
+        Covariance sig = get_covariance(rotations[source], scales[source]);
+        const Float3& position = positions[source];
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+          float extent = settings.extent_sigma *
+                         static_cast<float>(std::sqrt(sig.m[axis][axis]));
+          float min = position[axis] - extent;
+          float max = position[axis] + extent;
+          chunk.min[axis] = i == first ? min : std::min(chunk.min[axis], min);
+          chunk.max[axis] = i == first ? max : std::max(chunk.max[axis], max);
+        }
+      }
+    }
+  });
+  SPLAT_TRACE_COUNT(TraceStage::BuildChunks,
+                    num_splats * (sizeof(Float3) * 2 + sizeof(Float4)),
+                    num_splats);
+  return true;
+}
+}  // namespace import
\ No newline at end of file
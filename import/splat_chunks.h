@@ -0,0 +1,111 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "import/splat_math.h"
+#include "import/splat_parallel.h"
+
+namespace import {
+/**
+ * Settings of `build_chunks`.
+ */
+struct ChunkSettings {
+  /**
+   * Maximum splats per chunk. Multiples of the thread group size of the
+   * per-splat passes avoid partial thread groups with `CHUNKED_DISPATCH`.
+   */
+  uint32_t splats_per_chunk = 256;
+  /**
+   * Maximum span of a chunk's positions along each axis, in multiples of the
+   * mean largest scale of its splats. Ends chunks early at gaps along the
+   * Morton curve, e.g. between separate objects, whose bounds would
+   * otherwise span both and rarely be culled. 0 disables the limit.
+   */
+  float max_span_scales = 256.f;
+  /**
+   * Extent of splats, in σ's, included in the bounds. Should match the radius
+   * the shaders draw.
+   */
+  float extent_sigma = 3.f;
+};
+
+/**
+ * Spatially coherent range of splats, and bounds of their extents. Laid out
+ * as two `float4`s, for upload.
+ */
+struct SplatChunk {
+  Float3 min;
+  uint32_t first_splat = 0;
+  Float3 max;
+  uint32_t num_splats = 0;
+};
+static_assert(sizeof(SplatChunk) == 8 * sizeof(float),
+              "Must be uploadable as two float4s.");
+
+/**
+ * Splats grouped into chunks, so that whole chunks may be culled at once.
+ */
+struct SplatChunks {
+  /**
+   * Order splats must be stored in for chunks to be contiguous:
+   * `order[i]` is the source index of the `i`th splat (see `apply_order`).
+   */
+  std::vector<uint32_t> order;
+  /**
+   * In order, covering all splats.
+   */
+  std::vector<SplatChunk> chunks;
+};
+
+/**
+ * Groups splats into chunks at import time, for hierarchical culling (see
+ * `render::cull_chunks`).
+ *
+ * Splats are sorted along a Morton curve over their bounds, and consecutive
+ * runs of up to `splats_per_chunk` splats form chunks, which are therefore
+ * compact in space. A chunk ends early before a splat that would take it
+ * past `max_span_scales`, and at least every `splats_per_chunk * 256`
+ * splats, where chunks are split in parallel. Each chunk's bounds are the
+ * tight axis-aligned bounds of its splats' ellipsoids, out to
+ * `extent_sigma`, so splats drawn at the edge of a chunk are inside it. Runs
+ * in parallel.
+ *
+ * @param positions - Positions, as written by `convert_splat`.
+ * @param rotations - Normalized rotation quaternions.
+ * @param scales - Linear scales.
+ * @param settings - Chunking settings.
+ * @param chunks - Output. Bounds are in the units of `positions`.
+ * @return Whether chunks were built. Fails if there are more splats than can
+ * be indexed.
+ */
+SPLAT_EXPORT_API bool build_chunks(std::span<const Float3> positions,
+                                   std::span<const Float4> rotations,
+                                   std::span<const Float3> scales,
+                                   const ChunkSettings& settings,
+                                   SplatChunks& chunks);
+
+/**
+ * Reorders per-splat values, e.g. by `SplatChunks::order`. Runs in parallel.
+ *
+ * @param values - Values in source order.
+ * @param order - Source index of each output value.
+ * @param reordered - Output, of the same size as `order`. Must not alias
+ * `values`.
+ */
+template <typename T>
+void apply_order(std::span<const T> values, std::span<const uint32_t> order,
+                 std::span<T> reordered) {
+  parallel_for(order.size(), min_splats_per_task,
+               [&](size_t begin, size_t end) {
+                 for (size_t i = begin; i < end; ++i) {
+                   reordered[i] = values[order[i]];
+                 }
+               });
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,165 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_covariance.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace import {
+namespace {
+/**
+ * Rotation matrix of a normalized quaternion, as used when packing
+ * covariances: its columns are the axes scaled by `scales`.
+ */
+inline void get_rotation(const Float4& q, double R[3][3]) {
+  double x = q.x, y = q.y, z = q.z, w = q.w;
+  R[0][0] = 1. - 2. * (y * y + z * z);
+  R[0][1] = 2. * (x * y - w * z);
+  R[0][2] = 2. * (x * z + w * y);
+  R[1][0] = 2. * (x * y + w * z);
+  R[1][1] = 1. - 2. * (x * x + z * z);
+  R[1][2] = 2. * (y * z - w * x);
+  R[2][0] = 2. * (x * z - w * y);
+  R[2][1] = 2. * (y * z + w * x);
+  R[2][2] = 1. - 2. * (x * x + y * y);
+}
+}  // namespace
+
+Covariance get_covariance(const Float4& rotation, const Float3& scale) {
+  double R[3][3];
+  get_rotation(rotation, R);
+  Covariance sig;
+  for (uint32_t r = 0; r < 3; ++r) {
+    for (uint32_t c = 0; c < 3; ++c) {
+      for (uint32_t k = 0; k < 3; ++k) {
+        sig.m[r][c] += R[r][k] * R[c][k] * double(scale[k]) * scale[k];
+      }
+    }
+  }
+  return sig;
+}
+
+void decompose_covariance(Covariance sig, Float4& rotation, Float3& scale) {
+  double V[3][3] = {{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+  for (uint32_t sweep = 0; sweep < 16; ++sweep) {
+    double off_diagonal = std::abs(sig.m[0][1]) + std::abs(sig.m[0][2]) +
+                          std::abs(sig.m[1][2]);
+    double diagonal = std::abs(sig.m[0][0]) + std::abs(sig.m[1][1]) +
+                      std::abs(sig.m[2][2]);
+    if (!(off_diagonal > diagonal * 1e-15)) {
+      break;
+    }
+    for (uint32_t p = 0; p < 2; ++p) {
+      for (uint32_t q = p + 1; q < 3; ++q) {
+        if (sig.m[p][q] == 0.) {
+          continue;
+        }
+        // Rotation in the (p, q) plane zeroing sig[p][q].
+        double theta = (sig.m[q][q] - sig.m[p][p]) / (2. * sig.m[p][q]);
+        double t = (theta >= 0. ? 1. : -1.) /
+                   (std::abs(theta) + std::sqrt(theta * theta + 1.));
+        double c = 1. / std::sqrt(t * t + 1.);
+        double s = t * c;
+        for (uint32_t k = 0; k < 3; ++k) {
+          double a = sig.m[k][p];
+          double b = sig.m[k][q];
+          sig.m[k][p] = c * a - s * b;
+          sig.m[k][q] = s * a + c * b;
+        }
+        for (uint32_t k = 0; k < 3; ++k) {
+          double a = sig.m[p][k];
+          double b = sig.m[q][k];
+          sig.m[p][k] = c * a - s * b;
+          sig.m[q][k] = s * a + c * b;
+        }
+        for (uint32_t k = 0; k < 3; ++k) {
+          double a = V[k][p];
+          double b = V[k][q];
+          V[k][p] = c * a - s * b;
+          V[k][q] = s * a + c * b;
+        }
+      }
+    }
+  }
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    scale[axis] =
+        static_cast<float>(std::sqrt(std::max(sig.m[axis][axis], 0.)));
+  }
+
+  // Eigenvectors are the columns of V. Make it a rotation.
+  double det = V[0][0] * (V[1][1] * V[2][2] - V[1][2] * V[2][1]) -
+               V[0][1] * (V[1][0] * V[2][2] - V[1][2] * V[2][0]) +
+               V[0][2] * (V[1][0] * V[2][1] - V[1][1] * V[2][0]);
+  if (det < 0.) {
+    for (uint32_t k = 0; k < 3; ++k) {
+      V[k][2] = -V[k][2];
+    }
+  }
+
+  double trace = V[0][0] + V[1][1] + V[2][2];
+  double x, y, z, w;
+  if (trace > 0.) {
+    double s = .5 / std::sqrt(trace + 1.);
+    w = .25 / s;
+    x = (V[2][1] - V[1][2]) * s;
+    y = (V[0][2] - V[2][0]) * s;
+    z = (V[1][0] - V[0][1]) * s;
+  } else if (V[0][0] > V[1][1] && V[0][0] > V[2][2]) {
+    double s = 2. * std::sqrt(1. + V[0][0] - V[1][1] - V[2][2]);
+    w = (V[2][1] - V[1][2]) / s;
+    x = .25 * s;
+    y = (V[0][1] + V[1][0]) / s;
+    z = (V[0][2] + V[2][0]) / s;
+  } else if (V[1][1] > V[2][2]) {
+    double s = 2. * std::sqrt(1. + V[1][1] - V[0][0] - V[2][2]);
+    w = (V[0][2] - V[2][0]) / s;
+    x = (V[0][1] + V[1][0]) / s;
+    y = .25 * s;
+    z = (V[1][2] + V[2][1]) / s;
+  } else {
+    double s = 2. * std::sqrt(1. + V[2][2] - V[0][0] - V[1][1]);
+    w = (V[1][0] - V[0][1]) / s;
+    x = (V[0][2] + V[2][0]) / s;
+    y = (V[1][2] + V[2][1]) / s;
+    z = .25 * s;
+  }
+  double inv_length = 1. / std::sqrt(x * x + y * y + z * z + w * w);
+  rotation = Float4(static_cast<float>(x * inv_length),
+                    static_cast<float>(y * inv_length),
+                    static_cast<float>(z * inv_length),
+                    static_cast<float>(w * inv_length));
+}
+
+void match_moments(std::span<const Float3> positions,
+                   std::span<const Float4> rotations,
+                   std::span<const Float3> scales,
+                   std::span<const double> weights, Float3& position,
+                   Float4& rotation, Float3& scale) {
+  double mean[3] = {};
+  for (size_t i = 0; i < weights.size(); ++i) {
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      mean[axis] += weights[i] * positions[i][axis];
+    }
+  }
+
+  Covariance sig;
+  for (size_t i = 0; i < weights.size(); ++i) {
+    Covariance splat_sig = get_covariance(rotations[i], scales[i]);
+    double offset[3];
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      offset[axis] = positions[i][axis] - mean[axis];
+    }
+    for (uint32_t r = 0; r < 3; ++r) {
+      for (uint32_t c = 0; c < 3; ++c) {
+        sig.m[r][c] += weights[i] * (splat_sig.m[r][c] + offset[r] * offset[c]);
+      }
+    }
+  }
+
+  position = Float3(static_cast<float>(mean[0]), static_cast<float>(mean[1]),
+                    static_cast<float>(mean[2]));
+  decompose_covariance(sig, rotation, scale);
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,57 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <span>
+
+#include "import/splat_math.h"
+
+namespace import {
+/**
+ * Symmetric 3x3 matrix, in double precision for accumulating moments.
+ */
+struct Covariance {
+  double m[3][3] = {};
+};
+
+/**
+ * @param rotation - Normalized rotation quaternion.
+ * @param scale - Linear scale.
+ * @return Σ = R * S * S^T * R^T, with the axes of R as used when packing
+ * covariances.
+ */
+SPLAT_EXPORT_API Covariance get_covariance(const Float4& rotation,
+                                           const Float3& scale);
+
+/**
+ * Inverse of `get_covariance`, by Jacobi eigenvalue iteration.
+ *
+ * @param sig - Covariance.
+ * @param rotation - Output, normalized quaternion.
+ * @param scale - Output, square roots of the eigenvalues.
+ */
+SPLAT_EXPORT_API void decompose_covariance(Covariance sig, Float4& rotation,
+                                           Float3& scale);
+
+/**
+ * Finds the Gaussian matching the first two moments of a weighted mixture of
+ * splats: its position is their weighted mean, and its covariance is the
+ * weighted mean of their covariances plus the spread of their positions.
+ *
+ * @param positions - Positions of the splats.
+ * @param rotations - Normalized rotation quaternions of the splats.
+ * @param scales - Linear scales of the splats.
+ * @param weights - Weights of the splats, summing to 1.
+ * @param position - Output.
+ * @param rotation - Output, normalized quaternion.
+ * @param scale - Output, linear scale.
+ */
+SPLAT_EXPORT_API void match_moments(std::span<const Float3> positions,
+                                    std::span<const Float4> rotations,
+                                    std::span<const Float3> scales,
+                                    std::span<const double> weights,
+                                    Float3& position, Float4& rotation,
+                                    Float3& scale);
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,167 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_directional_orders.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+#include "import/splat_logging.h"
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+namespace import {
+namespace {
+/**
+ * @return Key which sorts in descending order of `depth`.
+ */
+inline uint64_t get_descending_key(float depth) {
+  uint32_t bits = std::bit_cast<uint32_t>(depth);
+  // Negative floats sort in reverse, so flip all their bits, and only the sign
+  // of the others.
+  bits ^= (bits >> 31) ? 0xFFFFFFFFu : 0x80000000u;
+  return ~bits;
+}
+
+/**
+ * Writes the key of each splat, ordering splats back-to-front as seen by an
+ * orthographic camera looking along `direction`.
+ */
+void get_depth_keys(std::span<const Float3> positions, const Float3& direction,
+                    std::vector<std::pair<uint64_t, uint32_t>>& keys) {
+  parallel_for(keys.size(), min_splats_per_task, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      float depth = dot(positions[i], direction);
+      keys[i] = {get_descending_key(depth), static_cast<uint32_t>(i)};
+    }
+  });
+}
+
+inline void write_varint(uint32_t value, std::vector<uint8_t>& data) {
+  while (value >= 0x80) {
+    data.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  data.push_back(static_cast<uint8_t>(value));
+}
+}  // namespace
+
+bool build_directional_orders(std::span<const Float3> positions,
+                              const DirectionalOrderSettings& settings,
+                              DirectionalOrders& orders) {
+  SPLAT_TRACE_STAGE(TraceStage::BuildDirectionalOrders);
+  orders = DirectionalOrders();
+  size_t num_splats = positions.size();
+  if (num_splats > std::numeric_limits<uint32_t>::max()) {
+    log_error("Too many splats (%zu) to build directional orders for",
+              num_splats);
+    return false;
+  }
+  if (settings.num_directions == 0) {
+    log_error("Directional orders need at least 1 direction");
+    return false;
+  }
+  orders.num_splats = static_cast<uint32_t>(num_splats);
+
+  if (num_splats != 0) {
+    Float3 min = positions[0];
+    Float3 max = positions[0];
+    for (const Float3& position : positions) {
+      for (uint32_t axis = 0; axis < 3; ++axis) {
+        min[axis] = std::min(min[axis], position[axis]);
+        max[axis] = std::max(max[axis], position[axis]);
+      }
+    }
+    orders.center = (min + max) * 0.5f;
+    for (const Float3& position : positions) {
+      orders.radius =
+          std::max(orders.radius, length(position - orders.center));
+    }
+  }
+
+  // Fibonacci lattice: even steps in z, and golden angle steps around it.
+  uint32_t num_directions = settings.num_directions;
+  float golden_angle = std::numbers::pi_v<float> * (3.f - std::sqrt(5.f));
+  orders.directions.resize(num_directions);
+  for (uint32_t d = 0; d < num_directions; ++d) {
+    float z = 1.f - (2.f * static_cast<float>(d) + 1.f) /
+                        static_cast<float>(num_directions);
+    float r = std::sqrt(std::max(1.f - z * z, 0.f));
+    float angle = golden_angle * static_cast<float>(d);
+    orders.directions[d] = Float3(r * std::cos(angle), r * std::sin(angle), z);
+  }
+
+  std::vector<std::pair<uint64_t, uint32_t>> keys(num_splats);
+  orders.offsets.resize(num_directions + 1);
+  for (uint32_t d = 0; d < num_directions; ++d) {
+    get_depth_keys(positions, orders.directions[d], keys);
+    parallel_sort(keys, min_splats_per_task);
+
+    orders.offsets[d] = orders.data.size();
+    uint32_t previous = 0;
+    for (const auto& [key, index] : keys) {
+      int32_t delta = static_cast<int32_t>(index - previous);
+      write_varint(static_cast<uint32_t>(delta) << 1 ^
+                       static_cast<uint32_t>(delta >> 31),
+                   orders.data);
+      previous = index;
+    }
+  }
+  orders.offsets[num_directions] = orders.data.size();
+  SPLAT_TRACE_COUNT(TraceStage::BuildDirectionalOrders,
+                    num_splats * num_directions *
+                        (sizeof(Float3) + sizeof(keys[0])),
+                    num_splats * num_directions);
+  return true;
+}
+
+bool decode_directional_order(const DirectionalOrders& orders,
+                              uint32_t direction,
+                              std::span<uint32_t> indices) {
+  SPLAT_TRACE_STAGE(TraceStage::DecodeDirectionalOrder);
+  if (direction >= orders.directions.size() ||
+      orders.offsets.size() != orders.directions.size() + 1 ||
+      indices.size() != orders.num_splats) {
+    log_error("Invalid directional order %u", direction);
+    return false;
+  }
+  uint64_t begin = orders.offsets[direction];
+  uint64_t end = orders.offsets[direction + 1];
+  if (begin > end || end > orders.data.size()) {
+    log_error("Directional order %u is out of bounds", direction);
+    return false;
+  }
+
+  const uint8_t* data = orders.data.data();
+  uint64_t offset = begin;
+  uint32_t previous = 0;
+  for (uint32_t& index : indices) {
+    uint32_t value = 0;
+    uint32_t shift = 0;
+    uint8_t byte = 0x80;
+    while ((byte & 0x80) && offset < end && shift < 32) {
+      byte = data[offset++];
+      value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      shift += 7;
+    }
+    if (byte & 0x80) {
+      log_error("Directional order %u is truncated", direction);
+      return false;
+    }
+    index = previous + ((value >> 1) ^ (0u - (value & 1)));
+    if (index >= orders.num_splats) {
+      log_error("Directional order %u holds an invalid index", direction);
+      return false;
+    }
+    previous = index;
+  }
+  SPLAT_TRACE_COUNT(TraceStage::DecodeDirectionalOrder, end - begin,
+                    orders.num_splats);
+  return true;
+}
+}  // namespace import
\ No newline at end of file
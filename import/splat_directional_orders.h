@@ -0,0 +1,90 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "import/splat_math.h"
+
+namespace import {
+struct DirectionalOrderSettings {
+  /**
+   * Number of view directions to precompute orders for, spread evenly over
+   * the sphere. Each takes about one to three bytes per splat. The nearest
+   * direction is at most about 14 degrees off with 64 directions, or 22 with
+   * 26.
+   */
+  uint32_t num_directions = 64;
+};
+
+/**
+ * Back-to-front orders of an asset's splats, precomputed for a set of view
+ * directions (see `build_directional_orders`).
+ */
+struct DirectionalOrders {
+  /**
+   * Unit view directions, i.e. from the camera towards the asset, in the
+   * units and axes of the positions the orders were built from.
+   */
+  std::vector<Float3> directions;
+  /**
+   * Offset of each direction's order in `data`, followed by the size of
+   * `data`.
+   */
+  std::vector<uint64_t> offsets;
+  /**
+   * Orders, each stored as the difference of each index from the previous
+   * (from 0 for the first), zigzag encoded as LEB128 varints: at most 3 bytes
+   * per splat below 1M splats, and fewer for smaller assets, which are the
+   * ones usually drawn in the distance.
+   */
+  std::vector<uint8_t> data;
+  uint32_t num_splats = 0;
+  /**
+   * Bounding sphere of the positions, for the runtime to decide whether the
+   * asset is distant enough for its order not to depend on the camera
+   * position.
+   */
+  Float3 center;
+  float radius = 0.f;
+};
+
+/**
+ * Precomputes back-to-front orders for a set of view directions, so that
+ * distant assets, whose order depends on the view direction but hardly on the
+ * camera position, need not be sorted at runtime (see
+ * `render::DirectionalSorter`).
+ *
+ * Directions form a Fibonacci lattice. Along each, splats are sorted by
+ * descending depth, i.e. as an orthographic camera looking that way would
+ * draw them, with ties in index order. Each sort runs in parallel.
+ *
+ * @param positions - Positions, as written by `convert_splat`, in the order
+ * they will be stored in. Must be finite (see `classify_splats`).
+ * @param settings - Directions to build orders for.
+ * @param orders - Output.
+ * @return Whether orders were built. Fails if there are more splats than can
+ * be indexed, or no directions.
+ */
+SPLAT_EXPORT_API bool build_directional_orders(
+    std::span<const Float3> positions,
+    const DirectionalOrderSettings& settings, DirectionalOrders& orders);
+
+/**
+ * Decodes the order of one direction.
+ *
+ * @param orders - Orders, as written by `build_directional_orders`.
+ * @param direction - Index into `orders.directions`.
+ * @param indices - Output, of size `orders.num_splats`: splat indices,
+ * back-to-front.
+ * @return Whether the order was decoded. Fails if `orders` is malformed, e.g.
+ * truncated.
+ */
+SPLAT_EXPORT_API bool decode_directional_order(
+    const DirectionalOrders& orders, uint32_t direction,
+    std::span<uint32_t> indices);
+}  // namespace import
\ No newline at end of file
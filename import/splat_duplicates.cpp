@@ -0,0 +1,404 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_duplicates.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "import/splat_covariance.h"
+#include "import/splat_logging.h"
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+namespace import {
+namespace {
+/**
+ * Minimum number of hash buckets per task.
+ */
+constexpr size_t min_buckets_per_task = 1 << 10;
+
+/**
+ * Bits per axis of bucket keys. Cell coordinates wrap around, which only adds
+ * candidate pairs.
+ */
+constexpr uint32_t cell_bits = 21;
+constexpr uint64_t cell_mask = (uint64_t{1} << cell_bits) - 1;
+
+/**
+ * Key of splats which aren't compared, sorting after all buckets.
+ */
+constexpr uint64_t no_bucket = std::numeric_limits<uint64_t>::max();
+
+inline uint64_t get_bucket_key(uint64_t x, uint64_t y, uint64_t z) {
+  return (x & cell_mask) | (y & cell_mask) << cell_bits |
+         (z & cell_mask) << (2 * cell_bits);
+}
+
+/**
+ * Values compared by `is_similar`, computed once per splat.
+ */
+struct SplatShape {
+  /**
+   * xx, yy, zz, xy, xz and yz.
+   */
+  float covariance[6] = {};
+  /**
+   * Squared Frobenius norm of the covariance.
+   */
+  float norm_squared = 0.f;
+  /**
+   * Largest scale.
+   */
+  float radius = 0.f;
+};
+
+SplatShape get_shape(const Float4& rotation, const Float3& scale) {
+  Covariance sig = get_covariance(rotation, scale);
+  SplatShape shape;
+  const uint32_t rows[6] = {0, 1, 2, 0, 0, 1};
+  const uint32_t columns[6] = {0, 1, 2, 1, 2, 2};
+  for (uint32_t i = 0; i < 6; ++i) {
+    float value = static_cast<float>(sig.m[rows[i]][columns[i]]);
+    shape.covariance[i] = value;
+    shape.norm_squared += (i < 3 ? 1.f : 2.f) * value * value;
+  }
+  shape.radius = std::max(std::max(scale.x, scale.y), scale.z);
+  return shape;
+}
+
+bool is_similar(const Float3& position_a, const Float4& color_a,
+                const SplatShape& shape_a, const Float3& position_b,
+                const Float4& color_b, const SplatShape& shape_b,
+                const DuplicateSettings& settings) {
+  float max_distance =
+      std::min(settings.max_distance_sigmas *
+                   std::min(shape_a.radius, shape_b.radius),
+               settings.cell_size);
+  Float3 offset = position_a - position_b;
+  if (dot(offset, offset) > max_distance * max_distance) {
+    return false;
+  }
+  for (uint32_t channel = 0; channel < 3; ++channel) {
+    if (std::abs(color_a[channel] - color_b[channel]) >
+        settings.max_color_difference) {
+      return false;
+    }
+  }
+  float difference_squared = 0.f;
+  for (uint32_t i = 0; i < 6; ++i) {
+    float difference = shape_a.covariance[i] - shape_b.covariance[i];
+    difference_squared += (i < 3 ? 1.f : 2.f) * difference * difference;
+  }
+  return difference_squared <=
+         settings.max_covariance_difference *
+             settings.max_covariance_difference *
+             std::max(shape_a.norm_squared, shape_b.norm_squared);
+}
+
+/**
+ * Lock-free union-find, in which roots only ever link to smaller roots, so
+ * that each group's root is its smallest index.
+ */
+class GroupLabels {
+ public:
+  explicit GroupLabels(size_t count) : parents(count) {
+    parallel_for(count, min_splats_per_task, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        parents[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+      }
+    });
+  }
+
+  uint32_t find(uint32_t i) {
+    while (true) {
+      uint32_t parent = parents[i].load();
+      if (parent == i) {
+        return i;
+      }
+      // Path halving. Losing the race only leaves a longer path.
+      uint32_t grandparent = parents[parent].load();
+      if (grandparent != parent) {
+        parents[i].compare_exchange_weak(parent, grandparent);
+      }
+      i = grandparent;
+    }
+  }
+
+  void unite(uint32_t a, uint32_t b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return;
+      }
+      if (a > b) {
+        std::swap(a, b);
+      }
+      // Fails if `b` was linked meanwhile, in which case retry from its root.
+      uint32_t expected = b;
+      if (parents[b].compare_exchange_strong(expected, a)) {
+        return;
+      }
+    }
+  }
+
+ private:
+  std::vector<std::atomic<uint32_t>> parents;
+};
+}  // namespace
+
+uint64_t merge_duplicates(std::span<Float3> positions,
+                          std::span<Float4> rotations,
+                          std::span<Float3> scales, std::span<Float4> colors,
+                          const DuplicateSettings& settings,
+                          std::span<PruneReason> reasons) {
+  SPLAT_TRACE_STAGE(TraceStage::MergeDuplicates);
+  size_t num_splats = positions.size();
+  if (num_splats > std::numeric_limits<uint32_t>::max()) {
+    log_error("Too many splats (%zu) to merge duplicates of", num_splats);
+    return 0;
+  }
+  if (!(settings.cell_size > 0.f)) {
+    log_error("Duplicate cell size must be positive");
+    return 0;
+  }
+
+  // Bucket kept splats by cell.
+  std::vector<SplatShape> shapes(num_splats);
+  std::vector<std::pair<uint64_t, uint32_t>> buckets(num_splats);
+  double cells_per_meter = 1. / settings.cell_size;
+  auto get_cell = [&](float x) {
+    double cell = std::clamp(std::floor(x * cells_per_meter), -0x1p62, 0x1p62);
+    return static_cast<uint64_t>(static_cast<int64_t>(cell));
+  };
+  parallel_for(num_splats, min_splats_per_task, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const Float3& position = positions[i];
+      bool is_candidate = reasons[i] == PruneReason::Kept &&
+                          std::isfinite(position.x) &&
+                          std::isfinite(position.y) &&
+                          std::isfinite(position.z);
+      uint64_t key = no_bucket;
+      if (is_candidate) {
+        shapes[i] = get_shape(rotations[i], scales[i]);
+        key = get_bucket_key(get_cell(position.x), get_cell(position.y),
+                             get_cell(position.z));
+      }
+      buckets[i] = {key, static_cast<uint32_t>(i)};
+    }
+  });
+  parallel_sort(buckets, min_splats_per_task);
+  buckets.resize(std::lower_bound(buckets.begin(), buckets.end(),
+                                  std::make_pair(no_bucket, uint32_t{0})) -
+                 buckets.begin());
+
+  std::vector<uint64_t> bucket_keys;
+  std::vector<uint32_t> bucket_begins;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    if (i == 0 || buckets[i].first != buckets[i - 1].first) {
+      bucket_keys.push_back(buckets[i].first);
+      bucket_begins.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  bucket_begins.push_back(static_cast<uint32_t>(buckets.size()));
+
+  // Compare each bucket with itself and its neighbors of larger key, so that
+  // each pair of buckets is compared once.
+  GroupLabels labels(num_splats);
+  auto compare_buckets = [&](size_t bucket, size_t neighbor) {
+    for (uint32_t a = bucket_begins[bucket]; a < bucket_begins[bucket + 1];
+         ++a) {
+      uint32_t i = buckets[a].second;
+      uint32_t b = neighbor == bucket ? a + 1 : bucket_begins[neighbor];
+      for (; b < bucket_begins[neighbor + 1]; ++b) {
+        uint32_t j = buckets[b].second;
+        if (is_similar(positions[i], colors[i], shapes[i], positions[j],
+                       colors[j], shapes[j], settings)) {
+          labels.unite(i, j);
+        }
+      }
+    }
+  };
+  size_t num_buckets = bucket_keys.size();
+  parallel_for(num_buckets, min_buckets_per_task, [&](size_t begin,
+                                                       size_t end) {
+    for (size_t bucket = begin; bucket < end; ++bucket) {
+      uint64_t key = bucket_keys[bucket];
+      uint64_t x = key & cell_mask;
+      uint64_t y = key >> cell_bits & cell_mask;
+      uint64_t z = key >> (2 * cell_bits);
+      for (uint32_t offset = 0; offset < 27; ++offset) {
+        // Adding `cell_mask` steps back one cell, modulo the wrap-around.
+        uint64_t neighbor_key =
+            get_bucket_key(x + offset % 3 + cell_mask,
+                           y + offset / 3 % 3 + cell_mask,
+                           z + offset / 9 + cell_mask);
+        if (neighbor_key < key) {
+          continue;
+        }
+        auto found = std::lower_bound(bucket_keys.begin(), bucket_keys.end(),
+                                      neighbor_key);
+        if (found != bucket_keys.end() && *found == neighbor_key) {
+          compare_buckets(bucket, found - bucket_keys.begin());
+        }
+      }
+    }
+  });
+
+  // Group the members of each component after its root, root first.
+  uint32_t num_tasks = get_num_ranges(buckets.size(), min_splats_per_task);
+  std::vector<std::vector<std::pair<uint64_t, uint32_t>>> task_members(
+      num_tasks);
+  run_tasks(num_tasks, [&](uint32_t task) {
+    size_t end = buckets.size() * (task + 1) / num_tasks;
+    for (size_t a = buckets.size() * task / num_tasks; a < end; ++a) {
+      uint32_t i = buckets[a].second;
+      uint32_t root = labels.find(i);
+      if (root != i) {
+        task_members[task].emplace_back(root, i);
+      }
+    }
+  });
+  std::vector<std::pair<uint64_t, uint32_t>> members;
+  for (const auto& task : task_members) {
+    members.insert(members.end(), task.begin(), task.end());
+  }
+  parallel_sort(members, min_splats_per_task);
+
+  std::vector<uint32_t> component_begins;
+  for (size_t m = 0; m < members.size(); ++m) {
+    if (m == 0 || members[m].first != members[m - 1].first) {
+      component_begins.push_back(static_cast<uint32_t>(m));
+    }
+  }
+  component_begins.push_back(static_cast<uint32_t>(members.size()));
+
+  // Split each component into groups, each led by a splat that all of its
+  // members are similar to, so that groups can't chain. In index order, each
+  // splat joins the group of the smallest leader it's similar to, or leads a
+  // new one. Leaders are within `cell_size` of their members, so only those
+  // of adjacent cells are compared. Components are disjoint, and each group
+  // only writes to its leader.
+  std::atomic<uint64_t> num_merged = 0;
+  size_t num_components = component_begins.size() - 1;
+  parallel_for(num_components, min_buckets_per_task, [&](size_t begin,
+                                                          size_t end) {
+    std::vector<uint32_t> component;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cell_leaders;
+    std::vector<std::pair<uint32_t, uint32_t>> grouped;
+    std::vector<Float3> group_positions;
+    std::vector<Float4> group_rotations;
+    std::vector<Float3> group_scales;
+    std::vector<double> weights;
+    uint64_t range_merged = 0;
+
+    // Merges `group` into its first splat, the leader.
+    auto merge_group = [&](std::span<const std::pair<uint32_t, uint32_t>>
+                               group) {
+      double total_opacity = 0.;
+      double transmittance = 1.;
+      for (const auto& [group_leader, i] : group) {
+        total_opacity += colors[i].w;
+        transmittance *= 1. - colors[i].w;
+      }
+      // Fully transparent groups are weighted equally.
+      size_t group_size = group.size();
+      group_positions.clear();
+      group_rotations.clear();
+      group_scales.clear();
+      weights.clear();
+      double color[3] = {};
+      for (const auto& [group_leader, i] : group) {
+        double weight = total_opacity > 0.
+                            ? colors[i].w / total_opacity
+                            : 1. / static_cast<double>(group_size);
+        group_positions.push_back(positions[i]);
+        group_rotations.push_back(rotations[i]);
+        group_scales.push_back(scales[i]);
+        weights.push_back(weight);
+        for (uint32_t channel = 0; channel < 3; ++channel) {
+          color[channel] += weight * colors[i][channel];
+        }
+        if (i != group_leader) {
+          reasons[i] = PruneReason::Duplicate;
+        }
+      }
+
+      uint32_t leader = group.front().first;
+      match_moments(group_positions, group_rotations, group_scales, weights,
+                    positions[leader], rotations[leader], scales[leader]);
+      colors[leader] = Float4(
+          static_cast<float>(color[0]), static_cast<float>(color[1]),
+          static_cast<float>(color[2]), static_cast<float>(1. - transmittance));
+      range_merged += group_size - 1;
+    };
+
+    for (size_t c = begin; c < end; ++c) {
+      component.assign(1, static_cast<uint32_t>(
+                              members[component_begins[c]].first));
+      for (uint32_t m = component_begins[c]; m < component_begins[c + 1];
+           ++m) {
+        component.push_back(members[m].second);
+      }
+
+      // (leader, member) pairs, leaders included.
+      cell_leaders.clear();
+      grouped.clear();
+      for (uint32_t i : component) {
+        const Float3& position = positions[i];
+        uint64_t x = get_cell(position.x);
+        uint64_t y = get_cell(position.y);
+        uint64_t z = get_cell(position.z);
+        uint32_t leader = i;
+        for (uint32_t offset = 0; offset < 27; ++offset) {
+          auto found = cell_leaders.find(
+              get_bucket_key(x + offset % 3 + cell_mask,
+                             y + offset / 3 % 3 + cell_mask,
+                             z + offset / 9 + cell_mask));
+          if (found == cell_leaders.end()) {
+            continue;
+          }
+          for (uint32_t j : found->second) {
+            if (j < leader &&
+                is_similar(positions[j], colors[j], shapes[j], position,
+                           colors[i], shapes[i], settings)) {
+              leader = j;
+            }
+          }
+        }
+        if (leader == i) {
+          cell_leaders[get_bucket_key(x, y, z)].push_back(i);
+        }
+        grouped.emplace_back(leader, i);
+      }
+
+      // Members follow their leader, which has the smallest index.
+      std::sort(grouped.begin(), grouped.end());
+      for (size_t g = 0; g < grouped.size();) {
+        size_t next = g + 1;
+        while (next < grouped.size() &&
+               grouped[next].first == grouped[g].first) {
+          ++next;
+        }
+        if (next - g > 1) {
+          merge_group(std::span(grouped).subspan(g, next - g));
+        }
+        g = next;
+      }
+    }
+    num_merged += range_merged;
+  });
+
+  SPLAT_TRACE_COUNT(TraceStage::MergeDuplicates,
+                    num_splats * (sizeof(Float3) * 2 + sizeof(Float4) * 2),
+                    num_splats);
+  return num_merged;
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "import/splat_math.h"
+#include "import/splat_pruning.h"
+
+namespace import {
+/**
+ * Settings of `merge_duplicates`. Two splats are near-duplicates if they are
+ * similar in position, covariance and color.
+ */
+struct DuplicateSettings {
+  /**
+   * Size of the cells of the spatial hash, in meters. Only splats in the same
+   * or adjacent cells are compared, so this also bounds the distance between
+   * near-duplicates. Cells much larger than that distance compare more pairs.
+   */
+  float cell_size = 0.01f;
+  /**
+   * Positions are similar within this many σ's along the largest axis of the
+   * smaller splat.
+   */
+  float max_distance_sigmas = 0.25f;
+  /**
+   * Covariances are similar if the Frobenius norm of their difference is
+   * within this fraction of that of the larger.
+   */
+  float max_covariance_difference = 0.1f;
+  /**
+   * Colors are similar within this in each linear RGB channel, in [0, 1].
+   * Opacities aren't compared.
+   */
+  float max_color_difference = 0.02f;
+};
+
+/**
+ * Replaces each group of near-duplicate splats, as fused multi-capture scenes
+ * often contain, with a single Gaussian, without a visible change.
+ *
+ * Splats are bucketed by a spatial hash over their quantized positions, and
+ * the splats of each bucket are compared with those of the same and adjacent
+ * buckets, in parallel across buckets. Similar pairs are connected with a
+ * concurrent union-find. Similarity is not transitive, so a component may
+ * chain splats which are each only similar to their neighbors; each is split
+ * into groups, in index order, by the smallest earlier leader each splat is
+ * similar to. Every splat of a group is thus similar to its leader, which
+ * bounds the merged splat's extent, and groups don't depend on scheduling.
+ *
+ * Each group is merged into its leader, with `match_moments`, weighting
+ * splats by opacity. Its color is their weighted mean, and its
+ * opacity is that of the splats composited over each other. The others are
+ * marked `PruneReason::Duplicate`, for `compact_kept` to remove.
+ *
+ * @param positions - Positions, as written by `convert_splat`.
+ * @param rotations - Normalized rotation quaternions.
+ * @param scales - Linear scales.
+ * @param colors - Linear RGB, and opacity, in [0, 1].
+ * @param settings - Thresholds.
+ * @param reasons - Input and output, one per splat. Only kept splats are
+ * compared.
+ * @return Number of splats marked.
+ */
+SPLAT_EXPORT_API uint64_t merge_duplicates(std::span<Float3> positions,
+                                           std::span<Float4> rotations,
+                                           std::span<Float3> scales,
+                                           std::span<Float4> colors,
+                                           const DuplicateSettings& settings,
+                                           std::span<PruneReason> reasons);
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,174 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_hash.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPLAT_HASH_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPLAT_HASH_NEON 1
+#endif
+
+namespace import {
+namespace {
+constexpr size_t stripe_size = 64;
+constexpr size_t stripes_per_block = 16;
+constexpr size_t num_lanes = stripe_size / sizeof(uint64_t);
+
+constexpr uint64_t prime32_1 = 0x9E3779B1ull;
+constexpr uint64_t prime64_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t prime64_2 = 0xC2B2AE3D27D4EB4Full;
+
+/**
+ * Per-lane keys mixed into each stripe. The window used is rotated by one lane
+ * per stripe, so identical stripes at different offsets hash differently.
+ * Arbitrary constants (fractional digits of pi).
+ */
+constexpr std::array<uint64_t, 2 * num_lanes> base_secret{
+    0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull,
+    0x082EFA98EC4E6C89ull, 0x452821E638D01377ull, 0xBE5466CF34E90C6Cull,
+    0xC0AC29B7C97C50DDull, 0x3F84D5B5B5470917ull, 0x9216D5D98979FB1Bull,
+    0xD1310BA698DFB5ACull, 0x2FFD72DBD01ADFB7ull, 0xB8E1AFED6A267E96ull,
+    0xBA7C9045F12C7F99ull, 0x24A19947B3916CF7ull, 0x0801F2E2858EFC16ull,
+    0x636920D871574E69ull};
+
+/**
+ * Reads a little-endian 64-bit value from unaligned memory.
+ */
+inline uint64_t read_u64(const uint8_t* data) {
+  if constexpr (std::endian::native == std::endian::little) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+  } else {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i) {
+      value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+  }
+}
+
+/**
+ * Folds the 128-bit product of `a` and `b` into 64 bits.
+ */
+inline uint64_t mul_fold(uint64_t a, uint64_t b) {
+  uint64_t a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+  uint64_t b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+
+  uint64_t lo_lo = a_lo * b_lo;
+  uint64_t hi_lo = a_hi * b_lo;
+  uint64_t lo_hi = a_lo * b_hi;
+  uint64_t hi_hi = a_hi * b_hi;
+
+  uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFull) + lo_hi;
+  uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFFull);
+  return upper ^ lower;
+}
+
+inline uint64_t avalanche(uint64_t h) {
+  h ^= h >> 37;
+  h *= 0x165667919E3779F9ull;
+  h ^= h >> 32;
+  return h;
+}
+
+/**
+ * Accumulates a single 64-byte stripe:
+ *
+ * acc[i]     += lo32(d[i] ^ k[i]) * hi32(d[i] ^ k[i])
+ * acc[i ^ 1] += d[i]
+ *
+ * Swapping which lane receives the raw data keeps a zero multiplicand from
+ * erasing the contribution of a stripe.
+ */
+inline void accumulate_stripe(uint64_t* acc, const uint8_t* data,
+                              const uint64_t* secret) {
+#if defined(SPLAT_HASH_SSE2)
+  for (size_t i = 0; i < num_lanes; i += 2) {
+    __m128i d =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 8));
+    __m128i k = _mm_xor_si128(
+        d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + i)));
+    __m128i product = _mm_mul_epu32(k, _mm_srli_epi64(k, 32));
+    __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i* a = reinterpret_cast<__m128i*>(acc + i);
+    _mm_storeu_si128(a, _mm_add_epi64(_mm_loadu_si128(a),
+                                      _mm_add_epi64(product, swapped)));
+  }
+#elif defined(SPLAT_HASH_NEON)
+  for (size_t i = 0; i < num_lanes; i += 2) {
+    uint64x2_t d = vreinterpretq_u64_u8(vld1q_u8(data + i * 8));
+    uint64x2_t k = veorq_u64(d, vld1q_u64(secret + i));
+    uint64x2_t product = vmull_u32(vmovn_u64(k), vshrn_n_u64(k, 32));
+    uint64x2_t swapped = vextq_u64(d, d, 1);
+    vst1q_u64(acc + i,
+              vaddq_u64(vld1q_u64(acc + i), vaddq_u64(product, swapped)));
+  }
+#else
+  for (size_t i = 0; i < num_lanes; ++i) {
+    uint64_t d = read_u64(data + i * 8);
+    uint64_t k = d ^ secret[i];
+    acc[i] += (k & 0xFFFFFFFFull) * (k >> 32);
+    acc[i ^ 1] += d;
+  }
+#endif
+}
+
+inline void scramble(uint64_t* acc, const uint64_t* secret) {
+  for (size_t i = 0; i < num_lanes; ++i) {
+    uint64_t a = acc[i];
+    a ^= a >> 47;
+    a ^= secret[num_lanes - 1 - i];
+    acc[i] = a * prime32_1;
+  }
+}
+}  // namespace
+
+uint64_t hash_buffer(std::span<const uint8_t> buffer, uint64_t seed) {
+  std::array<uint64_t, 2 * num_lanes> secret;
+  for (size_t i = 0; i < secret.size(); ++i) {
+    secret[i] = base_secret[i] + (i % 2 == 0 ? seed : 0 - seed);
+  }
+
+  std::array<uint64_t, num_lanes> acc{
+      prime32_1, prime64_1, prime64_2, prime64_1 ^ seed,
+      prime64_2, prime32_1, prime64_1, prime64_2 ^ seed};
+
+  const uint8_t* data = buffer.data();
+  size_t num_stripes = buffer.size() / stripe_size;
+
+  for (size_t stripe = 0; stripe < num_stripes; ++stripe) {
+    accumulate_stripe(acc.data(), data + stripe * stripe_size,
+                      secret.data() + stripe % num_lanes);
+    if (stripe % stripes_per_block == stripes_per_block - 1) {
+      scramble(acc.data(), secret.data());
+    }
+  }
+
+  // Zero-pad the final partial stripe. The length is mixed in below, so
+  // trailing zeros can't collide with a shorter input.
+  size_t tail_size = buffer.size() % stripe_size;
+  if (tail_size != 0) {
+    alignas(16) uint8_t tail[stripe_size] = {};
+    std::memcpy(tail, data + num_stripes * stripe_size, tail_size);
+    accumulate_stripe(acc.data(), tail,
+                      secret.data() + num_stripes % num_lanes);
+  }
+
+  uint64_t result = buffer.size() * prime64_1 + seed;
+  for (size_t i = 0; i < num_lanes; i += 2) {
+    result += mul_fold(acc[i] ^ secret[num_lanes + i],
+                       acc[i + 1] ^ secret[num_lanes + i + 1]);
+  }
+  return avalanche(result);
+}
+}  // namespace import
\ No newline at end of file
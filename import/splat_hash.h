@@ -0,0 +1,28 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace import {
+/**
+ * Computes a fast, non-cryptographic 64-bit hash of a buffer.
+ *
+ * The core loop is modelled on XXH3: the input is consumed in 64-byte stripes,
+ * each stripe being folded into eight 64-bit accumulators with a 32x32->64
+ * multiply, and the accumulators are scrambled once per 1KB block. This maps
+ * directly onto SSE2/NEON, so hashing runs at close to memory bandwidth.
+ *
+ * Note: This is *not* bit-compatible with XXH3, but is stable across platforms
+ * and SIMD paths, so it is safe to persist (e.g. as an on-disk cache key).
+ *
+ * @param buffer - Data to hash.
+ * @param seed - Optional seed, to derive independent hashes of the same data.
+ * @return 64-bit hash of `buffer`.
+ */
+SPLAT_EXPORT_API uint64_t hash_buffer(std::span<const uint8_t> buffer,
+                                      uint64_t seed = 0);
+}  // namespace import
\ No newline at end of file
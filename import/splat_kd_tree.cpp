@@ -0,0 +1,186 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_kd_tree.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "import/splat_logging.h"
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+namespace import {
+namespace {
+inline float get_distance_squared(const Float3& a, const Float3& b) {
+  Float3 d = a - b;
+  return dot(d, d);
+}
+
+/**
+ * Orders neighbors by distance. A function object, so heap operations inline
+ * it.
+ */
+struct IsNearer {
+  bool operator()(const KdNeighbor& a, const KdNeighbor& b) const {
+    return a.distance_squared < b.distance_squared;
+  }
+};
+constexpr IsNearer is_nearer;
+}  // namespace
+
+bool KdTree::build(std::span<const Float3> positions,
+                   uint32_t max_leaf_points) {
+  SPLAT_TRACE_STAGE(TraceStage::BuildKdTree);
+  size_t num_points = positions.size();
+  if (num_points > std::numeric_limits<uint32_t>::max()) {
+    log_error("Too many splats (%zu) to build k-d tree for", num_points);
+    return false;
+  }
+  if (max_leaf_points == 0) {
+    log_error("k-d tree leaves must hold at least 1 point");
+    return false;
+  }
+
+  points.resize(num_points);
+  parallel_for(num_points, min_splats_per_task, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      points[i].position = positions[i];
+      points[i].index = static_cast<uint32_t>(i);
+    }
+  });
+
+  leaf_depth = 0;
+  while ((num_points >> leaf_depth) > max_leaf_points) {
+    ++leaf_depth;
+  }
+  size_t num_internal = (size_t{1} << leaf_depth) - 1;
+  split_values.assign(num_internal, 0.f);
+  split_axes.assign(num_internal, 0);
+
+  // Nodes of the same depth are disjoint, so are split concurrently. Near the
+  // root, there are fewer nodes than workers, but each node is larger.
+  for (uint32_t depth = 0; depth < leaf_depth; ++depth) {
+    size_t num_nodes = size_t{1} << depth;
+    parallel_for(num_nodes, 1, [&](size_t begin_node, size_t end_node) {
+      for (size_t node = begin_node; node < end_node; ++node) {
+        size_t begin = num_points * node >> depth;
+        size_t middle = num_points * (2 * node + 1) >> (depth + 1);
+        size_t end = num_points * (node + 1) >> depth;
+
+        Float3 min = points[begin].position;
+        Float3 max = min;
+        for (size_t i = begin + 1; i < end; ++i) {
+          const Float3& position = points[i].position;
+          for (uint32_t axis = 0; axis < 3; ++axis) {
+            min[axis] = std::min(min[axis], position[axis]);
+            max[axis] = std::max(max[axis], position[axis]);
+          }
+        }
+        Float3 extent = max - min;
+        uint32_t axis = extent.x >= extent.y ? 0 : 1;
+        axis = extent.z > extent[axis] ? 2 : axis;
+
+        std::nth_element(points.begin() + begin, points.begin() + middle,
+                         points.begin() + end,
+                         [axis](const KdPoint& a, const KdPoint& b) {
+                           return a.position[axis] < b.position[axis];
+                         });
+        size_t index = (size_t{1} << depth) - 1 + node;
+        split_values[index] = points[middle].position[axis];
+        split_axes[index] = static_cast<uint8_t>(axis);
+      }
+    });
+  }
+  SPLAT_TRACE_COUNT(TraceStage::BuildKdTree,
+                    num_points * sizeof(KdPoint) * (leaf_depth + 1),
+                    num_points);
+  return true;
+}
+
+void KdTree::find_nearest(const Float3& point, uint32_t k,
+                          std::vector<KdNeighbor>& neighbors) const {
+  neighbors.clear();
+  if (k == 0 || points.empty()) {
+    return;
+  }
+  search_nearest(0, 0, point, Float3(0.f, 0.f, 0.f), 0.f, k, neighbors);
+  std::sort_heap(neighbors.begin(), neighbors.end(), is_nearer);
+}
+
+void KdTree::find_within(const Float3& point, float radius,
+                         std::vector<KdNeighbor>& neighbors) const {
+  neighbors.clear();
+  if (points.empty()) {
+    return;
+  }
+  search_within(0, 0, point, radius * radius, neighbors);
+}
+
+void KdTree::search_nearest(uint32_t depth, uint64_t node,
+                            const Float3& point, Float3 offsets,
+                            float node_distance_squared, uint32_t k,
+                            std::vector<KdNeighbor>& neighbors) const {
+  if (depth == leaf_depth) {
+    // `neighbors` is a max-heap of the nearest points found so far.
+    size_t num_points = points.size();
+    size_t end = num_points * (node + 1) >> depth;
+    for (size_t i = num_points * node >> depth; i < end; ++i) {
+      KdNeighbor neighbor{get_distance_squared(point, points[i].position),
+                          points[i].index};
+      if (neighbors.size() < k) {
+        neighbors.push_back(neighbor);
+        std::push_heap(neighbors.begin(), neighbors.end(), is_nearer);
+      } else if (is_nearer(neighbor, neighbors.front())) {
+        std::pop_heap(neighbors.begin(), neighbors.end(), is_nearer);
+        neighbors.back() = neighbor;
+        std::push_heap(neighbors.begin(), neighbors.end(), is_nearer);
+      }
+    }
+    return;
+  }
+
+  // The far child is at least as far as the split plane, in addition to the
+  // planes already crossed along other axes (Arya & Mount).
+  size_t index = (size_t{1} << depth) - 1 + node;
+  uint32_t axis = split_axes[index];
+  float offset = point[axis] - split_values[index];
+  uint64_t near_child = 2 * node + (offset < 0.f ? 0 : 1);
+  search_nearest(depth + 1, near_child, point, offsets, node_distance_squared,
+                 k, neighbors);
+  float far_distance_squared =
+      node_distance_squared - offsets[axis] * offsets[axis] + offset * offset;
+  if (neighbors.size() < k ||
+      far_distance_squared < neighbors.front().distance_squared) {
+    offsets[axis] = offset;
+    search_nearest(depth + 1, near_child ^ 1, point, offsets,
+                   far_distance_squared, k, neighbors);
+  }
+}
+
+void KdTree::search_within(uint32_t depth, uint64_t node, const Float3& point,
+                           float radius_squared,
+                           std::vector<KdNeighbor>& neighbors) const {
+  if (depth == leaf_depth) {
+    size_t num_points = points.size();
+    size_t end = num_points * (node + 1) >> depth;
+    for (size_t i = num_points * node >> depth; i < end; ++i) {
+      float distance_squared = get_distance_squared(point, points[i].position);
+      if (distance_squared <= radius_squared) {
+        neighbors.push_back({distance_squared, points[i].index});
+      }
+    }
+    return;
+  }
+
+  size_t index = (size_t{1} << depth) - 1 + node;
+  float offset = point[split_axes[index]] - split_values[index];
+  uint64_t near_child = 2 * node + (offset < 0.f ? 0 : 1);
+  search_within(depth + 1, near_child, point, radius_squared, neighbors);
+  if (offset * offset <= radius_squared) {
+    search_within(depth + 1, near_child ^ 1, point, radius_squared,
+                  neighbors);
+  }
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "import/splat_math.h"
+
+namespace import {
+/**
+ * Point of a `KdTree`, in tree order.
+ */
+struct KdPoint {
+  Float3 position;
+  /**
+   * Index of the point in the positions the tree was built from.
+   */
+  uint32_t index = 0;
+};
+
+/**
+ * Result of a `KdTree` query.
+ */
+struct KdNeighbor {
+  float distance_squared = 0.f;
+  /**
+   * Index of the point in the positions the tree was built from.
+   */
+  uint32_t index = 0;
+};
+
+/**
+ * Balanced k-d tree over splat positions, for neighbor queries at import time,
+ * e.g. by `mark_outliers`.
+ *
+ * The tree is implicit: node `j` of depth `d` holds the points
+ * [n * j >> d, n * (j + 1) >> d), so only split planes are stored, and points
+ * are reordered such that each leaf is contiguous. Each node is split at the
+ * median of its widest axis, until leaves hold at most `max_leaf_points`.
+ *
+ * Queries are const, so may run concurrently once built.
+ */
+class KdTree {
+ public:
+  /**
+   * Builds the tree, one depth at a time, splitting the nodes of each depth in
+   * parallel. Takes O(n log n) time.
+   *
+   * @param positions - Points to index, e.g. as written by `convert_splat`.
+   * Must be finite (see `classify_splats`).
+   * @param max_leaf_points - Points per leaf. At least 1.
+   * @return Whether the tree was built. Fails if there are more points than
+   * can be indexed.
+   */
+  SPLAT_EXPORT_API bool build(std::span<const Float3> positions,
+                              uint32_t max_leaf_points = 8);
+
+  /**
+   * Finds the `k` points nearest to `point`, including any point at `point`
+   * itself.
+   *
+   * @param point - Query point.
+   * @param k - Number of neighbors to find.
+   * @param neighbors - Output, sorted from nearest to furthest. Holds fewer
+   * than `k` neighbors if the tree does.
+   */
+  SPLAT_EXPORT_API void find_nearest(const Float3& point, uint32_t k,
+                                     std::vector<KdNeighbor>& neighbors) const;
+
+  /**
+   * Finds all points within `radius` of `point`.
+   *
+   * @param point - Query point.
+   * @param radius - Search radius, inclusive.
+   * @param neighbors - Output, unordered.
+   */
+  SPLAT_EXPORT_API void find_within(const Float3& point, float radius,
+                                    std::vector<KdNeighbor>& neighbors) const;
+
+  /**
+   * @return Points, in tree order. Queries for points in this order access
+   * memory coherently.
+   */
+  std::span<const KdPoint> get_points() const { return points; }
+
+ private:
+  void search_nearest(uint32_t depth, uint64_t node, const Float3& point,
+                      Float3 offsets, float node_distance_squared, uint32_t k,
+                      std::vector<KdNeighbor>& neighbors) const;
+  void search_within(uint32_t depth, uint64_t node, const Float3& point,
+                     float radius_squared,
+                     std::vector<KdNeighbor>& neighbors) const;
+
+  std::vector<KdPoint> points;
+  /**
+   * Split planes of the internal nodes, breadth first: node `j` of depth `d`
+   * is at `(1 << d) - 1 + j`.
+   */
+  std::vector<float> split_values;
+  std::vector<uint8_t> split_axes;
+  /**
+   * Depth of the leaves.
+   */
+  uint32_t leaf_depth = 0;
+};
+}  // namespace import
\ No newline at end of file
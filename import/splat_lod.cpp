@@ -0,0 +1,215 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_lod.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "import/splat_covariance.h"
+#include "import/splat_logging.h"
+#include "import/splat_morton.h"
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+namespace import {
+namespace {
+/**
+ * @return Area of a splat projected along its smallest axis, over π.
+ */
+inline double get_area(const Float3& scale) {
+  float smallest = std::min(std::min(scale.x, scale.y), scale.z);
+  double product = double(scale.x) * scale.y * scale.z;
+  return smallest > 0.f ? product / smallest
+                        : std::max(std::max(double(scale.x) * scale.y,
+                                            double(scale.x) * scale.z),
+                                   double(scale.y) * scale.z);
+}
+
+/**
+ * Merges the children of `node` into it. See `build_lod`.
+ *
+ * @param weights - Scratch space, reused across calls.
+ */
+void merge_children(uint32_t node, const LodSettings& settings, SplatLod& lod,
+                    std::vector<double>& weights) {
+  const LodNode& parent = lod.nodes[node];
+  uint32_t begin = parent.first_child;
+  uint32_t end = begin + parent.num_children;
+
+  double total_weight = 0.;
+  double max_opacity = 0.;
+  for (uint32_t child = begin; child < end; ++child) {
+    total_weight += lod.colors[child].w * get_area(lod.scales[child]);
+    max_opacity = std::max(max_opacity, double(lod.colors[child].w));
+  }
+  // Fully transparent (or degenerate) children are weighted equally.
+  bool is_uniform = !(total_weight > 0.);
+  weights.resize(parent.num_children);
+  double color[3] = {};
+  for (uint32_t child = begin; child < end; ++child) {
+    double weight = is_uniform ? 1. / parent.num_children
+                               : lod.colors[child].w *
+                                     get_area(lod.scales[child]) / total_weight;
+    weights[child - begin] = weight;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      color[axis] += weight * lod.colors[child][axis];
+    }
+  }
+
+  Float3& merged_position = lod.positions[node];
+  match_moments(std::span(lod.positions).subspan(begin, parent.num_children),
+                std::span(lod.rotations).subspan(begin, parent.num_children),
+                std::span(lod.scales).subspan(begin, parent.num_children),
+                weights, merged_position, lod.rotations[node],
+                lod.scales[node]);
+
+  double area = get_area(lod.scales[node]);
+  double opacity = is_uniform ? 0.
+                   : area > 0. ? std::min(total_weight / area, 1.)
+                               : max_opacity;
+  lod.colors[node] = Float4(
+      static_cast<float>(color[0]), static_cast<float>(color[1]),
+      static_cast<float>(color[2]), static_cast<float>(opacity));
+
+  float radius = 0.f;
+  for (uint32_t child = begin; child < end; ++child) {
+    radius = std::max(radius, length(lod.positions[child] - merged_position) +
+                                  lod.nodes[child].radius);
+  }
+  lod.nodes[node].radius = std::max(
+      radius, settings.extent_sigma *
+                  std::max(std::max(lod.scales[node].x, lod.scales[node].y),
+                           lod.scales[node].z));
+}
+}  // namespace
+
+bool build_lod(std::span<const Float3> positions,
+               std::span<const Float4> rotations,
+               std::span<const Float3> scales, std::span<const Float4> colors,
+               const LodSettings& settings, SplatLod& lod) {
+  SPLAT_TRACE_STAGE(TraceStage::BuildLod);
+  lod = SplatLod();
+  size_t num_splats = positions.size();
+  // A tree with n leaves has fewer than 2n nodes.
+  if (num_splats >= std::numeric_limits<uint32_t>::max() / 2) {
+    log_error("Too many splats (%zu) to build LOD for", num_splats);
+    return false;
+  }
+  if (settings.max_leaf_splats < 2) {
+    log_error("LOD leaf cells must hold at least 2 splats");
+    return false;
+  }
+  if (num_splats == 0) {
+    lod.level_offsets = {0};
+    return true;
+  }
+  SPLAT_TRACE_COUNT(TraceStage::BuildLod,
+                    num_splats * (sizeof(Float3) * 2 + sizeof(Float4) * 2),
+                    num_splats);
+
+  std::vector<std::pair<uint64_t, uint32_t>> keys;
+  sort_morton(positions, keys);
+
+  // Breadth first construction: node `i` covers keys [ranges[i].first,
+  // ranges[i].second), and its children are appended as it is visited.
+  std::vector<std::pair<size_t, size_t>> ranges = {{0, num_splats}};
+  std::vector<uint32_t> depths = {0};
+  // Up to 8 octants, or up to `max_leaf_splats` splats of a leaf cell.
+  std::vector<std::pair<size_t, size_t>> children;
+  lod.nodes.resize(1);
+  for (uint32_t node = 0; node < lod.nodes.size(); ++node) {
+    auto [begin, end] = ranges[node];
+    if (end - begin == 1) {
+      lod.nodes[node].source_index = keys[begin].second;
+      continue;
+    }
+
+    children.clear();
+    uint64_t differing = keys[begin].first ^ keys[end - 1].first;
+    if (end - begin <= settings.max_leaf_splats) {
+      for (size_t i = begin; i < end; ++i) {
+        children.emplace_back(i, i + 1);
+      }
+    } else if (differing == 0) {
+      // Splats in the same finest cell, split evenly.
+      for (uint32_t part = 0; part < 8; ++part) {
+        size_t part_begin = begin + (end - begin) * part / 8;
+        size_t part_end = begin + (end - begin) * (part + 1) / 8;
+        if (part_begin != part_end) {
+          children.emplace_back(part_begin, part_end);
+        }
+      }
+    } else {
+      // Octants of the largest cell whose splats aren't all in one octant.
+      uint32_t shift = (63 - std::countl_zero(differing)) / 3 * 3;
+      size_t child_begin = begin;
+      for (size_t i = begin + 1; i <= end; ++i) {
+        if (i == end || (keys[i].first >> shift & 7) !=
+                            (keys[child_begin].first >> shift & 7)) {
+          children.emplace_back(child_begin, i);
+          child_begin = i;
+        }
+      }
+    }
+
+    lod.nodes[node].first_child = static_cast<uint32_t>(lod.nodes.size());
+    lod.nodes[node].num_children = static_cast<uint32_t>(children.size());
+    for (const std::pair<size_t, size_t>& child : children) {
+      lod.nodes.emplace_back();
+      ranges.push_back(child);
+      depths.push_back(depths[node] + 1);
+    }
+  }
+
+  size_t num_nodes = lod.nodes.size();
+  for (uint32_t node = 0; node < num_nodes; ++node) {
+    if (node == 0 || depths[node] != depths[node - 1]) {
+      lod.level_offsets.push_back(node);
+    }
+  }
+  lod.level_offsets.push_back(static_cast<uint32_t>(num_nodes));
+
+  lod.positions.resize(num_nodes);
+  lod.rotations.resize(num_nodes);
+  lod.scales.resize(num_nodes);
+  lod.colors.resize(num_nodes);
+  parallel_for(num_nodes, min_splats_per_task, [&](size_t begin, size_t end) {
+    for (size_t node = begin; node < end; ++node) {
+      uint32_t source = lod.nodes[node].source_index;
+      if (source == lod_no_source) {
+        continue;
+      }
+      lod.positions[node] = positions[source];
+      lod.rotations[node] = rotations[source];
+      lod.scales[node] = scales[source];
+      lod.colors[node] = colors[source];
+      const Float3& scale = scales[source];
+      lod.nodes[node].radius =
+          settings.extent_sigma *
+          std::max(std::max(scale.x, scale.y), scale.z);
+    }
+  });
+
+  // Children are always deeper, so merge from the deepest level up.
+  for (size_t level = lod.level_offsets.size() - 1; level-- > 0;) {
+    uint32_t level_begin = lod.level_offsets[level];
+    uint32_t level_size = lod.level_offsets[level + 1] - level_begin;
+    parallel_for(level_size, min_splats_per_task / 8,
+                 [&](size_t begin, size_t end) {
+                   std::vector<double> weights;
+                   for (size_t i = begin; i < end; ++i) {
+                     uint32_t node = level_begin + static_cast<uint32_t>(i);
+                     if (lod.nodes[node].num_children != 0) {
+                       merge_children(node, settings, lod, weights);
+                     }
+                   }
+                 });
+  }
+  return true;
+}
+}  // namespace import
\ No newline at end of file
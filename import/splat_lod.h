@@ -0,0 +1,112 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "import/splat_math.h"
+
+namespace import {
+/**
+ * `LodNode::source_index` of merged splats.
+ */
+constexpr uint32_t lod_no_source = std::numeric_limits<uint32_t>::max();
+
+/**
+ * Node of a `SplatLod` tree. Each node is a splat: leaves are the source
+ * splats, and each other node approximates all of its descendants.
+ */
+struct LodNode {
+  /**
+   * Children are the nodes [first_child, first_child + num_children). Leaves
+   * have none.
+   */
+  uint32_t first_child = 0;
+  uint32_t num_children = 0;
+  /**
+   * For leaves, index of the source splat, else `lod_no_source`.
+   */
+  uint32_t source_index = lod_no_source;
+  /**
+   * Radius of a sphere around the node's position bounding its descendants,
+   * out to `LodSettings::extent_sigma`. Contains the spheres of its children,
+   * so a parent is never smaller, or further away, than its children.
+   */
+  float radius = 0.f;
+};
+
+/**
+ * Settings of `build_lod`.
+ */
+struct LodSettings {
+  /**
+   * Octree cells holding at most this many splats aren't subdivided, and
+   * merge their splats directly. At least 2.
+   */
+  uint32_t max_leaf_splats = 8;
+  /**
+   * Extent of splats, in σ's, used for `LodNode::radius` and for the opacity
+   * of merged splats. Should match the radius the shaders draw.
+   */
+  float extent_sigma = 3.f;
+};
+
+/**
+ * Splats of all levels of detail, in the format produced by `convert_splat`
+ * (with colors as floats), one per node of the tree.
+ *
+ * Nodes are stored breadth first: the root is node 0, each node's children
+ * are contiguous, and the nodes of each depth are contiguous, so that levels
+ * may be streamed or uploaded independently.
+ */
+struct SplatLod {
+  std::vector<LodNode> nodes;
+  std::vector<Float3> positions;
+  std::vector<Float4> rotations;
+  std::vector<Float3> scales;
+  /**
+   * Linear RGB, and opacity, in [0, 1].
+   */
+  std::vector<Float4> colors;
+  /**
+   * Nodes of depth `d` are [level_offsets[d], level_offsets[d + 1]).
+   */
+  std::vector<uint32_t> level_offsets;
+};
+
+/**
+ * Builds a level of detail hierarchy over splats, at import time.
+ *
+ * Splats are sorted along a Morton curve over their bounds, which orders them
+ * as the leaves of an octree. Cells are subdivided until they hold at most
+ * `max_leaf_splats` splats; cells with a single non-empty octant are skipped,
+ * so each merged splat has between 2 and 8 children, or up to
+ * `max_leaf_splats` if its cell is a leaf.
+ *
+ * Each merged splat matches the first two moments of its children, weighted
+ * by opacity * projected area (the product of the two largest scales): its
+ * position is their weighted mean, and its covariance is the weighted mean of
+ * their covariances plus the spread of their positions. Its color is their
+ * weighted mean, and its opacity is such that its opacity * area is their
+ * total, up to 1. Merging runs in parallel, one level at a time.
+ *
+ * @param positions - Positions, as written by `convert_splat`.
+ * @param rotations - Normalized rotation quaternions.
+ * @param scales - Linear scales.
+ * @param colors - Linear RGB, and opacity, in [0, 1].
+ * @param settings - Build settings.
+ * @param lod - Output.
+ * @return Whether the hierarchy was built. Fails if there are more splats than
+ * can be indexed by nodes.
+ */
+SPLAT_EXPORT_API bool build_lod(std::span<const Float3> positions,
+                                std::span<const Float4> rotations,
+                                std::span<const Float3> scales,
+                                std::span<const Float4> colors,
+                                const LodSettings& settings, SplatLod& lod);
+}  // namespace import
\ No newline at end of file
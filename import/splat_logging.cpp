@@ -15,9 +15,13 @@ void log(Level level, const char* format, va_list args) {
     return;
   }
 
+  // Measuring consumes the arguments, so they're copied for formatting.
+  va_list format_args;
+  va_copy(format_args, args);
   int size = vsnprintf(nullptr, 0, format, args);
-  std::string buffer("", size + 1);
-  vsnprintf(buffer.data(), buffer.size(), format, args);
+  std::string buffer(size + 1, '\0');
+  vsnprintf(buffer.data(), buffer.size(), format, format_args);
+  va_end(format_args);
   send_log(level, buffer.c_str());
 }
 
@@ -0,0 +1,122 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace import {
+/**
+ * Minimal vector and matrix types, for CPU-side processing of splats.
+ *
+ * These intentionally mirror their HLSL namesakes (and Unreal's conventions),
+ * so that code ported from the shaders reads the same:
+ * - Matrices are row-major, and vectors are rows: `mul(v, M)` is v * M.
+ * - Translation lives in the last row.
+ *
+ * They are also constructible from their components, so may be used as the
+ * `F3`/`F4` types accepted by `convert_splat`.
+ */
+struct Float2 {
+  constexpr Float2() = default;
+  constexpr Float2(float x, float y) : x(x), y(y) {}
+
+  float x = 0.f;
+  float y = 0.f;
+};
+
+struct Float3 {
+  constexpr Float3() = default;
+  constexpr Float3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+  float& operator[](uint32_t i) { return (&x)[i]; }
+  float operator[](uint32_t i) const { return (&x)[i]; }
+
+  float x = 0.f;
+  float y = 0.f;
+  float z = 0.f;
+};
+
+struct Float4 {
+  constexpr Float4() = default;
+  constexpr Float4(float x, float y, float z, float w)
+      : x(x), y(y), z(z), w(w) {}
+  constexpr Float4(const Float3& v, float w) : x(v.x), y(v.y), z(v.z), w(w) {}
+
+  float& operator[](uint32_t i) { return (&x)[i]; }
+  float operator[](uint32_t i) const { return (&x)[i]; }
+
+  Float3 xyz() const { return Float3(x, y, z); }
+
+  float x = 0.f;
+  float y = 0.f;
+  float z = 0.f;
+  float w = 0.f;
+};
+
+struct Float4x4 {
+  static constexpr Float4x4 identity() {
+    Float4x4 result;
+    for (uint32_t i = 0; i < 4; ++i) {
+      result.m[i][i] = 1.f;
+    }
+    return result;
+  }
+
+  float m[4][4] = {};
+};
+
+inline Float3 operator+(const Float3& a, const Float3& b) {
+  return Float3(a.x + b.x, a.y + b.y, a.z + b.z);
+}
+inline Float3 operator-(const Float3& a, const Float3& b) {
+  return Float3(a.x - b.x, a.y - b.y, a.z - b.z);
+}
+inline Float3 operator*(const Float3& a, float s) {
+  return Float3(a.x * s, a.y * s, a.z * s);
+}
+inline Float3 operator*(const Float3& a, const Float3& b) {
+  return Float3(a.x * b.x, a.y * b.y, a.z * b.z);
+}
+
+inline float dot(const Float3& a, const Float3& b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Float3 cross(const Float3& a, const Float3& b) {
+  return Float3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z,
+                a.x * b.y - a.y * b.x);
+}
+
+inline float length(const Float3& v) { return std::sqrt(dot(v, v)); }
+
+inline Float3 normalize(const Float3& v) { return v * (1.f / length(v)); }
+
+/**
+ * Row vector * matrix, i.e. HLSL's `mul(v, M)`.
+ */
+inline Float4 mul(const Float4& v, const Float4x4& M) {
+  Float4 result;
+  for (uint32_t j = 0; j < 4; ++j) {
+    result[j] = v.x * M.m[0][j] + v.y * M.m[1][j] + v.z * M.m[2][j] +
+                v.w * M.m[3][j];
+  }
+  return result;
+}
+
+inline Float4x4 mul(const Float4x4& A, const Float4x4& B) {
+  Float4x4 result;
+  for (uint32_t i = 0; i < 4; ++i) {
+    for (uint32_t j = 0; j < 4; ++j) {
+      float sum = 0.f;
+      for (uint32_t k = 0; k < 4; ++k) {
+        sum += A.m[i][k] * B.m[k][j];
+      }
+      result.m[i][j] = sum;
+    }
+  }
+  return result;
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,58 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_morton.h"
+
+#include <algorithm>
+
+#include "import/splat_parallel.h"
+
+namespace import {
+namespace {
+/**
+ * Spreads the low 21 bits of `value` to every third bit.
+ */
+inline uint64_t spread_bits(uint64_t value) {
+  value &= 0x1FFFFFu;
+  value = (value | value << 32) & 0x1F00000000FFFFull;
+  value = (value | value << 16) & 0x1F0000FF0000FFull;
+  value = (value | value << 8) & 0x100F00F00F00F00Full;
+  value = (value | value << 4) & 0x10C30C30C30C30C3ull;
+  value = (value | value << 2) & 0x1249249249249249ull;
+  return value;
+}
+}  // namespace
+
+void sort_morton(std::span<const Float3> positions,
+                 std::vector<std::pair<uint64_t, uint32_t>>& keys) {
+  size_t num_splats = positions.size();
+  keys.resize(num_splats);
+  if (num_splats == 0) {
+    return;
+  }
+
+  Float3 min = positions[0];
+  Float3 max = positions[0];
+  for (const Float3& position : positions) {
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], position[axis]);
+      max[axis] = std::max(max[axis], position[axis]);
+    }
+  }
+  float size = std::max(std::max(max.x - min.x, max.y - min.y), max.z - min.z);
+  float to_cell = size > 0.f ? float((1u << morton_bits) - 1) / size : 0.f;
+  parallel_for(num_splats, min_splats_per_task, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      uint64_t code = 0;
+      for (uint32_t axis = 0; axis < 3; ++axis) {
+        code |= spread_bits(static_cast<uint64_t>(
+                    (positions[i][axis] - min[axis]) * to_cell))
+                << axis;
+      }
+      keys[i] = {code, static_cast<uint32_t>(i)};
+    }
+  });
+  parallel_sort(keys, min_splats_per_task);
+}
+}  // namespace import
\ No newline at end of file
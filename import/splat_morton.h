@@ -0,0 +1,32 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "import/splat_math.h"
+
+namespace import {
+/**
+ * Bits per axis of Morton codes.
+ */
+constexpr uint32_t morton_bits = 21;
+
+/**
+ * Sorts splats along a Morton curve over a cube bounding their positions, so
+ * that each octree cell over that cube is a contiguous range. Runs in
+ * parallel.
+ *
+ * @param positions - Positions to sort. Must be finite.
+ * @param keys - Output, Morton code (with bit `3 * b + axis` being bit `b` of
+ * the cell along `axis`) and index of each splat, in ascending order.
+ */
+SPLAT_EXPORT_API void sort_morton(
+    std::span<const Float3> positions,
+    std::vector<std::pair<uint64_t, uint32_t>>& keys);
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,97 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace import {
+namespace {
+void run_tasks_default(uint32_t num_tasks, void* context,
+                       void (*task)(void* context, uint32_t task_index)) {
+  std::vector<std::thread> threads;
+  threads.reserve(num_tasks);
+  for (uint32_t i = 1; i < num_tasks; ++i) {
+    threads.emplace_back(task, context, i);
+  }
+  // The calling thread takes a share, rather than idling.
+  task(context, 0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+std::atomic<RunTasksFn> task_runner = run_tasks_default;
+std::atomic<uint32_t> task_concurrency = 0;
+}  // namespace
+
+void set_task_runner(RunTasksFn run_tasks, uint32_t concurrency) {
+  task_runner = run_tasks ? run_tasks : run_tasks_default;
+  task_concurrency = concurrency;
+}
+
+uint32_t get_task_concurrency() {
+  uint32_t concurrency = task_concurrency;
+  if (concurrency == 0) {
+    concurrency = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return concurrency;
+}
+
+void run_tasks(uint32_t num_tasks, const std::function<void(uint32_t)>& task) {
+  if (num_tasks == 0) {
+    return;
+  }
+  if (num_tasks == 1) {
+    task(0);
+    return;
+  }
+
+  task_runner.load()(
+      num_tasks, const_cast<std::function<void(uint32_t)>*>(&task),
+      [](void* context, uint32_t task_index) {
+        (*static_cast<const std::function<void(uint32_t)>*>(context))(
+            task_index);
+      });
+}
+
+uint32_t get_num_ranges(size_t count, size_t min_batch) {
+  size_t max_ranges = count / std::max<size_t>(min_batch, 1);
+  return static_cast<uint32_t>(std::clamp<size_t>(
+      max_ranges, 1, get_task_concurrency()));
+}
+
+uint32_t parallel_for(size_t count, size_t min_batch,
+                      const std::function<void(size_t begin, size_t end)>& fn) {
+  uint32_t num_ranges = get_num_ranges(count, min_batch);
+  run_tasks(num_ranges, [&](uint32_t i) {
+    fn(count * i / num_ranges, count * (i + 1) / num_ranges);
+  });
+  return num_ranges;
+}
+
+void parallel_sort(std::span<std::pair<uint64_t, uint32_t>> keys,
+                   size_t min_batch) {
+  uint32_t num_tasks = get_num_ranges(keys.size(), min_batch);
+  auto get_begin = [&](uint32_t task) {
+    return keys.begin() +
+           static_cast<ptrdiff_t>(keys.size() * task / num_tasks);
+  };
+  run_tasks(num_tasks, [&](uint32_t task) {
+    std::sort(get_begin(task), get_begin(task + 1));
+  });
+  for (uint32_t width = 1; width < num_tasks; width *= 2) {
+    uint32_t num_merges = (num_tasks + 2 * width - 1) / (2 * width);
+    run_tasks(num_merges, [&](uint32_t merge) {
+      uint32_t begin = merge * 2 * width;
+      uint32_t middle = std::min(begin + width, num_tasks);
+      uint32_t end = std::min(begin + 2 * width, num_tasks);
+      std::inplace_merge(get_begin(begin), get_begin(middle), get_begin(end));
+    });
+  }
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,80 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+
+namespace import {
+/**
+ * Minimum number of splats per task for per-splat work, e.g. the
+ * `min_batch` of `parallel_for`. Below this, threading overhead dominates.
+ */
+inline constexpr size_t min_splats_per_task = 1 << 15;
+
+/**
+ * Function type which runs `num_tasks` tasks, potentially in parallel, and
+ * returns once all have completed. `task` should be called once with each
+ * index in [0, num_tasks).
+ *
+ * Engines should route this into their own task system (see
+ * `set_task_runner`), so that splat processing shares worker threads with the
+ * rest of the frame.
+ */
+typedef void (*RunTasksFn)(uint32_t num_tasks, void* context,
+                           void (*task)(void* context, uint32_t task_index));
+
+/**
+ * Overrides how parallel work is executed. By default, tasks are run on
+ * short-lived `std::thread`s.
+ *
+ * @param run_tasks - Task runner, or `nullptr` to restore the default.
+ * @param concurrency - Number of tasks that may usefully run at once (i.e.
+ * worker count). 0 to use `std::thread::hardware_concurrency`.
+ */
+SPLAT_EXPORT_API void set_task_runner(RunTasksFn run_tasks,
+                                      uint32_t concurrency);
+
+/**
+ * @return Number of tasks that may usefully run at once.
+ */
+SPLAT_EXPORT_API uint32_t get_task_concurrency();
+
+/**
+ * Runs `task` for each index in [0, num_tasks) with the current task runner,
+ * and waits for completion.
+ */
+SPLAT_EXPORT_API void run_tasks(uint32_t num_tasks,
+                                const std::function<void(uint32_t)>& task);
+
+/**
+ * @return Number of ranges `parallel_for` will split [0, count) into.
+ */
+SPLAT_EXPORT_API uint32_t get_num_ranges(size_t count, size_t min_batch);
+
+/**
+ * Splits [0, count) into at most `get_task_concurrency` contiguous ranges of
+ * at least `min_batch` items, and runs `fn(begin, end)` for each in parallel.
+ *
+ * @return Number of ranges used. Range `i` is
+ * [count * i / num_ranges, count * (i + 1) / num_ranges).
+ */
+SPLAT_EXPORT_API uint32_t
+parallel_for(size_t count, size_t min_batch,
+             const std::function<void(size_t begin, size_t end)>& fn);
+
+/**
+ * Sorts key and index pairs in parallel: each range of `parallel_for` is
+ * sorted, then ranges are merged pairwise.
+ *
+ * @param keys - Pairs to sort, by key then index.
+ * @param min_batch - Minimum number of pairs per range.
+ */
+SPLAT_EXPORT_API void parallel_sort(
+    std::span<std::pair<uint64_t, uint32_t>> keys, size_t min_batch);
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_pruning.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "import/splat_tracing.h"
+
+namespace import {
+namespace {
+inline bool is_finite(const Float3& v) {
+  return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
+}
+
+inline bool is_finite(const Float4& v) {
+  return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z) &&
+         std::isfinite(v.w);
+}
+}  // namespace
+
+const char* get_prune_reason_name(PruneReason reason) {
+  switch (reason) {
+    case PruneReason::Kept:
+      return "kept";
+    case PruneReason::NonFinite:
+      return "non_finite";
+    case PruneReason::Transparent:
+      return "transparent";
+    case PruneReason::Small:
+      return "small";
+    case PruneReason::LowContribution:
+      return "low_contribution";
+    case PruneReason::Outlier:
+      return "outlier";
+    case PruneReason::Duplicate:
+      return "duplicate";
+    default:
+      return "unknown";
+  }
+}
+
+PruneReason get_prune_reason(const Float3& position, const Float4& rotation,
+                             const Float3& scale, float opacity,
+                             const PruneSettings& settings) {
+  if (!is_finite(position) || !is_finite(rotation) || !is_finite(scale)) {
+    return PruneReason::NonFinite;
+  }
+  if (!(opacity >= settings.min_opacity)) {
+    return PruneReason::Transparent;
+  }
+
+  // The projection of an ellipsoid is bounded by the ellipse of its two
+  // largest axes, which it reaches when facing the camera.
+  float x = std::abs(scale.x);
+  float y = std::abs(scale.y);
+  float z = std::abs(scale.z);
+  float a = std::max({x, y, z});
+  float b = std::max(std::min(x, y), std::min(std::max(x, y), z));
+  float pixels_per_sigma = settings.extent_sigma *
+                           settings.focal_length_pixels /
+                           settings.min_view_distance;
+  float radius = a * pixels_per_sigma;
+  if (radius < settings.min_radius_pixels) {
+    return PruneReason::Small;
+  }
+  float area = std::numbers::pi_v<float> * radius * (b * pixels_per_sigma);
+  if (opacity * area < settings.min_contribution) {
+    return PruneReason::LowContribution;
+  }
+  return PruneReason::Kept;
+}
+
+PruneStats classify_splats(std::span<const Float3> positions,
+                           std::span<const Float4> rotations,
+                           std::span<const Float3> scales,
+                           std::span<const float> opacities,
+                           const PruneSettings& settings,
+                           std::span<PruneReason> reasons) {
+  SPLAT_TRACE_STAGE(TraceStage::Prune);
+  size_t num_splats = positions.size();
+  uint32_t num_tasks = get_num_ranges(num_splats, min_splats_per_task);
+  auto get_begin = [&](uint32_t task) { return num_splats * task / num_tasks; };
+
+  // Per-task histograms, summed once all tasks are done.
+  std::vector<PruneStats> task_stats(num_tasks);
+  run_tasks(num_tasks, [&](uint32_t task) {
+    PruneStats& stats = task_stats[task];
+    for (size_t i = get_begin(task), end = get_begin(task + 1); i < end; ++i) {
+      PruneReason reason = get_prune_reason(positions[i], rotations[i],
+                                            scales[i], opacities[i], settings);
+      reasons[i] = reason;
+      ++stats.counts[static_cast<uint32_t>(reason)];
+    }
+  });
+
+  PruneStats stats;
+  for (const PruneStats& task : task_stats) {
+    for (uint32_t reason = 0; reason < num_prune_reasons; ++reason) {
+      stats.counts[reason] += task.counts[reason];
+    }
+  }
+  SPLAT_TRACE_COUNT(
+      TraceStage::Prune,
+      num_splats * (sizeof(Float3) * 2 + sizeof(Float4) + sizeof(float)),
+      num_splats);
+  return stats;
+}
+
+uint64_t mark_outliers(const KdTree& tree, const OutlierSettings& settings,
+                       std::span<PruneReason> reasons) {
+  SPLAT_TRACE_STAGE(TraceStage::FindOutliers);
+  std::span<const KdPoint> points = tree.get_points();
+  size_t num_points = points.size();
+  uint32_t k = settings.num_neighbors;
+  if (k == 0 || num_points <= k) {
+    return 0;
+  }
+  uint32_t num_tasks = get_num_ranges(num_points, min_splats_per_task);
+  auto get_begin = [&](uint32_t task) { return num_points * task / num_tasks; };
+
+  // Mean distance of each point to its neighbors, in tree order, and their
+  // per-task sums for the global mean and standard deviation.
+  std::vector<float> mean_distances(num_points);
+  std::vector<double> sums(num_tasks);
+  std::vector<double> sums_squared(num_tasks);
+  run_tasks(num_tasks, [&](uint32_t task) {
+    std::vector<KdNeighbor> neighbors;
+    double sum = 0.0;
+    double sum_squared = 0.0;
+    for (size_t i = get_begin(task), end = get_begin(task + 1); i < end; ++i) {
+      // The point itself is among its k + 1 nearest, unless k others share
+      // its position, in which case any one of them is skipped.
+      tree.find_nearest(points[i].position, k + 1, neighbors);
+      auto self = std::find_if(
+          neighbors.begin(), neighbors.end(),
+          [&](const KdNeighbor& n) { return n.index == points[i].index; });
+      float total = 0.f;
+      for (auto it = neighbors.begin(); it != neighbors.end(); ++it) {
+        total += it == self ? 0.f : std::sqrt(it->distance_squared);
+      }
+      if (self == neighbors.end()) {
+        total -= std::sqrt(neighbors.back().distance_squared);
+      }
+      float mean = total / static_cast<float>(k);
+      mean_distances[i] = mean;
+      sum += mean;
+      sum_squared += static_cast<double>(mean) * mean;
+    }
+    sums[task] = sum;
+    sums_squared[task] = sum_squared;
+  });
+
+  double sum = 0.0;
+  double sum_squared = 0.0;
+  for (uint32_t task = 0; task < num_tasks; ++task) {
+    sum += sums[task];
+    sum_squared += sums_squared[task];
+  }
+  double mean = sum / static_cast<double>(num_points);
+  double variance = std::max(
+      sum_squared / static_cast<double>(num_points) - mean * mean, 0.0);
+  float max_distance = static_cast<float>(
+      mean + settings.max_std_devs * std::sqrt(variance));
+
+  std::vector<uint64_t> num_marked(num_tasks);
+  run_tasks(num_tasks, [&](uint32_t task) {
+    for (size_t i = get_begin(task), end = get_begin(task + 1); i < end; ++i) {
+      PruneReason& reason = reasons[points[i].index];
+      if (mean_distances[i] > max_distance && reason == PruneReason::Kept) {
+        reason = PruneReason::Outlier;
+        ++num_marked[task];
+      }
+    }
+  });
+
+  uint64_t total_marked = 0;
+  for (uint64_t count : num_marked) {
+    total_marked += count;
+  }
+  SPLAT_TRACE_COUNT(TraceStage::FindOutliers,
+                    num_points * sizeof(KdPoint) * (k + 1), num_points);
+  return total_marked;
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,227 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "import/splat_kd_tree.h"
+#include "import/splat_math.h"
+#include "import/splat_parallel.h"
+
+namespace import {
+/**
+ * Why `classify_splats` drops a splat, in order of precedence.
+ */
+enum class PruneReason : uint8_t {
+  Kept,
+  /**
+   * NaN or infinite position, rotation or scale. Zero-length rotations are
+   * NaN once normalized by `convert_splat`.
+   */
+  NonFinite,
+  /**
+   * Opacity below `PruneSettings::min_opacity`, i.e. an alpha of 0 once
+   * converted by `to_alpha_linear`.
+   */
+  Transparent,
+  /**
+   * Projected radius below `PruneSettings::min_radius_pixels`.
+   */
+  Small,
+  /**
+   * Opacity * projected area below `PruneSettings::min_contribution`.
+   */
+  LowContribution,
+  /**
+   * Far from its neighbors, as found by `mark_outliers`.
+   */
+  Outlier,
+  /**
+   * Merged into a near-identical splat by `merge_duplicates`.
+   */
+  Duplicate,
+  Count
+};
+
+constexpr uint32_t num_prune_reasons =
+    static_cast<uint32_t>(PruneReason::Count);
+
+/**
+ * Settings of `classify_splats`.
+ *
+ * Projected sizes are upper bounds: those of a splat seen at
+ * `min_view_distance`, facing the camera, through a lens of
+ * `focal_length_pixels`. Splats below the size thresholds there are below
+ * them from every view the asset is expected to be seen from.
+ */
+struct PruneSettings {
+  /**
+   * Splats strictly below this opacity are dropped. The default drops splats
+   * which would be drawn with an alpha of 0.
+   */
+  float min_opacity = 1.f / 255.f;
+  /**
+   * Closest distance the camera is expected to get to any splat, in meters.
+   */
+  float min_view_distance = 0.1f;
+  /**
+   * Largest expected focal length in pixels, i.e. half the viewport height
+   * over the tangent of half the vertical field of view.
+   */
+  float focal_length_pixels = 1000.f;
+  /**
+   * Extent of splats, in σ's. Should match the radius the shaders draw.
+   */
+  float extent_sigma = 3.f;
+  /**
+   * Splats whose largest projected radius is below this, in pixels, are
+   * dropped. 0 disables the check.
+   */
+  float min_radius_pixels = 0.05f;
+  /**
+   * Splats whose opacity * largest projected area is below this, in pixels,
+   * are dropped. 0 disables the check.
+   */
+  float min_contribution = 0.01f;
+};
+
+/**
+ * Settings of `mark_outliers`.
+ */
+struct OutlierSettings {
+  /**
+   * Number of nearest neighbors whose mean distance is measured.
+   */
+  uint32_t num_neighbors = 16;
+  /**
+   * Splats whose mean distance is more than this many standard deviations
+   * above the mean, over all splats, are outliers.
+   */
+  float max_std_devs = 3.f;
+};
+
+/**
+ * Result of `classify_splats`.
+ */
+struct PruneStats {
+  /**
+   * Number of splats per `PruneReason`, including those kept.
+   */
+  uint64_t counts[num_prune_reasons] = {};
+};
+
+/**
+ * @param reason - Reason to name.
+ * @return Name of `reason`, e.g. for reports.
+ */
+SPLAT_EXPORT_API const char* get_prune_reason_name(PruneReason reason);
+
+/**
+ * Estimates the largest contribution of a single splat, and decides whether
+ * it is worth drawing.
+ *
+ * @param position - Position, as written by `convert_splat`.
+ * @param rotation - Normalized rotation quaternion.
+ * @param scale - Linear scale.
+ * @param opacity - Opacity, in [0, 1].
+ * @param settings - Thresholds.
+ * @return `PruneReason::Kept`, or why the splat should be dropped.
+ */
+SPLAT_EXPORT_API PruneReason get_prune_reason(const Float3& position,
+                                              const Float4& rotation,
+                                              const Float3& scale,
+                                              float opacity,
+                                              const PruneSettings& settings);
+
+/**
+ * Decides which converted splats to drop, with `get_prune_reason`, in
+ * parallel. Dropped splats cost sorting, vertex shading and memory, but add
+ * nothing visible.
+ *
+ * Call after conversion and before packing, then remove the dropped splats
+ * from each array with `compact_kept`.
+ *
+ * @param positions - Positions, as written by `convert_splat`.
+ * @param rotations - Normalized rotation quaternions.
+ * @param scales - Linear scales.
+ * @param opacities - Opacities, in [0, 1].
+ * @param settings - Thresholds.
+ * @param reasons - Output, one per splat.
+ * @return Histogram of reasons.
+ */
+SPLAT_EXPORT_API PruneStats classify_splats(std::span<const Float3> positions,
+                                            std::span<const Float4> rotations,
+                                            std::span<const Float3> scales,
+                                            std::span<const float> opacities,
+                                            const PruneSettings& settings,
+                                            std::span<PruneReason> reasons);
+
+/**
+ * Statistical outlier removal: marks as `PruneReason::Outlier` the kept
+ * splats whose mean distance to their nearest neighbors is unusually large,
+ * such as floaters left by capture. These inflate the bounds over which
+ * positions are quantized, and add overdraw.
+ *
+ * Neighbors are found with `tree`, querying in tree order for coherence, in
+ * parallel. Dropped splats still count as neighbors, so build the tree after
+ * removing those found by `classify_splats`.
+ *
+ * @param tree - Tree built over the splats `reasons` refers to.
+ * @param settings - Thresholds.
+ * @param reasons - Input and output, one per splat.
+ * @return Number of splats marked.
+ */
+SPLAT_EXPORT_API uint64_t mark_outliers(const KdTree& tree,
+                                        const OutlierSettings& settings,
+                                        std::span<PruneReason> reasons);
+
+/**
+ * Moves the values of kept splats to the front of `values`, in their original
+ * order. Runs in parallel: each task compacts its own range, then the ranges
+ * are moved down, in order.
+ *
+ * @param values - Per-splat values of any type, e.g. the `colors` written by
+ * `convert_splat`.
+ * @param reasons - As written by `classify_splats`.
+ * @return Number of values kept, to which `values` may be resized.
+ */
+template <typename T>
+size_t compact_kept(std::span<T> values, std::span<const PruneReason> reasons) {
+  size_t count = std::min(values.size(), reasons.size());
+  uint32_t num_tasks = get_num_ranges(count, min_splats_per_task);
+  auto get_begin = [&](uint32_t task) { return count * task / num_tasks; };
+
+  std::vector<size_t> num_kept(num_tasks);
+  run_tasks(num_tasks, [&](uint32_t task) {
+    size_t begin = get_begin(task);
+    size_t end = get_begin(task + 1);
+    size_t dst = begin;
+    for (size_t i = begin; i < end; ++i) {
+      if (reasons[i] == PruneReason::Kept) {
+        if (dst != i) {
+          values[dst] = std::move(values[i]);
+        }
+        ++dst;
+      }
+    }
+    num_kept[task] = dst - begin;
+  });
+
+  // Ranges only ever move down, so forward moves are safe.
+  size_t dst = 0;
+  for (uint32_t task = 0; task < num_tasks; ++task) {
+    auto begin = values.begin() + get_begin(task);
+    if (dst != get_begin(task)) {
+      std::move(begin, begin + num_kept[task], values.begin() + dst);
+    }
+    dst += num_kept[task];
+  }
+  return dst;
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,249 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_tracing.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace import {
+namespace {
+struct TraceEvent {
+  const char* name;
+  uint64_t begin_ns;
+  uint64_t end_ns;
+};
+
+/**
+ * Single-producer buffer, owned by one recording thread. The owner writes an
+ * event, then publishes it by bumping `count` with release semantics; readers
+ * only ever look at events below an acquired `count`.
+ */
+struct ThreadBuffer {
+  uint32_t thread_index = 0;
+  std::atomic<uint32_t> count = 0;
+  std::array<TraceEvent, SPLAT_TRACE_EVENTS_PER_THREAD> events;
+};
+
+struct AtomicStageCounters {
+  std::atomic<uint64_t> calls = 0;
+  std::atomic<uint64_t> bytes = 0;
+  std::atomic<uint64_t> splats = 0;
+  std::atomic<uint64_t> nanoseconds = 0;
+};
+
+/**
+ * Buffers are never freed, as zones recorded by a thread remain exportable
+ * after it exits. Instead, a thread's buffer is returned to `free_buffers` on
+ * exit, and taken by the next thread to record, so their number is bounded by
+ * the number of threads recording at once.
+ */
+std::mutex buffers_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+std::vector<ThreadBuffer*> free_buffers;
+std::atomic<uint64_t> dropped_events = 0;
+
+std::array<AtomicStageCounters, static_cast<size_t>(TraceStage::Count)>
+    stage_counters;
+
+/**
+ * Buffer used by the calling thread, returned to the pool when it exits.
+ */
+struct ThreadBufferLease {
+  ThreadBuffer* buffer = nullptr;
+
+  ~ThreadBufferLease() {
+    if (buffer) {
+      std::lock_guard lock(buffers_mutex);
+      free_buffers.push_back(buffer);
+    }
+  }
+};
+
+thread_local ThreadBufferLease thread_buffer;
+
+ThreadBuffer& get_thread_buffer() {
+  if (!thread_buffer.buffer) {
+    std::lock_guard lock(buffers_mutex);
+    if (!free_buffers.empty()) {
+      thread_buffer.buffer = free_buffers.back();
+      free_buffers.pop_back();
+    } else {
+      buffers.push_back(std::make_unique<ThreadBuffer>());
+      buffers.back()->thread_index = static_cast<uint32_t>(buffers.size());
+      thread_buffer.buffer = buffers.back().get();
+    }
+  }
+  return *thread_buffer.buffer;
+}
+
+AtomicStageCounters& get_counters(TraceStage stage) {
+  return stage_counters[static_cast<size_t>(stage)];
+}
+
+void append_escaped(std::string& out, const char* text) {
+  for (; *text; ++text) {
+    if (*text == '"' || *text == '\\') {
+      out += '\\';
+    }
+    out += *text;
+  }
+}
+}  // namespace
+
+const char* get_stage_name(TraceStage stage) {
+  switch (stage) {
+    case TraceStage::ParseMetadata:
+      return "parse_metadata";
+    case TraceStage::ParseData:
+      return "parse_data";
+    case TraceStage::Pack:
+      return "pack";
+    case TraceStage::ComputeDistances:
+      return "compute_distances";
+    case TraceStage::Sort:
+      return "sort";
+    case TraceStage::Resort:
+      return "resort";
+    case TraceStage::Compact:
+      return "compact";
+    case TraceStage::Transform:
+      return "transform";
+    case TraceStage::Rasterize:
+      return "rasterize";
+    case TraceStage::BuildLod:
+      return "build_lod";
+    case TraceStage::SelectLod:
+      return "select_lod";
+    case TraceStage::Prune:
+      return "prune";
+    case TraceStage::BuildKdTree:
+      return "build_kd_tree";
+    case TraceStage::FindOutliers:
+      return "find_outliers";
+    case TraceStage::MergeDuplicates:
+      return "merge_duplicates";
+    case TraceStage::BuildChunks:
+      return "build_chunks";
+    case TraceStage::CullChunks:
+      return "cull_chunks";
+    case TraceStage::BuildDirectionalOrders:
+      return "build_directional_orders";
+    case TraceStage::DecodeDirectionalOrder:
+      return "decode_directional_order";
+    case TraceStage::HierarchicalSort:
+      return "hierarchical_sort";
+    default:
+      return "unknown";
+  }
+}
+
+uint64_t get_trace_time_ns() {
+  static const std::chrono::steady_clock::time_point epoch =
+      std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+void record_trace_event(const char* name, uint64_t begin_ns, uint64_t end_ns) {
+  ThreadBuffer& buffer = get_thread_buffer();
+  uint32_t index = buffer.count.load(std::memory_order_relaxed);
+  if (index >= buffer.events.size()) {
+    dropped_events.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events[index] = TraceEvent{name, begin_ns, end_ns};
+  buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void add_stage_time(TraceStage stage, uint64_t nanoseconds) {
+  AtomicStageCounters& counters = get_counters(stage);
+  counters.calls.fetch_add(1, std::memory_order_relaxed);
+  counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+void add_stage_work(TraceStage stage, uint64_t bytes, uint64_t splats) {
+  AtomicStageCounters& counters = get_counters(stage);
+  counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  counters.splats.fetch_add(splats, std::memory_order_relaxed);
+}
+
+StageCounters get_stage_counters(TraceStage stage) {
+  AtomicStageCounters& counters = get_counters(stage);
+  return StageCounters{counters.calls.load(std::memory_order_relaxed),
+                       counters.bytes.load(std::memory_order_relaxed),
+                       counters.splats.load(std::memory_order_relaxed),
+                       counters.nanoseconds.load(std::memory_order_relaxed)};
+}
+
+void reset_stage_counters() {
+  for (AtomicStageCounters& counters : stage_counters) {
+    counters.calls = 0;
+    counters.bytes = 0;
+    counters.splats = 0;
+    counters.nanoseconds = 0;
+  }
+}
+
+std::string export_chrome_trace() {
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  char event[128];
+
+  std::lock_guard lock(buffers_mutex);
+  for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+    uint32_t count = buffer->count.load(std::memory_order_acquire);
+
+    snprintf(event, sizeof(event),
+             "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+             "\"args\":{\"name\":\"splat thread %u\"}}",
+             first ? "" : ",", buffer->thread_index, buffer->thread_index);
+    json += event;
+    first = false;
+
+    for (uint32_t i = 0; i < count; ++i) {
+      const TraceEvent& e = buffer->events[i];
+      json += ",\n{\"name\":\"";
+      append_escaped(json, e.name);
+      // Chrome trace timestamps are in (fractional) microseconds.
+      snprintf(event, sizeof(event),
+               "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+               buffer->thread_index, e.begin_ns / 1000.,
+               (e.end_ns - e.begin_ns) / 1000.);
+      json += event;
+    }
+  }
+  json += "\n]}\n";
+
+  return json;
+}
+
+bool write_chrome_trace(const char* path) {
+  std::string json = export_chrome_trace();
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+  bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+  return fclose(file) == 0 && success;
+}
+
+void clear_trace_events() {
+  std::lock_guard lock(buffers_mutex);
+  for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+    buffer->count.store(0, std::memory_order_release);
+  }
+  dropped_events = 0;
+}
+
+uint64_t get_dropped_trace_events() {
+  return dropped_events.load(std::memory_order_relaxed);
+}
+}  // namespace import
\ No newline at end of file
@@ -0,0 +1,263 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Lightweight tracing of the import and CPU render-prep paths.
+ *
+ * Tracing is compiled out unless `SPLAT_TRACING` is defined to 1, in which case
+ * every `SPLAT_TRACE_SCOPE` records a (begin, end) timestamp pair into a buffer
+ * owned by the calling thread. Recording never takes a lock; a mutex is only
+ * taken once per thread, to take a buffer from a pool. When the thread exits,
+ * its buffer returns to the pool with its zones, so short-lived task threads
+ * reuse buffers rather than each allocating one.
+ *
+ * Recorded zones can be exported as Chrome trace JSON (loadable in
+ * chrome://tracing or https://ui.perfetto.dev), and per-stage totals can be
+ * polled at any time, e.g. by an engine profiler.
+ */
+#ifndef SPLAT_TRACING
+#define SPLAT_TRACING 0
+#endif
+
+/**
+ * Max zones recorded per buffer between calls to `clear_trace_events`, i.e. by
+ * all threads that used it. Further zones are dropped (and counted).
+ */
+#ifndef SPLAT_TRACE_EVENTS_PER_THREAD
+#define SPLAT_TRACE_EVENTS_PER_THREAD (1 << 16)
+#endif
+
+#define SPLAT_TRACE_CONCAT_INNER(a, b) a##b
+#define SPLAT_TRACE_CONCAT(a, b) SPLAT_TRACE_CONCAT_INNER(a, b)
+
+#if SPLAT_TRACING
+/**
+ * Records a zone covering the enclosing scope. `name` must be a string literal
+ * (or otherwise outlive the trace).
+ */
+#define SPLAT_TRACE_SCOPE(name) \
+  ::import::TraceScope SPLAT_TRACE_CONCAT(splat_trace_scope_, __LINE__)(name)
+
+/**
+ * Records a zone covering the enclosing scope, named after `stage`, and adds
+ * its duration to the stage's counters.
+ */
+#define SPLAT_TRACE_STAGE(stage)                                 \
+  ::import::TraceStageScope SPLAT_TRACE_CONCAT(splat_trace_stage_, \
+                                               __LINE__)(stage)
+
+/**
+ * Adds the amount of work done to a stage's counters.
+ */
+#define SPLAT_TRACE_COUNT(stage, bytes, splats) \
+  ::import::add_stage_work(stage, bytes, splats)
+#else
+#define SPLAT_TRACE_SCOPE(name)
+#define SPLAT_TRACE_STAGE(stage)
+#define SPLAT_TRACE_COUNT(stage, bytes, splats)
+#endif
+
+namespace import {
+/**
+ * Coarse stages of the pipeline, for which totals are accumulated.
+ */
+enum class TraceStage : uint32_t {
+  ParseMetadata,
+  /**
+   * Includes the conversion performed by the `ParseSplatFn` callback, as that
+   * is called per splat from within `parse_data`.
+   */
+  ParseData,
+  /**
+   * Packing into runtime formats. Performed by the integrating engine, which
+   * may record it with `SPLAT_TRACE_STAGE(TraceStage::Pack)`.
+   */
+  Pack,
+  /**
+   * Sort key computation, mirroring `compute_distance.cs.hlsl`.
+   */
+  ComputeDistances,
+  Sort,
+  /**
+   * Incremental repair of the previous frame's order. Fallbacks to a full sort
+   * are recorded under `Sort`.
+   */
+  Resort,
+  /**
+   * Removal of culled splats, mirroring the compaction shaders.
+   */
+  Compact,
+  /**
+   * Projection of covariances, mirroring `compute_transform.cs.hlsl`.
+   */
+  Transform,
+  /**
+   * Reference rasterization, mirroring `render_splat.vs.hlsl` and
+   * `render_splat.ps.hlsl`.
+   */
+  Rasterize,
+  /**
+   * Import-time construction of levels of detail.
+   */
+  BuildLod,
+  /**
+   * Selection of the levels of detail to draw.
+   */
+  SelectLod,
+  /**
+   * Import-time removal of splats which add nothing visible.
+   */
+  Prune,
+  BuildKdTree,
+  /**
+   * Statistical outlier detection over k nearest neighbors.
+   */
+  FindOutliers,
+  MergeDuplicates,
+  /**
+   * Import-time grouping of splats into spatially coherent chunks.
+   */
+  BuildChunks,
+  /**
+   * Frustum culling of chunk bounds, ahead of the per-splat pass.
+   */
+  CullChunks,
+  /**
+   * Import-time sorting of splats along each of a set of view directions.
+   */
+  BuildDirectionalOrders,
+  /**
+   * Decoding of a precomputed directional order, in place of a sort.
+   */
+  DecodeDirectionalOrder,
+  /**
+   * Two-level sort of chunks, then of splats within overlapping chunks.
+   */
+  HierarchicalSort,
+  Count
+};
+
+/**
+ * Totals for a single stage since the last `reset_stage_counters`.
+ */
+struct StageCounters {
+  uint64_t calls = 0;
+  uint64_t bytes = 0;
+  uint64_t splats = 0;
+  uint64_t nanoseconds = 0;
+};
+
+/**
+ * @param stage - Stage to name.
+ * @return Human readable name, e.g. "parse_data".
+ */
+SPLAT_EXPORT_API const char* get_stage_name(TraceStage stage);
+
+/**
+ * Polls the totals of a stage. Safe to call from any thread, at any time.
+ * Always zero if compiled without `SPLAT_TRACING`.
+ *
+ * @param stage - Stage to query.
+ * @return Totals since the last reset.
+ */
+SPLAT_EXPORT_API StageCounters get_stage_counters(TraceStage stage);
+
+/**
+ * Zeroes the totals of all stages.
+ */
+SPLAT_EXPORT_API void reset_stage_counters();
+
+/**
+ * Exports all recorded zones as Chrome trace JSON ("X" complete events, one
+ * track per buffer, shared by the threads that used it in turn).
+ *
+ * @return JSON document. Contains no events if compiled without
+ * `SPLAT_TRACING`.
+ */
+SPLAT_EXPORT_API std::string export_chrome_trace();
+
+/**
+ * Writes `export_chrome_trace` to a file.
+ *
+ * @param path - Output path, e.g. "import.trace.json".
+ * @return Whether the file was written.
+ */
+SPLAT_EXPORT_API bool write_chrome_trace(const char* path);
+
+/**
+ * Discards all recorded zones.
+ *
+ * Note: Must not be called while other threads may be recording, as the
+ * buffers are only ever appended to by their owners.
+ */
+SPLAT_EXPORT_API void clear_trace_events();
+
+/**
+ * @return Number of zones dropped due to full buffers since the last
+ * `clear_trace_events`.
+ */
+SPLAT_EXPORT_API uint64_t get_dropped_trace_events();
+
+/**
+ * Nanoseconds since the first call, from a monotonic clock.
+ */
+SPLAT_EXPORT_API uint64_t get_trace_time_ns();
+
+/**
+ * Appends a zone to the calling thread's buffer.
+ */
+SPLAT_EXPORT_API void record_trace_event(const char* name, uint64_t begin_ns,
+                                         uint64_t end_ns);
+
+/**
+ * Adds to a stage's totals.
+ */
+SPLAT_EXPORT_API void add_stage_time(TraceStage stage, uint64_t nanoseconds);
+SPLAT_EXPORT_API void add_stage_work(TraceStage stage, uint64_t bytes,
+                                     uint64_t splats);
+
+/**
+ * RAII zone. Prefer `SPLAT_TRACE_SCOPE`, which compiles out when disabled.
+ */
+class TraceScope {
+ public:
+  explicit TraceScope(const char* name)
+      : name(name), begin_ns(get_trace_time_ns()) {}
+  ~TraceScope() { record_trace_event(name, begin_ns, get_trace_time_ns()); }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  const char* name;
+  uint64_t begin_ns;
+};
+
+/**
+ * RAII stage zone. Prefer `SPLAT_TRACE_STAGE`, which compiles out when
+ * disabled.
+ */
+class TraceStageScope {
+ public:
+  explicit TraceStageScope(TraceStage stage)
+      : stage(stage), begin_ns(get_trace_time_ns()) {}
+  ~TraceStageScope() {
+    uint64_t end_ns = get_trace_time_ns();
+    record_trace_event(get_stage_name(stage), begin_ns, end_ns);
+    add_stage_time(stage, end_ns - begin_ns);
+  }
+
+  TraceStageScope(const TraceStageScope&) = delete;
+  TraceStageScope& operator=(const TraceStageScope&) = delete;
+
+ private:
+  TraceStage stage;
+  uint64_t begin_ns;
+};
+}  // namespace import
\ No newline at end of file
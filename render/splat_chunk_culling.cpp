@@ -0,0 +1,244 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_chunk_culling.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "import/splat_tracing.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPLAT_CULL_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPLAT_CULL_NEON 1
+#endif
+
+namespace render {
+namespace {
+using import::SplatChunk;
+using import::TraceStage;
+
+/**
+ * Padded bounds of a chunk, in local space.
+ */
+struct LocalBounds {
+  Float3 min;
+  Float3 max;
+};
+
+inline LocalBounds get_local_bounds(const SplatChunk& chunk,
+                                    const DistanceParams& params,
+                                    float bounds_scale) {
+  LocalBounds bounds;
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    float pad = std::abs(params.pos_scale_cm[axis]);
+    bounds.min[axis] = chunk.min[axis] * bounds_scale - pad;
+    bounds.max[axis] = chunk.max[axis] * bounds_scale + pad;
+  }
+  return bounds;
+}
+
+/**
+ * Views culled against, as in `compute_distance.cs.hlsl`.
+ */
+inline std::span<const Float4x4> get_cull_views(const DistanceParams& params) {
+  uint32_t num_cull_views = std::min(params.num_cull_views, max_cull_views);
+  return num_cull_views != 0
+             ? std::span<const Float4x4>(params.cull_local_to_clip,
+                                         num_cull_views)
+             : std::span<const Float4x4>(&params.local_to_clip, 1);
+}
+
+/**
+ * Whether all corners of `bounds` are outside of the same plane of the
+ * frustum of `local_to_clip`.
+ */
+bool is_outside_frustum(const LocalBounds& bounds,
+                        const Float4x4& local_to_clip) {
+  bool all_left = true, all_right = true, all_bottom = true, all_top = true,
+       all_far = true;
+  for (uint32_t corner = 0; corner < 8; ++corner) {
+    Float4 pos_local((corner & 1 ? bounds.max : bounds.min).x,
+                     (corner & 2 ? bounds.max : bounds.min).y,
+                     (corner & 4 ? bounds.max : bounds.min).z, 1.f);
+    Float4 pos_clip = mul(pos_local, local_to_clip);
+    all_left &= pos_clip.x < -pos_clip.w;
+    all_right &= pos_clip.x > pos_clip.w;
+    all_bottom &= pos_clip.y < -pos_clip.w;
+    all_top &= pos_clip.y > pos_clip.w;
+    all_far &= pos_clip.z > pos_clip.w;
+  }
+  return all_left || all_right || all_bottom || all_top || all_far;
+}
+
+inline bool is_visible(const SplatChunk& chunk, const DistanceParams& params,
+                       float bounds_scale) {
+  LocalBounds bounds = get_local_bounds(chunk, params, bounds_scale);
+  for (const Float4x4& view : get_cull_views(params)) {
+    if (!is_outside_frustum(bounds, view)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#if defined(SPLAT_CULL_SSE2) || defined(SPLAT_CULL_NEON)
+/**
+ * Chunks tested at once by `get_visible_mask`.
+ */
+constexpr uint32_t num_lanes = 4;
+#endif
+
+#if defined(SPLAT_CULL_SSE2)
+using Lanes = __m128;
+using LaneMask = __m128;
+
+inline Lanes lanes_set(float value) { return _mm_set1_ps(value); }
+inline Lanes lanes_load(const float* values) { return _mm_loadu_ps(values); }
+inline Lanes lanes_add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+inline Lanes lanes_mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+inline Lanes lanes_neg(Lanes a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+inline LaneMask lanes_less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+inline LaneMask lanes_greater(Lanes a, Lanes b) { return _mm_cmpgt_ps(a, b); }
+inline LaneMask mask_all() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+inline LaneMask mask_and(LaneMask a, LaneMask b) { return _mm_and_ps(a, b); }
+inline LaneMask mask_or(LaneMask a, LaneMask b) { return _mm_or_ps(a, b); }
+inline uint32_t mask_bits(LaneMask mask) {
+  return static_cast<uint32_t>(_mm_movemask_ps(mask));
+}
+#elif defined(SPLAT_CULL_NEON)
+using Lanes = float32x4_t;
+using LaneMask = uint32x4_t;
+
+inline Lanes lanes_set(float value) { return vdupq_n_f32(value); }
+inline Lanes lanes_load(const float* values) { return vld1q_f32(values); }
+inline Lanes lanes_add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+inline Lanes lanes_mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+inline Lanes lanes_neg(Lanes a) { return vnegq_f32(a); }
+inline LaneMask lanes_less(Lanes a, Lanes b) { return vcltq_f32(a, b); }
+inline LaneMask lanes_greater(Lanes a, Lanes b) { return vcgtq_f32(a, b); }
+inline LaneMask mask_all() { return vdupq_n_u32(~0u); }
+inline LaneMask mask_and(LaneMask a, LaneMask b) { return vandq_u32(a, b); }
+inline LaneMask mask_or(LaneMask a, LaneMask b) { return vorrq_u32(a, b); }
+inline uint32_t mask_bits(LaneMask mask) {
+  const uint32_t bits[num_lanes] = {1, 2, 4, 8};
+  return vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+}
+#endif
+
+#if defined(SPLAT_CULL_SSE2) || defined(SPLAT_CULL_NEON)
+/**
+ * Lanes version of `is_visible`, for chunks [first, first + 4).
+ *
+ * @return Bit `i` set if chunk `first + i` is visible.
+ */
+uint32_t get_visible_mask(const SplatChunk* chunks,
+                          const DistanceParams& params, float bounds_scale) {
+  // Transpose the bounds, so that each lane holds one chunk.
+  float corners[2][3][num_lanes];
+  for (uint32_t lane = 0; lane < num_lanes; ++lane) {
+    LocalBounds bounds =
+        get_local_bounds(chunks[lane], params, bounds_scale);
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      corners[0][axis][lane] = bounds.min[axis];
+      corners[1][axis][lane] = bounds.max[axis];
+    }
+  }
+  Lanes bounds[2][3];
+  for (uint32_t side = 0; side < 2; ++side) {
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      bounds[side][axis] = lanes_load(corners[side][axis]);
+    }
+  }
+
+  LaneMask outside = mask_all();
+  for (const Float4x4& view : get_cull_views(params)) {
+    LaneMask all_left = mask_all(), all_right = mask_all(),
+             all_bottom = mask_all(), all_top = mask_all(),
+             all_far = mask_all();
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+      Lanes x = bounds[corner & 1][0];
+      Lanes y = bounds[corner >> 1 & 1][1];
+      Lanes z = bounds[corner >> 2][2];
+      Lanes clip[4];
+      for (uint32_t c = 0; c < 4; ++c) {
+        clip[c] = lanes_add(
+            lanes_add(lanes_add(lanes_mul(x, lanes_set(view.m[0][c])),
+                                lanes_mul(y, lanes_set(view.m[1][c]))),
+                      lanes_mul(z, lanes_set(view.m[2][c]))),
+            lanes_set(view.m[3][c]));
+      }
+      Lanes neg_w = lanes_neg(clip[3]);
+      all_left = mask_and(all_left, lanes_less(clip[0], neg_w));
+      all_right = mask_and(all_right, lanes_greater(clip[0], clip[3]));
+      all_bottom = mask_and(all_bottom, lanes_less(clip[1], neg_w));
+      all_top = mask_and(all_top, lanes_greater(clip[1], clip[3]));
+      all_far = mask_and(all_far, lanes_greater(clip[2], clip[3]));
+    }
+    LaneMask outside_view =
+        mask_or(mask_or(mask_or(all_left, all_right),
+                        mask_or(all_bottom, all_top)),
+                all_far);
+    outside = mask_and(outside, outside_view);
+  }
+  return ~mask_bits(outside) & 0xFu;
+}
+#endif
+}  // namespace
+
+uint64_t cull_chunks(std::span<const SplatChunk> chunks,
+                     const DistanceParams& params, float bounds_scale,
+                     std::vector<ChunkRange>& ranges) {
+  SPLAT_TRACE_STAGE(TraceStage::CullChunks);
+  ranges.clear();
+  uint64_t num_visible = 0;
+  auto add_visible = [&](const SplatChunk& chunk) {
+    num_visible += chunk.num_splats;
+    if (!ranges.empty() && ranges.back().first_splat +
+                                   ranges.back().num_splats ==
+                               chunk.first_splat) {
+      ranges.back().num_splats += chunk.num_splats;
+    } else {
+      ranges.push_back({chunk.first_splat, chunk.num_splats});
+    }
+  };
+
+  size_t i = 0;
+#if defined(SPLAT_CULL_SSE2) || defined(SPLAT_CULL_NEON)
+  for (; i + num_lanes <= chunks.size(); i += num_lanes) {
+    uint32_t visible = get_visible_mask(&chunks[i], params, bounds_scale);
+    for (uint32_t lane = 0; lane < num_lanes; ++lane) {
+      if (visible >> lane & 1) {
+        add_visible(chunks[i + lane]);
+      }
+    }
+  }
+#endif
+  for (; i < chunks.size(); ++i) {
+    if (is_visible(chunks[i], params, bounds_scale)) {
+      add_visible(chunks[i]);
+    }
+  }
+  SPLAT_TRACE_COUNT(TraceStage::CullChunks,
+                    chunks.size() * sizeof(SplatChunk), num_visible);
+  return num_visible;
+}
+
+void get_chunk_thread_groups(std::span<const ChunkRange> ranges,
+                             uint32_t thread_group_size,
+                             std::vector<ChunkRange>& groups) {
+  groups.clear();
+  for (const ChunkRange& range : ranges) {
+    for (uint32_t offset = 0; offset < range.num_splats;
+         offset += thread_group_size) {
+      groups.push_back({range.first_splat + offset,
+                        std::min(thread_group_size,
+                                 range.num_splats - offset)});
+    }
+  }
+}
+}  // namespace render
\ No newline at end of file
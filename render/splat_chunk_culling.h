@@ -0,0 +1,67 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "import/splat_chunks.h"
+#include "render/splat_sort.h"
+
+namespace render {
+/**
+ * Contiguous range of splats, e.g. of adjacent visible chunks. Matches the
+ * `uint2` of `chunk_groups` in `compute_distance.cs.hlsl`.
+ */
+struct ChunkRange {
+  uint32_t first_splat = 0;
+  uint32_t num_splats = 0;
+};
+
+/**
+ * Frustum culls whole chunks (see `import::build_chunks`) ahead of the
+ * per-splat pass, so that splats of chunks behind the viewer, or otherwise
+ * out of view, are never transformed.
+ *
+ * Chunks are culled against the same frustum as `compute_distance.cs.hlsl`
+ * would cull their splats against: `local_to_clip`, or, with
+ * `num_cull_views`, the union of the cull views (i.e. both eyes' frustums,
+ * with `WITH_STEREO_SORT`). A chunk is culled if all corners of its bounds,
+ * padded by a quantization step of the packed positions, are outside of the
+ * same plane of each view, so no splat the per-splat pass would keep is ever
+ * culled. Splats of visible chunks are still culled individually.
+ *
+ * Tests 4 chunks at a time with SSE2/NEON where available, on the calling
+ * thread.
+ *
+ * @param chunks - Chunks, of splats stored in `SplatChunks::order`.
+ * @param params - View and unpacking constants of the per-splat pass.
+ * @param bounds_scale - Scale from the units of chunk bounds to local space,
+ * e.g. 100 for bounds in meters and positions in cm.
+ * @param ranges - Output, splats of visible chunks, in order, with adjacent
+ * chunks merged.
+ * @return Number of splats in visible chunks.
+ */
+SPLAT_EXPORT_API uint64_t cull_chunks(
+    std::span<const import::SplatChunk> chunks, const DistanceParams& params,
+    float bounds_scale, std::vector<ChunkRange>& ranges);
+
+/**
+ * Splits visible ranges into thread groups, for `CHUNKED_DISPATCH` in
+ * `compute_distance.cs.hlsl`: thread group `g` measures
+ * `groups[g].num_splats` splats from `groups[g].first_splat`. Only the last
+ * group of each range is partial; chunks holding a multiple of
+ * `thread_group_size` splats avoid those.
+ *
+ * @param ranges - As written by `cull_chunks`.
+ * @param thread_group_size - `THREAD_GROUP_SIZE_X` of the pass.
+ * @param groups - Output, the `chunk_groups` buffer. Its size is the number
+ * of thread groups to dispatch.
+ */
+SPLAT_EXPORT_API void get_chunk_thread_groups(
+    std::span<const ChunkRange> ranges, uint32_t thread_group_size,
+    std::vector<ChunkRange>& groups);
+}  // namespace render
\ No newline at end of file
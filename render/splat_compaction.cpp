@@ -0,0 +1,75 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_compaction.h"
+
+#include <vector>
+
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+using import::TraceStage;
+}  // namespace
+
+CompactionArgs compact_visible(std::span<const uint32_t> indices,
+                               std::span<const uint32_t> distances,
+                               uint32_t not_visible, uint32_t thread_group_size,
+                               std::span<uint32_t> compacted_indices,
+                               std::span<uint32_t> compacted_distances) {
+  SPLAT_TRACE_STAGE(TraceStage::Compact);
+
+  size_t num_splats = indices.size();
+  SPLAT_TRACE_COUNT(TraceStage::Compact,
+                    2 * (indices.size_bytes() + distances.size_bytes()),
+                    num_splats);
+
+  // Tasks play the role of thread groups: count, scan the counts, then
+  // scatter. Visible splats end up in the same order either way.
+  uint32_t num_tasks = import::get_num_ranges(num_splats, min_splats_per_task);
+  std::vector<size_t> offsets(num_tasks + 1);
+  auto get_begin = [&](uint32_t task) {
+    return num_splats * task / num_tasks;
+  };
+
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    size_t count = 0;
+    for (size_t i = get_begin(task), end = get_begin(task + 1); i < end; ++i) {
+      count += distances[i] != not_visible;
+    }
+    offsets[task + 1] = count;
+  });
+
+  for (uint32_t task = 0; task < num_tasks; ++task) {
+    offsets[task + 1] += offsets[task];
+  }
+
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    size_t offset = offsets[task];
+    for (size_t i = get_begin(task), end = get_begin(task + 1); i < end; ++i) {
+      if (distances[i] != not_visible) {
+        compacted_indices[offset] = indices[i];
+        compacted_distances[offset] = distances[i];
+        ++offset;
+      }
+    }
+  });
+
+  CompactionArgs args;
+  args.num_visible = static_cast<uint32_t>(offsets[num_tasks]);
+  args.dispatch_thread_group_count[0] =
+      (args.num_visible + thread_group_size - 1) / thread_group_size;
+  args.dispatch_thread_group_count[1] = 1;
+  args.dispatch_thread_group_count[2] = 1;
+  args.draw_vertex_count_per_instance = args.num_visible * vertices_per_splat;
+  args.draw_instance_count = 1;
+  args.draw_indexed_index_count_per_instance =
+      quads_per_instance * indices_per_quad;
+  args.draw_indexed_instance_count =
+      (args.num_visible + quads_per_instance - 1) / quads_per_instance;
+  return args;
+}
+}  // namespace render
\ No newline at end of file
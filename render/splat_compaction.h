@@ -0,0 +1,60 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "render/splat_constants.h"
+
+namespace render {
+/**
+ * Layout of `indirect_args`, as written by `compact_scan.cs.hlsl`. Mirrors the
+ * `INDIRECT_*_OFFSET` defines of `constants.hlsl`.
+ */
+struct CompactionArgs {
+  /**
+   * Thread group counts of a pass with one thread per visible splat.
+   */
+  uint32_t dispatch_thread_group_count[3] = {};
+  uint32_t draw_vertex_count_per_instance = 0;
+  uint32_t draw_instance_count = 0;
+  uint32_t draw_start_vertex_location = 0;
+  uint32_t draw_start_instance_location = 0;
+  /**
+   * Arguments of `INDEXED_QUADS` draws.
+   */
+  uint32_t draw_indexed_index_count_per_instance = 0;
+  uint32_t draw_indexed_instance_count = 0;
+  uint32_t draw_indexed_start_index_location = 0;
+  int32_t draw_indexed_base_vertex_location = 0;
+  uint32_t draw_indexed_start_instance_location = 0;
+  uint32_t num_visible = 0;
+};
+static_assert(sizeof(CompactionArgs) == 13 * sizeof(uint32_t),
+              "Must match INDIRECT_ARGS_SIZE");
+
+/**
+ * CPU mirror of the compaction passes (`compact_count.cs.hlsl`,
+ * `compact_scan.cs.hlsl` and `compact_scatter.cs.hlsl`), for validating their
+ * output bit for bit: visible splats, in their original order, followed by
+ * whatever was previously in the compacted buffers.
+ *
+ * Runs in parallel, with the same count, scan and scatter structure.
+ *
+ * @param indices - Splat indices, as written by `compute_distance.cs.hlsl`.
+ * @param distances - Sort keys, as written by `compute_distance.cs.hlsl`.
+ * @param not_visible - Key of culled splats, `DISTANCE_NOT_VISIBLE`.
+ * @param thread_group_size - `THREAD_GROUP_SIZE_X` of the passes.
+ * @param compacted_indices - Output. At least as large as `indices`.
+ * @param compacted_distances - Output. At least as large as `indices`.
+ * @return Indirect arguments.
+ */
+SPLAT_EXPORT_API CompactionArgs compact_visible(
+    std::span<const uint32_t> indices, std::span<const uint32_t> distances,
+    uint32_t not_visible, uint32_t thread_group_size,
+    std::span<uint32_t> compacted_indices,
+    std::span<uint32_t> compacted_distances);
+}  // namespace render
\ No newline at end of file
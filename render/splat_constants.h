@@ -0,0 +1,137 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace render {
+/**
+ * CPU mirror of `constants.hlsl`. Keep in sync.
+ */
+
+/**
+ * Limit to how far from the center of each Gaussian is evaluated, in σ's.
+ */
+inline const float radius_sigma = std::sqrt(8.f);
+inline const float radius_sigma_over_sqrt_2 = radius_sigma / std::sqrt(2.f);
+inline const float cutoff_radius_sigma_squared_over_2 =
+    radius_sigma_over_sqrt_2 * radius_sigma_over_sqrt_2;
+
+/**
+ * Lowest alpha a fragment can contribute to an 8-bit render target.
+ */
+constexpr float min_alpha = 1.f / 255.f;
+
+/**
+ * Largest scale of each axis of a splat's transform, in pixels * 2. See
+ * `MAX_TRANSFORM_SCALE` in `constants.hlsl`.
+ */
+constexpr float max_transform_scale = 32768.f;
+
+/**
+ * Accumulated alpha past which front-to-back blending stops shading a pixel.
+ * See `FRONT_TO_BACK` in `constants.hlsl`.
+ */
+constexpr float saturation_alpha = 1.f - min_alpha;
+
+/**
+ * Range of the depth weights of weighted blended order-independent
+ * transparency. See `WEIGHTED_OIT` in `constants.hlsl`.
+ */
+constexpr float oit_min_weight = 1e-2f;
+constexpr float oit_max_weight = 3e2f;
+
+/**
+ * Depth weight of a fragment with `WEIGHTED_OIT`, as computed by
+ * `weighted_oit.hlsl`, before multiplying by its alpha. The same for all of a
+ * splat's fragments.
+ *
+ * @param depth - View depth of the splat, scaled by `oit_depth_scale`.
+ * @return Weight of the fragment's color and alpha, per unit of alpha.
+ */
+inline float get_oit_depth_weight(float depth) {
+  float near = depth / 5.f;
+  float far = depth / 200.f;
+  float far_cubed = far * far * far;
+  float weight = 10.f / (1e-5f + near * near + far_cubed * far_cubed);
+  return std::clamp(weight, oit_min_weight, oit_max_weight);
+}
+
+/**
+ * @param alpha - Alpha of the fragment.
+ * @param depth - View depth of the splat, scaled by `oit_depth_scale`.
+ * @return Weight of the fragment's color and alpha, as computed by
+ * `weighted_oit.hlsl`.
+ */
+inline float get_oit_weight(float alpha, float depth) {
+  return alpha * get_oit_depth_weight(depth);
+}
+
+/**
+ * Radius of a splat's quad with `OPACITY_ADAPTIVE_RADIUS`, as computed by
+ * `render_splat.vs.hlsl`: where the splat's alpha falls below `min_alpha`,
+ * capped at `radius_sigma`.
+ *
+ * @param alpha - Opacity of the splat, in [0, 1].
+ * @return Radius in σ's, over sqrt(2). 0 for splats too faint to draw.
+ */
+inline float get_radius_sigma_over_sqrt_2(float alpha) {
+  if (alpha <= min_alpha) {
+    return 0.f;
+  }
+  return std::sqrt(std::min(std::log(alpha / min_alpha),
+                            cutoff_radius_sigma_squared_over_2));
+}
+
+/**
+ * Geometry of each splat, as drawn by `render_splat.vs.hlsl`. See
+ * `splat_draw.h`.
+ */
+constexpr uint32_t vertices_per_splat = 6;
+constexpr uint32_t vertices_per_quad = 4;
+constexpr uint32_t indices_per_quad = 6;
+/**
+ * Quads per instance of `INDEXED_QUADS` draws. The most that 16-bit indices
+ * can address.
+ */
+constexpr uint32_t quads_per_instance = 16384;
+
+/**
+ * Encoding of sort keys. Mirrors `DISTANCE_ENCODING`; see `constants.hlsl`.
+ */
+enum class DistanceEncoding : uint32_t {
+  ClipDepth,
+  LinearDepth,
+  LogDepth,
+  FloatFlip,
+};
+
+/**
+ * Default precision with which to sort splats.
+ */
+constexpr uint32_t distance_precision = 16;
+
+/**
+ * @param precision - Key bits, in [1, 32].
+ * @return Key of culled splats, `DISTANCE_NOT_VISIBLE`.
+ */
+constexpr uint32_t get_distance_not_visible(uint32_t precision) {
+  return precision >= 32 ? 0xFFFFFFFFu : (1u << precision) - 1;
+}
+
+/**
+ * @param precision - Key bits, in [1, 24].
+ * @return Scale from [0, 1] to keys, `DISTANCE_SCALE`.
+ */
+constexpr float get_distance_scale(uint32_t precision) {
+  return static_cast<float>(get_distance_not_visible(precision) - 1);
+}
+
+constexpr float distance_scale = get_distance_scale(distance_precision);
+constexpr uint32_t distance_not_visible =
+    get_distance_not_visible(distance_precision);
+}  // namespace render
\ No newline at end of file
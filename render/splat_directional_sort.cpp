@@ -0,0 +1,67 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_directional_sort.h"
+
+#include <cmath>
+#include <numbers>
+
+namespace render {
+float get_angular_radius(const Float3& center, float radius,
+                         const Float3& camera_position) {
+  float distance = length(center - camera_position);
+  return distance > radius ? std::asin(radius / distance)
+                           : std::numbers::pi_v<float>;
+}
+
+uint32_t find_nearest_direction(std::span<const Float3> directions,
+                                const Float3& view_direction) {
+  uint32_t nearest = 0;
+  float nearest_cos = -2.f;
+  for (uint32_t d = 0; d < directions.size(); ++d) {
+    float cos = dot(directions[d], view_direction);
+    if (cos > nearest_cos) {
+      nearest = d;
+      nearest_cos = cos;
+    }
+  }
+  return nearest;
+}
+
+DirectionalSortResult DirectionalSorter::sort(
+    const import::DirectionalOrders& orders,
+    const DirectionalSortParams& params) {
+  if (orders.directions.empty() ||
+      get_angular_radius(orders.center, orders.radius,
+                         params.camera_position) >
+          params.max_angular_radius) {
+    return DirectionalSortResult::NotApplicable;
+  }
+
+  Float3 view_direction = normalize(orders.center - params.camera_position);
+  uint32_t nearest = find_nearest_direction(orders.directions, view_direction);
+  if (nearest == direction && params.front_to_back == front_to_back) {
+    return DirectionalSortResult::Unchanged;
+  }
+
+  indices.resize(orders.num_splats);
+  if (!import::decode_directional_order(orders, nearest, indices)) {
+    reset();
+    return DirectionalSortResult::NotApplicable;
+  }
+  order.resize(indices.size());
+  uint32_t last = static_cast<uint32_t>(indices.size()) - 1;
+  for (uint32_t i = 0; i < indices.size(); ++i) {
+    order[i] = {indices[params.front_to_back ? last - i : i], i};
+  }
+  direction = nearest;
+  front_to_back = params.front_to_back;
+  return DirectionalSortResult::Decoded;
+}
+
+void DirectionalSorter::reset() {
+  order.clear();
+  direction = UINT32_MAX;
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "import/splat_directional_orders.h"
+#include "render/splat_sort.h"
+
+namespace render {
+/**
+ * Constants of `DirectionalSorter::sort`.
+ */
+struct DirectionalSortParams {
+  /**
+   * In the units of the positions the orders were built from (i.e. meters, in
+   * the importer's axes).
+   */
+  Float3 camera_position;
+  /**
+   * Largest angular radius of the asset's bounding sphere, in radians, for
+   * which a precomputed order is used. Over it, perspective makes the order
+   * depend on the camera position.
+   */
+  float max_angular_radius = 0.05f;
+  /**
+   * Reverses the order, matching `DistanceParams::front_to_back`.
+   */
+  bool front_to_back = false;
+};
+
+/**
+ * How the last call to `DirectionalSorter::sort` produced its order.
+ */
+enum class DirectionalSortResult : uint32_t {
+  /**
+   * The asset is too close for a precomputed order; sort it per frame.
+   */
+  NotApplicable,
+  /**
+   * The nearest direction is the same as last time; the order was kept.
+   */
+  Unchanged,
+  /**
+   * The order of a new nearest direction was decoded.
+   */
+  Decoded,
+};
+
+/**
+ * @param center - Center of a bounding sphere.
+ * @param radius - Radius of the sphere.
+ * @param camera_position - Camera position, in the same units.
+ * @return Angular radius of the sphere seen from `camera_position`, in
+ * radians. Pi if the camera is inside it.
+ */
+SPLAT_EXPORT_API float get_angular_radius(const Float3& center, float radius,
+                                          const Float3& camera_position);
+
+/**
+ * @param directions - Unit directions, e.g. `DirectionalOrders::directions`.
+ * @param view_direction - Unit direction to match.
+ * @return Index of the direction with the smallest angle to
+ * `view_direction`.
+ */
+SPLAT_EXPORT_API uint32_t find_nearest_direction(
+    std::span<const Float3> directions, const Float3& view_direction);
+
+/**
+ * Sorter for distant assets, which uses precomputed orders (see
+ * `import::build_directional_orders`) in place of a per-frame sort: when the
+ * asset's angular radius is at most `max_angular_radius`, the order of the
+ * direction nearest to that from the camera to the asset's center is used.
+ * It is only decoded when that direction changes, so most frames cost
+ * nothing.
+ *
+ * Splats aren't culled; `render_splat.vs.hlsl` culls them individually, so all
+ * entries of `get_sorted` are drawn.
+ */
+class DirectionalSorter {
+ public:
+  /**
+   * Updates the order for a new view.
+   *
+   * @param orders - Orders of the asset. Must be the same as the previous
+   * call, or `reset` must be called in between.
+   * @param params - Camera and threshold.
+   * @return How the order was produced. On `NotApplicable`, `get_sorted` is
+   * left as is, and the caller should sort the asset itself, e.g. with
+   * `SplatSorter`.
+   */
+  SPLAT_EXPORT_API DirectionalSortResult
+  sort(const import::DirectionalOrders& orders,
+       const DirectionalSortParams& params);
+
+  /**
+   * Discards the current order, so that the next call to `sort` decodes one.
+   */
+  SPLAT_EXPORT_API void reset();
+
+  /**
+   * @return (index, distance) pairs, laid out as the `Buffer<uint2>` read by
+   * `render_splat.vs.hlsl`, back-to-front (or front-to-back). Distances are
+   * the position of each splat in the order, so ascend like sort keys.
+   */
+  std::span<const SortedSplat> get_sorted() const { return order; }
+
+  /**
+   * @return Index of the direction of `get_sorted`, or `UINT32_MAX` if none.
+   */
+  uint32_t get_direction() const { return direction; }
+
+ private:
+  std::vector<uint32_t> indices;
+  std::vector<SortedSplat> order;
+  uint32_t direction = UINT32_MAX;
+  bool front_to_back = false;
+};
+}  // namespace render
\ No newline at end of file
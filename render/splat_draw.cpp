@@ -0,0 +1,77 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_draw.h"
+
+#include <algorithm>
+
+namespace render {
+static_assert(quads_per_instance * vertices_per_quad <= 1 << 16,
+              "Quad vertices must be addressable by 16-bit indices");
+
+std::vector<uint16_t> generate_quad_indices() {
+  constexpr uint16_t quad_indices[indices_per_quad] = {0, 1, 2, 1, 2, 3};
+
+  std::vector<uint16_t> indices(quads_per_instance * indices_per_quad);
+  for (uint32_t quad = 0; quad < quads_per_instance; ++quad) {
+    for (uint32_t i = 0; i < indices_per_quad; ++i) {
+      indices[quad * indices_per_quad + i] =
+          static_cast<uint16_t>(quad * vertices_per_quad + quad_indices[i]);
+    }
+  }
+  return indices;
+}
+
+SplatDrawCall get_draw_call(SplatDrawMode mode, uint32_t num_splats) {
+  SplatDrawCall draw_call;
+  if (mode == SplatDrawMode::IndexedQuads) {
+    draw_call.is_indexed = true;
+    draw_call.count_per_instance = quads_per_instance * indices_per_quad;
+    draw_call.instance_count =
+        (num_splats + quads_per_instance - 1) / quads_per_instance;
+  } else {
+    draw_call.count_per_instance = num_splats * vertices_per_splat;
+    draw_call.instance_count = num_splats != 0 ? 1 : 0;
+  }
+  return draw_call;
+}
+
+std::vector<SplatDrawCall> get_batched_draw_calls(SplatDrawMode mode,
+                                                  uint32_t num_splats,
+                                                  uint32_t splats_per_batch) {
+  splats_per_batch = std::max(splats_per_batch, 1u);
+  if (mode == SplatDrawMode::IndexedQuads) {
+    splats_per_batch = (splats_per_batch + quads_per_instance - 1) /
+                       quads_per_instance * quads_per_instance;
+  }
+
+  std::vector<SplatDrawCall> draw_calls;
+  for (uint32_t first = 0; first < num_splats; first += splats_per_batch) {
+    SplatDrawCall draw_call =
+        get_draw_call(mode, std::min(splats_per_batch, num_splats - first));
+    draw_call.first_splat = first;
+    draw_calls.push_back(draw_call);
+  }
+  return draw_calls;
+}
+
+SplatBlendState get_blend_state(SplatBlendMode mode, uint32_t render_target) {
+  if (mode == SplatBlendMode::WeightedOIT) {
+    // Accumulation is additive, revealage multiplies by 1 - alpha.
+    if (render_target == 1) {
+      return SplatBlendState{BlendFactor::Zero, BlendFactor::OneMinusSrcColor,
+                             BlendFactor::Zero, BlendFactor::OneMinusSrcAlpha};
+    }
+    return SplatBlendState{BlendFactor::One, BlendFactor::One,
+                           BlendFactor::One, BlendFactor::One};
+  }
+  if (mode == SplatBlendMode::FrontToBack) {
+    return SplatBlendState{
+        BlendFactor::OneMinusDstAlpha, BlendFactor::One,
+        BlendFactor::OneMinusDstAlpha, BlendFactor::One};
+  }
+  return SplatBlendState{BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha,
+                         BlendFactor::One, BlendFactor::OneMinusSrcAlpha};
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,166 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "render/splat_constants.h"
+
+namespace render {
+/**
+ * How `render_splat.vs.hlsl` is drawn. Must match how it was compiled.
+ */
+enum class SplatDrawMode : uint32_t {
+  /**
+   * 6 non-indexed vertices per splat. Each vertex repeats the index fetch,
+   * unpacking, projection and frustum test of its splat.
+   */
+  Triangles,
+  /**
+   * Compiled with `INDEXED_QUADS`: 4 unique vertices per splat, drawn with the
+   * index buffer of `generate_quad_indices`, instanced to cover all splats.
+   * The post-transform cache shares the 2 corners on each quad's diagonal, so
+   * this saves about a third of vertex shader invocations.
+   */
+  IndexedQuads,
+};
+
+/**
+ * Order in which splats are sorted and blended. Must match how the shaders
+ * were compiled. See `FRONT_TO_BACK` in `constants.hlsl`.
+ */
+enum class SplatBlendMode : uint32_t {
+  /**
+   * Back-to-front, with the over operator.
+   */
+  BackToFront,
+  /**
+   * Compiled with `FRONT_TO_BACK`: front-to-back, with the under operator on
+   * premultiplied colors. Pixels can be skipped once saturated.
+   *
+   * Splats are drawn into their own target, cleared to 0 (alpha included),
+   * then composited over the scene by `resolve_front_to_back.ps.hlsl`.
+   */
+  FrontToBack,
+  /**
+   * Compiled with `WEIGHTED_OIT`: unsorted, with weighted blended
+   * order-independent transparency into an accumulation (RGBA16F) and a
+   * revealage (R8 or R16F) target, then composited over the scene by
+   * `resolve_weighted_oit.ps.hlsl`. Approximate where splats overlap, but
+   * skips the sort, e.g. for distant or background assets.
+   *
+   * Selectable per asset: draw and resolve these assets before sorted ones,
+   * which are then blended over them.
+   */
+  WeightedOIT,
+};
+
+/**
+ * Blend factor, as in graphics APIs.
+ */
+enum class BlendFactor : uint32_t {
+  Zero,
+  One,
+  SrcAlpha,
+  OneMinusSrcColor,
+  OneMinusSrcAlpha,
+  OneMinusDstAlpha,
+};
+
+/**
+ * Blend state of splat draws, with an add blend op throughout:
+ * dst = src * src_factor + dst * dst_factor.
+ */
+struct SplatBlendState {
+  BlendFactor src_color = BlendFactor::One;
+  BlendFactor dst_color = BlendFactor::Zero;
+  BlendFactor src_alpha = BlendFactor::One;
+  BlendFactor dst_alpha = BlendFactor::Zero;
+};
+
+/**
+ * Arguments of the draw call for a number of splats.
+ */
+struct SplatDrawCall {
+  /**
+   * Whether to bind the index buffer of `generate_quad_indices`, and draw
+   * indexed.
+   */
+  bool is_indexed = false;
+  /**
+   * Vertices (or indices, if indexed) per instance.
+   */
+  uint32_t count_per_instance = 0;
+  uint32_t instance_count = 0;
+  /**
+   * Sorted index of the first splat drawn, the `first_splat` constant of
+   * `BATCHED_DRAW`.
+   */
+  uint32_t first_splat = 0;
+};
+
+/**
+ * Builds the static index buffer of `SplatDrawMode::IndexedQuads` draws: two
+ * triangles (0 1 2, 1 2 3) per quad, in the corner order of
+ * `render_splat.vs.hlsl`, for `quads_per_instance` quads.
+ *
+ * The buffer is the same for every asset, so only needs creating once.
+ *
+ * @return 16-bit indices.
+ */
+SPLAT_EXPORT_API std::vector<uint16_t> generate_quad_indices();
+
+/**
+ * @param mode - How the vertex shader was compiled.
+ * @param num_splats - Number of (sorted) splats to draw. With
+ * `IndexedQuads`, this must also be the shader's `num_splats`, as the last
+ * instance is only partially filled.
+ * @return Arguments of the draw call.
+ */
+SPLAT_EXPORT_API SplatDrawCall get_draw_call(SplatDrawMode mode,
+                                             uint32_t num_splats);
+
+/**
+ * Splits drawing into batches, for `BATCHED_DRAW`, e.g. to run
+ * `saturation_mask.ps.hlsl` between them.
+ *
+ * Fewer, larger batches cost fewer saturation passes, while smaller ones stop
+ * shading saturated pixels sooner.
+ *
+ * Batches are split on the CPU, so `num_splats` must be known there:
+ * `BATCHED_DRAW` can't be combined with `WITH_COMPACTION`, whose count stays
+ * on the GPU.
+ *
+ * @param mode - How the vertex shader was compiled.
+ * @param num_splats - Number of (sorted) splats to draw.
+ * @param splats_per_batch - Approximate batch size. With `IndexedQuads`,
+ * rounded up to whole instances, so that no splat is drawn twice.
+ * @return Arguments of each draw call, in order.
+ */
+SPLAT_EXPORT_API std::vector<SplatDrawCall> get_batched_draw_calls(
+    SplatDrawMode mode, uint32_t num_splats, uint32_t splats_per_batch);
+
+/**
+ * @param mode - Blend mode the shaders were compiled for.
+ * @param render_target - Index of the render target. With `WeightedOIT`, 0 is
+ * the accumulation target, and 1 the revealage one, which must be cleared to
+ * 1. Other modes only draw to 0, which with `FrontToBack` must be a separate
+ * target cleared to 0, not the scene's.
+ * @return Blend state to draw splats with. `resolve_weighted_oit.ps.hlsl` and
+ * `resolve_front_to_back.ps.hlsl` are drawn with that of `BackToFront`.
+ */
+SPLAT_EXPORT_API SplatBlendState get_blend_state(SplatBlendMode mode,
+                                                 uint32_t render_target = 0);
+
+/**
+ * @param mode - Blend mode of an asset.
+ * @return Whether its splats must be sorted (i.e. submitted to a sorter)
+ * before drawing.
+ */
+inline bool is_sorted(SplatBlendMode mode) {
+  return mode != SplatBlendMode::WeightedOIT;
+}
+}  // namespace render
\ No newline at end of file
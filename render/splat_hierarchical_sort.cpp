@@ -0,0 +1,243 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_hierarchical_sort.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+using import::TraceStage;
+
+/**
+ * Minimum number of chunks per task.
+ */
+constexpr size_t min_chunks_per_task = 1 << 7;
+
+constexpr uint32_t radix_bits = 8;
+constexpr uint32_t radix_size = 1 << radix_bits;
+constexpr uint32_t radix_mask = radix_size - 1;
+
+/**
+ * @return Radix passes needed to sort keys in [min_key, max_key].
+ */
+inline uint32_t get_num_passes(uint32_t min_key, uint32_t max_key) {
+  return (std::bit_width(max_key - min_key) + radix_bits - 1) / radix_bits;
+}
+
+/**
+ * Stable LSD radix sort of a small cluster, by key relative to `min_key`, on
+ * the calling thread.
+ *
+ * @return Number of passes taken.
+ */
+uint32_t sort_cluster(std::span<SortedSplat> splats, uint32_t min_key,
+                      uint32_t max_key, std::vector<SortedSplat>& scratch) {
+  uint32_t num_passes = get_num_passes(min_key, max_key);
+  scratch.resize(splats.size());
+  SortedSplat* src = splats.data();
+  SortedSplat* dst = scratch.data();
+  uint32_t offsets[radix_size];
+  for (uint32_t pass = 0; pass < num_passes; ++pass) {
+    uint32_t shift = pass * radix_bits;
+    std::fill(offsets, offsets + radix_size, 0);
+    for (size_t i = 0; i < splats.size(); ++i) {
+      ++offsets[((src[i].distance - min_key) >> shift) & radix_mask];
+    }
+    uint32_t offset = 0;
+    for (uint32_t& count : offsets) {
+      uint32_t bucket_offset = offset;
+      offset += count;
+      count = bucket_offset;
+    }
+    for (size_t i = 0; i < splats.size(); ++i) {
+      uint32_t digit = ((src[i].distance - min_key) >> shift) & radix_mask;
+      dst[offsets[digit]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != splats.data()) {
+    std::copy(src, src + splats.size(), splats.data());
+  }
+  return num_passes;
+}
+}  // namespace
+
+uint32_t HierarchicalSorter::sort(std::span<const uint32_t> positions,
+                                  std::span<const import::SplatChunk> chunks,
+                                  const DistanceParams& params,
+                                  float bounds_scale,
+                                  std::span<SortedSplat> sorted) {
+  SPLAT_TRACE_STAGE(TraceStage::HierarchicalSort);
+  stats = HierarchicalSortStats();
+  stats.num_chunks = static_cast<uint32_t>(chunks.size());
+  uint32_t not_visible = get_distance_not_visible(params);
+
+  // Chunks of visible ranges, in order.
+  cull_chunks(chunks, params, bounds_scale, ranges);
+  chunk_keys.clear();
+  size_t range = 0;
+  for (uint32_t c = 0; c < chunks.size(); ++c) {
+    const import::SplatChunk& chunk = chunks[c];
+    while (range < ranges.size() &&
+           ranges[range].first_splat + ranges[range].num_splats <=
+               chunk.first_splat) {
+      ++range;
+    }
+    if (range < ranges.size() &&
+        ranges[range].first_splat <= chunk.first_splat) {
+      chunk_keys.push_back({0, 0, c, 0});
+      stats.num_keyed += chunk.num_splats;
+    }
+  }
+
+  // Keys of their splats, and the range of those of visible ones.
+  distances.resize(positions.size());
+  import::parallel_for(
+      chunk_keys.size(), min_chunks_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          ChunkKeys& keys = chunk_keys[i];
+          const import::SplatChunk& chunk = chunks[keys.chunk];
+          std::span<uint32_t> chunk_distances(
+              distances.data() + chunk.first_splat, chunk.num_splats);
+          compute_distances_batch(
+              positions.subspan(chunk.first_splat, chunk.num_splats), params,
+              chunk_distances);
+          keys.min_key = not_visible;
+          keys.max_key = 0;
+          for (uint32_t key : chunk_distances) {
+            if (key != not_visible) {
+              keys.min_key = std::min(keys.min_key, key);
+              keys.max_key = std::max(keys.max_key, key);
+              ++keys.num_visible;
+            }
+          }
+        }
+      });
+  std::erase_if(chunk_keys,
+                [](const ChunkKeys& keys) { return keys.num_visible == 0; });
+  stats.num_visible_chunks = static_cast<uint32_t>(chunk_keys.size());
+
+  // Clusters of chunks whose ranges overlap. Ranges which only share their
+  // end keys don't, as splats sort equally either way.
+  std::sort(chunk_keys.begin(), chunk_keys.end(),
+            [](const ChunkKeys& a, const ChunkKeys& b) {
+              return a.min_key != b.min_key ? a.min_key < b.min_key
+                                            : a.chunk < b.chunk;
+            });
+  clusters.clear();
+  uint32_t num_visible = 0;
+  for (uint32_t i = 0; i < chunk_keys.size(); ++i) {
+    const ChunkKeys& keys = chunk_keys[i];
+    if (clusters.empty() || keys.min_key >= clusters.back().max_key) {
+      clusters.push_back({i, 0, keys.min_key, keys.max_key, 0, num_visible});
+    }
+    Cluster& cluster = clusters.back();
+    ++cluster.num_chunks;
+    cluster.max_key = std::max(cluster.max_key, keys.max_key);
+    cluster.num_visible += keys.num_visible;
+    num_visible += keys.num_visible;
+  }
+  stats.num_clusters = static_cast<uint32_t>(clusters.size());
+
+  /**
+   * Calls `fn(index, key)` for the visible splats of `cluster`, in chunk
+   * order.
+   */
+  auto for_each_visible = [&](const Cluster& cluster, auto&& fn) {
+    for (uint32_t i = 0; i < cluster.num_chunks; ++i) {
+      const import::SplatChunk& chunk =
+          chunks[chunk_keys[cluster.first_chunk + i].chunk];
+      for (uint32_t j = chunk.first_splat;
+           j < chunk.first_splat + chunk.num_splats; ++j) {
+        if (distances[j] != not_visible) {
+          fn(j, distances[j]);
+        }
+      }
+    }
+  };
+
+  // Small clusters, sorted in parallel with each other.
+  uint32_t num_tasks = import::get_num_ranges(clusters.size(), 1);
+  task_scattered.assign(num_tasks, 0);
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    std::vector<SortedSplat> scratch;
+    for (size_t c = clusters.size() * task / num_tasks,
+                end = clusters.size() * (task + 1) / num_tasks;
+         c < end; ++c) {
+      const Cluster& cluster = clusters[c];
+      if (cluster.num_visible >= min_splats_per_task) {
+        continue;
+      }
+      SortedSplat* out = &sorted[cluster.offset];
+      for_each_visible(cluster, [&](uint32_t index, uint32_t key) {
+        *out++ = {index, key};
+      });
+      uint32_t num_passes =
+          sort_cluster(sorted.subspan(cluster.offset, cluster.num_visible),
+                       cluster.min_key, cluster.max_key, scratch);
+      task_scattered[task] += uint64_t{cluster.num_visible} * num_passes;
+    }
+  });
+  for (uint64_t num_scattered : task_scattered) {
+    stats.num_scattered += num_scattered;
+  }
+
+  // Large clusters, each sorted in parallel, by keys relative to their
+  // smallest.
+  for (const Cluster& cluster : clusters) {
+    stats.max_cluster_splats =
+        std::max(stats.max_cluster_splats, cluster.num_visible);
+    if (cluster.num_visible < min_splats_per_task) {
+      continue;
+    }
+    cluster_keys.resize(cluster.num_visible);
+    cluster_indices.resize(cluster.num_visible);
+    uint32_t num_gathered = 0;
+    for_each_visible(cluster, [&](uint32_t index, uint32_t key) {
+      cluster_keys[num_gathered] = key - cluster.min_key;
+      cluster_indices[num_gathered++] = index;
+    });
+    std::span<SortedSplat> cluster_sorted =
+        sorted.subspan(cluster.offset, cluster.num_visible);
+    uint32_t num_passes =
+        std::max(get_num_passes(cluster.min_key, cluster.max_key), 1u);
+    // Untraced, as the passes are counted in this stage.
+    sorter.sort_keys(cluster_keys, cluster_sorted, num_passes * radix_bits,
+                     not_visible);
+    import::parallel_for(
+        cluster.num_visible, min_splats_per_task,
+        [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            SortedSplat& splat = cluster_sorted[i];
+            splat = {cluster_indices[splat.index],
+                     splat.distance + cluster.min_key};
+          }
+        });
+    stats.num_scattered += uint64_t{cluster.num_visible} * num_passes;
+  }
+
+  // `SplatSorter` also skips passes over digits all keys share.
+  if (!clusters.empty()) {
+    uint32_t num_flat_passes =
+        (std::bit_width(clusters.front().min_key ^ clusters.back().max_key) +
+         radix_bits - 1) /
+        radix_bits;
+    stats.num_flat_scattered =
+        uint64_t{std::max(num_flat_passes, 1u) - 1} * num_visible;
+  }
+  stats.num_flat_scattered += positions.size();
+  SPLAT_TRACE_COUNT(TraceStage::HierarchicalSort,
+                    stats.num_keyed * (sizeof(uint32_t) * 2) +
+                        stats.num_scattered * 2 * sizeof(SortedSplat),
+                    positions.size());
+  return num_visible;
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "import/splat_chunks.h"
+#include "render/splat_chunk_culling.h"
+#include "render/splat_sort.h"
+
+namespace render {
+/**
+ * Work done by the last call to `HierarchicalSorter::sort`, next to that of
+ * `SplatSorter::sort` over the same splats.
+ */
+struct HierarchicalSortStats {
+  uint32_t num_chunks = 0;
+  /**
+   * Chunks left by `cull_chunks`, and holding visible splats.
+   */
+  uint32_t num_visible_chunks = 0;
+  /**
+   * Runs of visible chunks with overlapping key ranges, each sorted on its
+   * own.
+   */
+  uint32_t num_clusters = 0;
+  /**
+   * Splats of the largest cluster.
+   */
+  uint32_t max_cluster_splats = 0;
+  /**
+   * Splats whose keys were computed, i.e. those of visible chunks.
+   * `SplatSorter` computes all of them.
+   */
+  uint64_t num_keyed = 0;
+  /**
+   * Splats moved by radix passes, summed over passes. Each cluster only takes
+   * passes over the digits its keys differ in.
+   */
+  uint64_t num_scattered = 0;
+  /**
+   * Estimate of the splats `SplatSorter` would move for the same view: all of
+   * them in its first pass, then visible ones in each further pass up to the
+   * highest bit the visible keys differ in. `SplatSorter` may skip more, as it
+   * also skips lower digits that happen to be shared by all keys.
+   */
+  uint64_t num_flat_scattered = 0;
+};
+
+/**
+ * Two-level sort over chunks (see `import::build_chunks`): rather than radix
+ * sorting all splats at once, chunks are culled with `cull_chunks`, keys are
+ * computed for the splats of the rest, and chunks are ordered by the range of
+ * keys of their visible splats. Chunks whose ranges overlap form clusters,
+ * and each cluster's splats are sorted on their own, over only the key digits
+ * they differ in; clusters are then concatenated in order. Distant chunks
+ * rarely overlap, and span few keys, so in open scenes, most clusters are one
+ * chunk taking one pass, while splats of culled chunks are never touched.
+ * This relies on chunks being compact: one spanning two distant objects
+ * would join every cluster between them, which `build_chunks` avoids with
+ * `ChunkSettings::max_span_scales`. In dense scenes, where most visible
+ * splats form a single cluster, gathering it costs more than a flat sort.
+ *
+ * Output matches `SplatSorter` over the visible splats, up to the order of
+ * splats with equal keys. Clusters are sorted in parallel, and clusters too
+ * large for a single task are sorted by a parallel `SplatSorter`.
+ *
+ * Scratch memory is retained between calls; keep one sorter per asset.
+ */
+class HierarchicalSorter {
+ public:
+  /**
+   * Computes keys for, and sorts, the splats of visible chunks.
+   *
+   * @param positions - Packed x11y11z10 positions, in chunk order (see
+   * `import::SplatChunks::order`).
+   * @param chunks - Chunks of `positions`.
+   * @param params - View and unpacking constants.
+   * @param bounds_scale - Scale from the units of chunk bounds to local space
+   * (see `cull_chunks`).
+   * @param sorted - Output (index, distance) pairs, of the same size as
+   * `positions`. Only visible splats are written, so entries past the
+   * returned count are left as is.
+   * @return Number of visible splats, i.e. the number of leading entries of
+   * `sorted` that need to be drawn.
+   */
+  SPLAT_EXPORT_API uint32_t sort(std::span<const uint32_t> positions,
+                                 std::span<const import::SplatChunk> chunks,
+                                 const DistanceParams& params,
+                                 float bounds_scale,
+                                 std::span<SortedSplat> sorted);
+
+  /**
+   * @return Statistics of the last call to `sort`.
+   */
+  const HierarchicalSortStats& get_stats() const { return stats; }
+
+ private:
+  /**
+   * Chunk holding visible splats, with the range of their keys.
+   */
+  struct ChunkKeys {
+    uint32_t min_key;
+    uint32_t max_key;
+    uint32_t chunk;
+    uint32_t num_visible;
+  };
+  struct Cluster {
+    uint32_t first_chunk;
+    uint32_t num_chunks;
+    uint32_t min_key;
+    uint32_t max_key;
+    uint32_t num_visible;
+    /**
+     * Of the cluster's first splat in the output.
+     */
+    uint32_t offset;
+  };
+
+  SplatSorter sorter;
+  std::vector<ChunkRange> ranges;
+  std::vector<ChunkKeys> chunk_keys;
+  std::vector<Cluster> clusters;
+  std::vector<uint32_t> distances;
+  std::vector<uint64_t> task_scattered;
+  std::vector<uint32_t> cluster_keys;
+  std::vector<uint32_t> cluster_indices;
+  HierarchicalSortStats stats;
+};
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,333 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_incremental_sort.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+using import::TraceStage;
+
+/**
+ * Number of positions gathered at a time, so keys can be computed with SIMD.
+ */
+constexpr size_t gather_batch_size = 256;
+
+inline bool is_less(const SortedSplat& a, const SortedSplat& b) {
+  return a.distance < b.distance;
+}
+
+/**
+ * Finds how many of the first `output` splats of a merge of sequences `a` and
+ * `b` come from `a`, when equal keys are taken from `a` first.
+ *
+ * @param get_a - Returns the key of the `i`th splat of `a`.
+ * @param get_b - Returns the key of the `j`th splat of `b`.
+ */
+template <typename GetA, typename GetB>
+size_t get_merge_split(size_t a_size, size_t b_size, size_t output,
+                       const GetA& get_a, const GetB& get_b) {
+  size_t low = output > b_size ? output - b_size : 0;
+  size_t high = std::min(output, a_size);
+  while (low < high) {
+    size_t i = (low + high) / 2;
+    size_t j = output - i;
+    if (j > 0 && get_b(j - 1) >= get_a(i)) {
+      low = i + 1;
+    } else {
+      high = i;
+    }
+  }
+  return low;
+}
+}  // namespace
+
+void IncrementalSorter::sample_motion(std::span<const uint32_t> positions,
+                                      const DistanceParams& params) {
+  size_t num_splats = positions.size();
+  stats.max_key_delta = UINT32_MAX;
+  stats.sampled_descent_ratio = 1.f;
+  if (order.size() != num_splats || num_splats < 2) {
+    return;
+  }
+
+  // Samples are adjacent pairs of the previous order, so that they estimate
+  // both how far keys moved, and how many pairs are now out of order.
+  size_t num_samples = std::clamp<size_t>(settings.num_motion_samples, 1,
+                                          num_splats - 1);
+  std::vector<uint32_t> sample_positions(2 * num_samples);
+  std::vector<uint32_t> sample_distances(2 * num_samples);
+  auto get_sample_index = [&](size_t sample) {
+    return (num_splats - 1) * sample / num_samples;
+  };
+
+  for (size_t sample = 0; sample < num_samples; ++sample) {
+    size_t i = get_sample_index(sample);
+    sample_positions[2 * sample] = positions[order[i].index];
+    sample_positions[2 * sample + 1] = positions[order[i + 1].index];
+  }
+  compute_distances_batch(sample_positions, params, sample_distances);
+
+  uint32_t not_visible = get_distance_not_visible(params);
+  uint32_t max_key_delta = 0;
+  size_t num_descents = 0;
+  for (size_t sample = 0; sample < num_samples; ++sample) {
+    uint32_t previous = order[get_sample_index(sample)].distance;
+    uint32_t current = sample_distances[2 * sample];
+    if ((previous == not_visible) != (current == not_visible)) {
+      max_key_delta = UINT32_MAX;
+    } else {
+      max_key_delta = std::max(max_key_delta, current > previous
+                                                  ? current - previous
+                                                  : previous - current);
+    }
+    num_descents += sample_distances[2 * sample + 1] < current;
+  }
+
+  stats.max_key_delta = max_key_delta;
+  stats.sampled_descent_ratio =
+      static_cast<float>(num_descents) / static_cast<float>(num_samples);
+}
+
+bool IncrementalSorter::repair(std::span<const uint32_t> positions,
+                               const DistanceParams& params) {
+  SPLAT_TRACE_STAGE(TraceStage::Resort);
+
+  size_t num_splats = order.size();
+  size_t max_displaced =
+      static_cast<size_t>(settings.max_displaced_ratio * num_splats);
+  uint32_t not_visible = get_distance_not_visible(params);
+
+  // After a full sort, positions have to be gathered by index once. From then
+  // on, they're kept in order, so repairs only stream through memory.
+  bool has_order_positions = order_positions.size() == num_splats;
+  order_positions.resize(num_splats);
+
+  struct TaskRange {
+    size_t begin = 0;
+    size_t end = 0;
+    size_t num_visible = 0;
+    std::vector<OrderedSplat> displaced;
+  };
+  uint32_t num_tasks = import::get_num_ranges(num_splats, min_splats_per_task);
+  std::vector<TaskRange> ranges(num_tasks);
+  auto get_begin = [&](uint32_t task) {
+    return num_splats * task / num_tasks;
+  };
+
+  // Compute keys in the previous order. Whenever a splat is below the last one
+  // kept, both are displaced, so that kept splats remain sorted. Each descent
+  // displaces at most two splats. Kept splats are compacted in place.
+  SortedSplat* splats = order.data();
+  uint32_t* splat_positions = order_positions.data();
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    SPLAT_TRACE_SCOPE("compute_ordered_distances");
+    TaskRange& range = ranges[task];
+    range.begin = get_begin(task);
+    size_t end = range.begin;
+    size_t num_visible = 0;
+    uint32_t last_distance = 0;
+    uint32_t batch_positions[gather_batch_size];
+    uint32_t batch_distances[gather_batch_size];
+    for (size_t batch = range.begin, task_end = get_begin(task + 1);
+         batch < task_end && range.displaced.size() <= max_displaced;
+         batch += gather_batch_size) {
+      size_t batch_size = std::min(gather_batch_size, task_end - batch);
+      for (size_t i = 0; i < batch_size; ++i) {
+        batch_positions[i] = has_order_positions
+                                 ? splat_positions[batch + i]
+                                 : positions[splats[batch + i].index];
+      }
+      compute_distances_batch({batch_positions, batch_size}, params,
+                              {batch_distances, batch_size});
+
+      for (size_t i = 0; i < batch_size; ++i) {
+        SortedSplat splat{splats[batch + i].index, batch_distances[i]};
+        num_visible += splat.distance != not_visible;
+        if (end != range.begin && splat.distance < last_distance) {
+          --end;
+          range.displaced.push_back({splats[end], splat_positions[end]});
+          range.displaced.push_back({splat, batch_positions[i]});
+          last_distance = end != range.begin ? splats[end - 1].distance : 0;
+        } else {
+          splats[end] = splat;
+          splat_positions[end] = batch_positions[i];
+          last_distance = splat.distance;
+          ++end;
+        }
+      }
+    }
+    range.end = end;
+    range.num_visible = num_visible;
+  });
+
+  // Apply the same rule across task boundaries.
+  displaced.clear();
+  for (uint32_t task = 1, previous = 0; task < num_tasks; ++task) {
+    TaskRange& range = ranges[task];
+    while (range.begin != range.end) {
+      while (previous > 0 && ranges[previous].begin == ranges[previous].end) {
+        --previous;
+      }
+      TaskRange& previous_range = ranges[previous];
+      if (previous_range.begin == previous_range.end ||
+          !is_less(order[range.begin], order[previous_range.end - 1])) {
+        break;
+      }
+      --previous_range.end;
+      displaced.push_back(
+          {order[previous_range.end], order_positions[previous_range.end]});
+      displaced.push_back({order[range.begin], order_positions[range.begin]});
+      ++range.begin;
+    }
+    previous = task;
+  }
+
+  size_t num_kept = 0;
+  num_visible = 0;
+  for (const TaskRange& range : ranges) {
+    num_kept += range.end - range.begin;
+    num_visible += static_cast<uint32_t>(range.num_visible);
+  }
+  stats.num_displaced = num_splats - num_kept;
+  if (stats.num_displaced > max_displaced) {
+    return false;
+  }
+  SPLAT_TRACE_COUNT(TraceStage::Resort,
+                    num_splats * (sizeof(uint32_t) + sizeof(OrderedSplat)),
+                    num_splats);
+  if (stats.num_displaced == 0) {
+    stats.result = IncrementalSortResult::Unchanged;
+    return true;
+  }
+  stats.result = IncrementalSortResult::Repaired;
+
+  {
+    SPLAT_TRACE_SCOPE("sort_displaced");
+    for (const TaskRange& range : ranges) {
+      displaced.insert(displaced.end(), range.displaced.begin(),
+                       range.displaced.end());
+    }
+    std::stable_sort(displaced.begin(), displaced.end(),
+                     [](const OrderedSplat& a, const OrderedSplat& b) {
+                       return is_less(a.splat, b.splat);
+                     });
+  }
+
+  // Kept splats are left in place, as one sorted sequence spread over the
+  // task ranges. Index `i` of that sequence lives in the range `r` for which
+  // kept_offsets[r] <= i < kept_offsets[r + 1].
+  std::vector<size_t> kept_offsets(num_tasks + 1);
+  for (uint32_t task = 0; task < num_tasks; ++task) {
+    kept_offsets[task + 1] =
+        kept_offsets[task] + ranges[task].end - ranges[task].begin;
+  }
+  auto get_kept_range = [&](size_t i) {
+    return static_cast<uint32_t>(std::upper_bound(kept_offsets.begin(),
+                                                  kept_offsets.end(), i) -
+                                 kept_offsets.begin() - 1);
+  };
+  auto get_kept_distance = [&](size_t i) {
+    uint32_t range = get_kept_range(i);
+    return order[ranges[range].begin + i - kept_offsets[range]].distance;
+  };
+  auto get_displaced_distance = [&](size_t j) {
+    return displaced[j].splat.distance;
+  };
+
+  // Each task merges an equal share of the output, into the back buffers.
+  next_order.resize(num_splats);
+  next_order_positions.resize(num_splats);
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    SPLAT_TRACE_SCOPE("merge_displaced");
+    size_t begin = get_begin(task);
+    size_t end = get_begin(task + 1);
+    size_t kept_index =
+        get_merge_split(num_kept, displaced.size(), begin, get_kept_distance,
+                        get_displaced_distance);
+    size_t kept_end =
+        get_merge_split(num_kept, displaced.size(), end, get_kept_distance,
+                        get_displaced_distance);
+    size_t displaced_index = begin - kept_index;
+    size_t displaced_end = end - kept_end;
+
+    uint32_t range = kept_index < num_kept ? get_kept_range(kept_index) : 0;
+    size_t kept_i = ranges[range].begin + kept_index - kept_offsets[range];
+    for (size_t i = begin; i < end; ++i) {
+      // Equal keys are taken from kept splats first, as in `get_merge_split`.
+      if (kept_index != kept_end &&
+          (displaced_index == displaced_end ||
+           !is_less(displaced[displaced_index].splat, order[kept_i]))) {
+        next_order[i] = order[kept_i];
+        next_order_positions[i] = order_positions[kept_i];
+        ++kept_index;
+        ++kept_i;
+        while (kept_i == ranges[range].end && range + 1 < num_tasks) {
+          kept_i = ranges[++range].begin;
+        }
+      } else {
+        next_order[i] = displaced[displaced_index].splat;
+        next_order_positions[i] = displaced[displaced_index].position;
+        ++displaced_index;
+      }
+    }
+  });
+
+  std::swap(order, next_order);
+  std::swap(order_positions, next_order_positions);
+  return true;
+}
+
+uint32_t IncrementalSorter::sort(std::span<const uint32_t> positions,
+                                 const DistanceParams& params) {
+  size_t num_splats = positions.size();
+  stats = IncrementalSortStats();
+
+  // Keys of different encodings can't be compared.
+  if (params.encoding != encoding || params.precision != precision ||
+      params.distance_near_cm != distance_near_cm ||
+      params.distance_far_cm != distance_far_cm ||
+      params.front_to_back != front_to_back) {
+    reset();
+    encoding = params.encoding;
+    precision = params.precision;
+    distance_near_cm = params.distance_near_cm;
+    distance_far_cm = params.distance_far_cm;
+    front_to_back = params.front_to_back;
+  }
+  sample_motion(positions, params);
+
+  if (stats.max_key_delta <= settings.skip_threshold) {
+    stats.result = IncrementalSortResult::Skipped;
+    return num_visible;
+  }
+
+  // Skip straight to a full sort if the sample shows the order is too far gone,
+  // rather than paying for the repair first.
+  bool is_repaired =
+      order.size() == num_splats && num_splats != 0 &&
+      2.f * stats.sampled_descent_ratio <= settings.max_displaced_ratio &&
+      repair(positions, params);
+
+  if (!is_repaired) {
+    stats.result = IncrementalSortResult::Full;
+    order.resize(num_splats);
+    num_visible = sorter.sort(positions, params, order);
+    order_positions.clear();
+  }
+  return num_visible;
+}
+
+void IncrementalSorter::reset() {
+  order.clear();
+  order_positions.clear();
+  num_visible = 0;
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,181 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "render/splat_sort.h"
+
+namespace render {
+/**
+ * How the last call to `IncrementalSorter::sort` produced its order.
+ */
+enum class IncrementalSortResult : uint32_t {
+  /**
+   * Motion was below `skip_threshold`; the previous order was kept as-is,
+   * without recomputing keys or culling.
+   */
+  Skipped,
+  /**
+   * Keys were recomputed, and the previous order was still sorted.
+   */
+  Unchanged,
+  /**
+   * The previous order was repaired, by sorting the splats which broke it and
+   * merging them back in.
+   */
+  Repaired,
+  /**
+   * The previous order was too far from sorted; a full radix sort was run.
+   */
+  Full,
+};
+
+struct IncrementalSortSettings {
+  /**
+   * Largest change in sampled keys, in key units, for which sorting is skipped
+   * entirely. Changes accumulate over skipped frames, so the sampled keys
+   * never drift further than this from the order; other splats are only
+   * expected to, as camera motion changes keys smoothly.
+   *
+   * Most of the saving comes from skipped frames: a repair still recomputes
+   * every key, and only saves the radix passes. But skipped frames also keep
+   * the previous frame's culling, and only sampled splats are checked for
+   * changes in visibility, so splats crossing the edges of the frustum
+   * appear (or disappear) late, until motion exceeds the threshold.
+   *
+   * The default of 0 only skips frames whose sampled keys are unchanged, e.g.
+   * while the camera is still, so never culls late. One key unit, about the
+   * error key quantization already allows, skips most frames of slow camera
+   * motion; see `splat_incremental_sort` to measure both the saving and the
+   * splats culled late.
+   */
+  uint32_t skip_threshold = 0;
+
+  /**
+   * Number of adjacent pairs of the previous order sampled to estimate motion.
+   */
+  uint32_t num_motion_samples = 1024;
+
+  /**
+   * Max fraction of splats which may be displaced from the previous order
+   * before falling back to a full sort. Repair touches the order about twice
+   * as often as a radix pass, but only sorts displaced splats.
+   */
+  float max_displaced_ratio = 0.1f;
+};
+
+struct IncrementalSortStats {
+  IncrementalSortResult result = IncrementalSortResult::Full;
+  /**
+   * Largest change in sampled keys since the last sort. `UINT32_MAX` if any
+   * sample changed visibility, or if there was no previous order.
+   */
+  uint32_t max_key_delta = 0;
+  /**
+   * Fraction of sampled adjacent pairs of the previous order which are out of
+   * order under the new keys.
+   */
+  float sampled_descent_ratio = 0.f;
+  /**
+   * Splats removed from the previous order to leave it sorted, then merged
+   * back in. Only counted when repair was attempted.
+   */
+  uint64_t num_displaced = 0;
+};
+
+/**
+ * Sorter which exploits temporal coherence: between frames, the camera
+ * usually moves only slightly (e.g. head motion in VR), so the previous
+ * frame's order is nearly sorted under the new keys.
+ *
+ * Each frame:
+ * 1. A sample of keys is compared against those of the last sort. If none
+ *    moved by more than `skip_threshold`, the previous order is reused.
+ * 2. Otherwise, unless the sample shows too many descents (adjacent pairs
+ *    out of order), all keys are recomputed in the previous order.
+ * 3. A nearly sorted order is repaired: each descent displaces both of its
+ *    splats, leaving a sorted subsequence. The displaced splats are sorted on
+ *    their own, then merged back in, in parallel.
+ * 4. Large camera jumps fall back to the full radix sort of `SplatSorter`.
+ *
+ * Output matches `SplatSorter` as of the last frame that wasn't skipped:
+ * visible splats in ascending key order, followed by culled splats. Splats
+ * with equal keys are in no particular order: when repaired, those kept in
+ * place precede displaced ones.
+ */
+class IncrementalSorter {
+ public:
+  explicit IncrementalSorter(
+      const IncrementalSortSettings& settings = IncrementalSortSettings())
+      : settings(settings) {}
+
+  /**
+   * Updates the order for a new view.
+   *
+   * @param positions - Packed x11y11z10 positions. Must be the same splats as
+   * the previous call, or `reset` must be called in between.
+   * @param params - View and unpacking constants.
+   * @return Number of visible splats, i.e. the number of leading entries of
+   * `get_sorted` that need to be drawn.
+   */
+  SPLAT_EXPORT_API uint32_t sort(std::span<const uint32_t> positions,
+                                 const DistanceParams& params);
+
+  /**
+   * Discards the previous order, forcing the next call to `sort` to run a full
+   * sort. Also happens automatically when the key encoding changes.
+   */
+  SPLAT_EXPORT_API void reset();
+
+  /**
+   * @return (index, distance) pairs of the last call to `sort`, laid out as
+   * the `Buffer<uint2>` read by `render_splat.vs.hlsl`.
+   */
+  std::span<const SortedSplat> get_sorted() const { return order; }
+
+  /**
+   * @return Statistics of the last call to `sort`.
+   */
+  const IncrementalSortStats& get_stats() const { return stats; }
+
+  IncrementalSortSettings settings;
+
+ private:
+  struct OrderedSplat {
+    SortedSplat splat;
+    uint32_t position;
+  };
+
+  void sample_motion(std::span<const uint32_t> positions,
+                     const DistanceParams& params);
+  bool repair(std::span<const uint32_t> positions,
+              const DistanceParams& params);
+
+  SplatSorter sorter;
+  std::vector<SortedSplat> order;
+  /**
+   * Packed positions, in the same order as `order`. Empty after a full sort,
+   * until gathered by the next repair.
+   */
+  std::vector<uint32_t> order_positions;
+  std::vector<SortedSplat> next_order;
+  std::vector<uint32_t> next_order_positions;
+  std::vector<OrderedSplat> displaced;
+  uint32_t num_visible = 0;
+  IncrementalSortStats stats;
+
+  /**
+   * Key encoding of `order`.
+   */
+  DistanceEncoding encoding = DistanceEncoding::ClipDepth;
+  uint32_t precision = distance_precision;
+  float distance_near_cm = 0.f;
+  float distance_far_cm = 0.f;
+  bool front_to_back = false;
+};
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,87 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_lod.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "import/splat_tracing.h"
+
+namespace render {
+namespace {
+using import::TraceStage;
+
+/**
+ * Projected radius of a node, in pixels.
+ */
+inline float get_error_pixels(const import::LodNode& node,
+                              const Float3& position,
+                              const LodCutParams& params) {
+  float distance = length(position - params.camera_position) - node.radius;
+  return distance > 0.f ? node.radius * params.focal_length / distance
+                        : std::numeric_limits<float>::infinity();
+}
+}  // namespace
+
+LodCutStats select_lod_cut(std::span<const import::LodNode> nodes,
+                           std::span<const Float3> positions,
+                           const LodCutParams& params,
+                           std::vector<uint32_t>& indices) {
+  SPLAT_TRACE_STAGE(TraceStage::SelectLod);
+  indices.clear();
+  LodCutStats stats;
+  if (nodes.empty()) {
+    return stats;
+  }
+
+  // Max-heap of (error, node) of nodes to refine, given the budget.
+  std::vector<std::pair<float, uint32_t>> candidates;
+  size_t num_drawn = 1;
+  auto visit = [&](uint32_t node) {
+    ++stats.num_visited;
+    if (nodes[node].num_children == 0) {
+      indices.push_back(node);
+      return;
+    }
+    float error = get_error_pixels(nodes[node], positions[node], params);
+    if (!(error > params.max_error_pixels)) {
+      indices.push_back(node);
+      stats.max_error_pixels = std::max(stats.max_error_pixels, error);
+      return;
+    }
+    candidates.emplace_back(error, node);
+    std::push_heap(candidates.begin(), candidates.end());
+  };
+  visit(0);
+
+  // Refining adds at least one splat, as nodes have 2 or more children.
+  while (!candidates.empty() && num_drawn < params.max_splats) {
+    auto [error, node] = candidates.front();
+    std::pop_heap(candidates.begin(), candidates.end());
+    candidates.pop_back();
+
+    const import::LodNode& parent = nodes[node];
+    if (num_drawn - 1 + parent.num_children > params.max_splats) {
+      // Over budget. Smaller nodes may still fit.
+      indices.push_back(node);
+      stats.max_error_pixels = std::max(stats.max_error_pixels, error);
+      continue;
+    }
+    num_drawn += parent.num_children - 1;
+    for (uint32_t child = 0; child < parent.num_children; ++child) {
+      visit(parent.first_child + child);
+    }
+  }
+
+  for (const auto& [error, node] : candidates) {
+    indices.push_back(node);
+    stats.max_error_pixels = std::max(stats.max_error_pixels, error);
+  }
+  SPLAT_TRACE_COUNT(TraceStage::SelectLod,
+                    stats.num_visited * sizeof(import::LodNode),
+                    stats.num_visited);
+  return stats;
+}
+}  // namespace render
\ No newline at end of file
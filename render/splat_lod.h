@@ -0,0 +1,79 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "import/splat_lod.h"
+#include "render/splat_unpacking.h"
+
+namespace render {
+/**
+ * Constants of `select_lod_cut`.
+ */
+struct LodCutParams {
+  /**
+   * In the units of the LOD's positions (i.e. meters, in the importer's axes).
+   */
+  Float3 camera_position;
+  /**
+   * Focal length in pixels, i.e. half the viewport height over the tangent of
+   * half the vertical field of view.
+   */
+  float focal_length = 1.f;
+  /**
+   * Nodes whose bounds project to at most this radius, in pixels, aren't
+   * refined.
+   */
+  float max_error_pixels = 1.f;
+  /**
+   * Maximum number of splats in the cut. The root is always drawn.
+   */
+  uint32_t max_splats = std::numeric_limits<uint32_t>::max();
+};
+
+/**
+ * Result of `select_lod_cut`.
+ */
+struct LodCutStats {
+  /**
+   * Largest projected radius of a drawn node which has children, in pixels. 0
+   * if only leaves are drawn.
+   */
+  float max_error_pixels = 0.f;
+  /**
+   * Number of nodes visited.
+   */
+  uint64_t num_visited = 0;
+};
+
+/**
+ * Picks the nodes of a `SplatLod` to draw: a cut through its tree, such that
+ * each source splat is represented by exactly one drawn node.
+ *
+ * Starting from the root, the node with the largest projected radius
+ * (`LodNode::radius` over its distance from the camera) is repeatedly replaced
+ * by its children, until all nodes are within `max_error_pixels`, or the next
+ * refinement would exceed `max_splats`. A node's bounds contain its children's,
+ * so their projections are never larger, and the cut is refined best first.
+ * The camera being inside a node's bounds counts as infinite error.
+ *
+ * Takes O(n log n) time in the size of the cut, on the calling thread. Frustum
+ * culling is left to the sort.
+ *
+ * @param nodes - Nodes of the `SplatLod`.
+ * @param positions - Positions of the `SplatLod`.
+ * @param params - Camera and budget.
+ * @param indices - Output, nodes to draw, i.e. indices of splats of the
+ * `SplatLod`, e.g. for `SplatSorter::sort_subset`. Unordered.
+ * @return Statistics of the cut.
+ */
+SPLAT_EXPORT_API LodCutStats select_lod_cut(
+    std::span<const import::LodNode> nodes, std::span<const Float3> positions,
+    const LodCutParams& params, std::vector<uint32_t>& indices);
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,734 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_rasterizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPLAT_RASTER_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPLAT_RASTER_NEON 1
+#endif
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+using import::TraceStage;
+
+/**
+ * Pixels of a tile's row blended at once by `render_splats_tiled`.
+ */
+constexpr uint32_t num_lanes = 4;
+static_assert(raster_tile_size % num_lanes == 0,
+              "Tile rows must be a whole number of lanes");
+constexpr uint32_t pixels_per_tile = raster_tile_size * raster_tile_size;
+
+inline bool is_outside_frustum(const Float4& pos_clip) {
+  return pos_clip.x < -pos_clip.w || pos_clip.x > pos_clip.w ||
+         pos_clip.y < -pos_clip.w || pos_clip.y > pos_clip.w ||
+         pos_clip.z > pos_clip.w;
+}
+
+/**
+ * A splat, as set up by `render_splat.vs.hlsl` for all of its fragments.
+ */
+struct ScreenSplat {
+  float center_x = 0.f;
+  float center_y = 0.f;
+  /**
+   * Inverse of the transform, * 2: maps offsets from the center, in pixels,
+   * to the interpolated `out_sig_div_sqrt_2`.
+   */
+  float inv_t[4] = {};
+  /**
+   * Pixels whose center is within the bounds of the quad, inclusive.
+   */
+  int32_t min_x = 0;
+  int32_t max_x = -1;
+  int32_t min_y = 0;
+  int32_t max_y = -1;
+  /**
+   * Radius of the quad, in σ's, over sqrt(2).
+   */
+  float radius = 0.f;
+  Float4 color;
+  /**
+   * With `WeightedOIT`, `get_oit_depth_weight` of the splat.
+   */
+  float oit_weight = 0.f;
+};
+
+/**
+ * Mirror of the per-splat part of `render_splat.vs.hlsl`.
+ *
+ * @param position - Packed x11y11z10 position.
+ * @param packed - Transform, as written by `compute_transforms`.
+ * @param color - RGB and opacity.
+ * @param params - View constants.
+ * @param splat - Output.
+ * @return Whether the splat covers any pixel.
+ */
+bool setup_splat(uint32_t position, const PackedTransform& packed,
+                 const Float4& color, const RasterParams& params,
+                 ScreenSplat& splat) {
+  Float4 pos_clip =
+      mul(unpack_pos(position, params.pos_scale_cm, params.pos_min_cm),
+          params.local_to_clip);
+  if (is_outside_frustum(pos_clip)) {
+    return false;
+  }
+
+  // Transforms map corners of (+-radius, +-radius) to pixels * 2.
+  float t[4] = {f16tof32(packed.x), f16tof32(packed.y), f16tof32(packed.z),
+                f16tof32(packed.w)};
+  float det = t[0] * t[3] - t[1] * t[2];
+  if (!(std::abs(det) > 0.f)) {
+    return false;
+  }
+  splat.inv_t[0] = t[3] * 2.f / det;
+  splat.inv_t[1] = -t[1] * 2.f / det;
+  splat.inv_t[2] = -t[2] * 2.f / det;
+  splat.inv_t[3] = t[0] * 2.f / det;
+
+  // Splats too faint for any fragment collapse to a point.
+  splat.radius = params.opacity_adaptive_radius
+                     ? get_radius_sigma_over_sqrt_2(color.w)
+                     : radius_sigma_over_sqrt_2;
+  if (!(splat.radius > 0.f)) {
+    return false;
+  }
+  const float half_width = static_cast<float>(params.width) / 2.f;
+  const float half_height = static_cast<float>(params.height) / 2.f;
+  splat.center_x = (pos_clip.x / pos_clip.w + 1.f) * half_width;
+  splat.center_y = (pos_clip.y / pos_clip.w + 1.f) * half_height;
+  float extent_x = (std::abs(t[0]) + std::abs(t[1])) * splat.radius / 2.f;
+  float extent_y = (std::abs(t[2]) + std::abs(t[3])) * splat.radius / 2.f;
+  // Pixels whose center is within the bounds of the quad, clamped in float
+  // first, as huge splats may not fit in an int.
+  splat.min_x = static_cast<int32_t>(
+      std::max(std::ceil(splat.center_x - extent_x - .5f), 0.f));
+  splat.max_x = static_cast<int32_t>(
+      std::min(std::floor(splat.center_x + extent_x - .5f),
+               static_cast<float>(params.width - 1)));
+  splat.min_y = static_cast<int32_t>(
+      std::max(std::ceil(splat.center_y - extent_y - .5f), 0.f));
+  splat.max_y = static_cast<int32_t>(
+      std::min(std::floor(splat.center_y + extent_y - .5f),
+               static_cast<float>(params.height - 1)));
+
+  splat.color = color;
+  if (params.blend_mode == SplatBlendMode::WeightedOIT) {
+    splat.oit_weight =
+        get_oit_depth_weight(pos_clip.w * params.oit_depth_scale);
+  }
+  return splat.min_x <= splat.max_x && splat.min_y <= splat.max_y;
+}
+
+/**
+ * Mirror of `render_splat.ps.hlsl`.
+ *
+ * @param sig_div_sqrt_2_x, sig_div_sqrt_2_y - Distance from the splat's
+ * center, in σ's, over sqrt(2).
+ * @param opacity - Opacity of the splat.
+ * @param opacity_adaptive_radius - Whether alphas below `min_alpha` are cut
+ * off, as with `OPACITY_ADAPTIVE_RADIUS`.
+ * @return Alpha of the fragment.
+ */
+inline float shade_fragment(float sig_div_sqrt_2_x, float sig_div_sqrt_2_y,
+                            float opacity, bool opacity_adaptive_radius) {
+  float sig_sq_div_2 =
+      sig_div_sqrt_2_x * sig_div_sqrt_2_x + sig_div_sqrt_2_y * sig_div_sqrt_2_y;
+  float alpha = sig_sq_div_2 < cutoff_radius_sigma_squared_over_2
+                    ? opacity / std::exp(sig_sq_div_2)
+                    : 0.f;
+  return !opacity_adaptive_radius || alpha >= min_alpha ? alpha : 0.f;
+}
+
+/**
+ * Mirror of `resolve_weighted_oit.ps.hlsl`, over black.
+ *
+ * @param accumulated - Weighted sum of premultiplied colors, and of alphas.
+ * @param revealage - Product of 1 - alpha.
+ * @return Composited pixel, premultiplied.
+ */
+inline Float4 resolve_weighted_oit(const Float4& accumulated, float revealage) {
+  if (revealage > 1.f - min_alpha) {
+    return Float4();
+  }
+  float alpha = 1.f - revealage;
+  float scale = alpha / std::max(accumulated.w, 1e-5f);
+  return Float4(accumulated.x * scale, accumulated.y * scale,
+                accumulated.z * scale, alpha);
+}
+
+/**
+ * Operations on `num_lanes` floats, and masks selecting some of them. The
+ * arithmetic is the same as the scalar code of `rasterize_splats`, so that
+ * both produce the same image.
+ */
+#if defined(SPLAT_RASTER_SSE2)
+using Lanes = __m128;
+using LaneMask = __m128;
+
+inline Lanes lanes_set(float value) { return _mm_set1_ps(value); }
+inline Lanes lanes_load(const float* values) { return _mm_loadu_ps(values); }
+inline void lanes_store(float* values, Lanes a) { _mm_storeu_ps(values, a); }
+inline Lanes lanes_add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+inline Lanes lanes_sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+inline Lanes lanes_mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+inline Lanes lanes_div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+inline Lanes lanes_abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+inline LaneMask lanes_less(Lanes a, Lanes b) { return _mm_cmplt_ps(a, b); }
+inline LaneMask lanes_greater_equal(Lanes a, Lanes b) {
+  return _mm_cmpge_ps(a, b);
+}
+// True for NaN, as `!(a > b)` is.
+inline LaneMask lanes_not_greater(Lanes a, Lanes b) {
+  return _mm_cmpngt_ps(a, b);
+}
+inline LaneMask mask_and(LaneMask a, LaneMask b) { return _mm_and_ps(a, b); }
+inline LaneMask mask_and_not(LaneMask a, LaneMask b) {
+  return _mm_andnot_ps(b, a);
+}
+inline uint32_t mask_bits(LaneMask mask) {
+  return static_cast<uint32_t>(_mm_movemask_ps(mask));
+}
+inline Lanes lanes_select(LaneMask mask, Lanes a, Lanes b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#elif defined(SPLAT_RASTER_NEON)
+using Lanes = float32x4_t;
+using LaneMask = uint32x4_t;
+
+inline Lanes lanes_set(float value) { return vdupq_n_f32(value); }
+inline Lanes lanes_load(const float* values) { return vld1q_f32(values); }
+inline void lanes_store(float* values, Lanes a) { vst1q_f32(values, a); }
+inline Lanes lanes_add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+inline Lanes lanes_sub(Lanes a, Lanes b) { return vsubq_f32(a, b); }
+inline Lanes lanes_mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+inline Lanes lanes_div(Lanes a, Lanes b) { return vdivq_f32(a, b); }
+inline Lanes lanes_abs(Lanes a) { return vabsq_f32(a); }
+inline LaneMask lanes_less(Lanes a, Lanes b) { return vcltq_f32(a, b); }
+inline LaneMask lanes_greater_equal(Lanes a, Lanes b) {
+  return vcgeq_f32(a, b);
+}
+// True for NaN, as `!(a > b)` is.
+inline LaneMask lanes_not_greater(Lanes a, Lanes b) {
+  return vmvnq_u32(vcgtq_f32(a, b));
+}
+inline LaneMask mask_and(LaneMask a, LaneMask b) { return vandq_u32(a, b); }
+inline LaneMask mask_and_not(LaneMask a, LaneMask b) {
+  return vbicq_u32(a, b);
+}
+inline uint32_t mask_bits(LaneMask mask) {
+  const uint32_t bits[num_lanes] = {1, 2, 4, 8};
+  return vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+}
+inline Lanes lanes_select(LaneMask mask, Lanes a, Lanes b) {
+  return vbslq_f32(mask, a, b);
+}
+#else
+struct Lanes {
+  float values[num_lanes];
+};
+using LaneMask = uint32_t;
+
+template <typename Fn>
+inline Lanes lanes_map(Lanes a, Lanes b, Fn fn) {
+  Lanes result;
+  for (uint32_t i = 0; i < num_lanes; ++i) {
+    result.values[i] = fn(a.values[i], b.values[i]);
+  }
+  return result;
+}
+template <typename Fn>
+inline LaneMask lanes_test(Lanes a, Lanes b, Fn fn) {
+  LaneMask result = 0;
+  for (uint32_t i = 0; i < num_lanes; ++i) {
+    result |= fn(a.values[i], b.values[i]) ? 1u << i : 0u;
+  }
+  return result;
+}
+
+inline Lanes lanes_set(float value) {
+  return Lanes{{value, value, value, value}};
+}
+inline Lanes lanes_load(const float* values) {
+  return Lanes{{values[0], values[1], values[2], values[3]}};
+}
+inline void lanes_store(float* values, Lanes a) {
+  std::copy(a.values, a.values + num_lanes, values);
+}
+inline Lanes lanes_add(Lanes a, Lanes b) {
+  return lanes_map(a, b, [](float x, float y) { return x + y; });
+}
+inline Lanes lanes_sub(Lanes a, Lanes b) {
+  return lanes_map(a, b, [](float x, float y) { return x - y; });
+}
+inline Lanes lanes_mul(Lanes a, Lanes b) {
+  return lanes_map(a, b, [](float x, float y) { return x * y; });
+}
+inline Lanes lanes_div(Lanes a, Lanes b) {
+  return lanes_map(a, b, [](float x, float y) { return x / y; });
+}
+inline Lanes lanes_abs(Lanes a) {
+  return lanes_map(a, a, [](float x, float) { return std::abs(x); });
+}
+inline LaneMask lanes_less(Lanes a, Lanes b) {
+  return lanes_test(a, b, [](float x, float y) { return x < y; });
+}
+inline LaneMask lanes_greater_equal(Lanes a, Lanes b) {
+  return lanes_test(a, b, [](float x, float y) { return x >= y; });
+}
+inline LaneMask lanes_not_greater(Lanes a, Lanes b) {
+  return lanes_test(a, b, [](float x, float y) { return !(x > y); });
+}
+inline LaneMask mask_and(LaneMask a, LaneMask b) { return a & b; }
+inline LaneMask mask_and_not(LaneMask a, LaneMask b) { return a & ~b; }
+inline uint32_t mask_bits(LaneMask mask) { return mask; }
+inline Lanes lanes_select(LaneMask mask, Lanes a, Lanes b) {
+  Lanes result;
+  for (uint32_t i = 0; i < num_lanes; ++i) {
+    result.values[i] = (mask >> i) & 1 ? a.values[i] : b.values[i];
+  }
+  return result;
+}
+#endif
+
+/**
+ * Splat overlapping a tile, in the order it's blended in.
+ */
+struct TileEntry {
+  uint32_t key = 0;
+  /**
+   * Index of the `ScreenSplat`, which follows the order of splats.
+   */
+  uint32_t screen_index = 0;
+};
+
+/**
+ * Pixels of a tile, as planes.
+ */
+struct TilePixels {
+  float r[pixels_per_tile];
+  float g[pixels_per_tile];
+  float b[pixels_per_tile];
+  /**
+   * Alpha, or with `WeightedOIT`, the sum of weights.
+   */
+  float a[pixels_per_tile];
+  float revealage[pixels_per_tile];
+  uint32_t overdraw[pixels_per_tile];
+};
+
+/**
+ * Blends the splats overlapping a tile, `num_lanes` pixels at a time.
+ *
+ * @param tile_x, tile_y - First pixel of the tile.
+ * @param entries - Splats overlapping the tile, in blending order.
+ * @param screen_splats - Set up splats.
+ * @param params - Blending constants.
+ * @param pixels - Output, cleared first.
+ * @param stats - Fragment counts, added to.
+ */
+void blend_tile(int32_t tile_x, int32_t tile_y,
+                std::span<const TileEntry> entries,
+                std::span<const ScreenSplat> screen_splats,
+                const RasterParams& params, TilePixels& pixels,
+                RasterStats& stats) {
+  const SplatBlendMode mode = params.blend_mode;
+  std::fill(std::begin(pixels.r), std::end(pixels.r), 0.f);
+  std::fill(std::begin(pixels.g), std::end(pixels.g), 0.f);
+  std::fill(std::begin(pixels.b), std::end(pixels.b), 0.f);
+  std::fill(std::begin(pixels.a), std::end(pixels.a), 0.f);
+  std::fill(std::begin(pixels.revealage), std::end(pixels.revealage), 1.f);
+  std::fill(std::begin(pixels.overdraw), std::end(pixels.overdraw), 0u);
+
+  float pixel_centers_x[raster_tile_size];
+  for (uint32_t x = 0; x < raster_tile_size; ++x) {
+    pixel_centers_x[x] = static_cast<float>(tile_x + static_cast<int32_t>(x)) +
+                         .5f;
+  }
+
+  const Lanes cutoff = lanes_set(cutoff_radius_sigma_squared_over_2);
+  const Lanes fragment_min_alpha = lanes_set(min_alpha);
+  const Lanes saturation = lanes_set(params.saturation_alpha);
+  const Lanes zero = lanes_set(0.f);
+  const Lanes one = lanes_set(1.f);
+  const int32_t last_x = tile_x + static_cast<int32_t>(raster_tile_size) - 1;
+  const int32_t last_y = tile_y + static_cast<int32_t>(raster_tile_size) - 1;
+
+  for (const TileEntry& entry : entries) {
+    const ScreenSplat& splat = screen_splats[entry.screen_index];
+    const int32_t min_x = std::max(splat.min_x, tile_x);
+    const int32_t max_x = std::min(splat.max_x, last_x);
+    const int32_t min_y = std::max(splat.min_y, tile_y);
+    const int32_t max_y = std::min(splat.max_y, last_y);
+    // Whole groups of lanes, masked to the splat's bounds.
+    const uint32_t first_lane =
+        static_cast<uint32_t>(min_x - tile_x) / num_lanes * num_lanes;
+    const uint32_t end_lane = static_cast<uint32_t>(max_x - tile_x) + 1;
+    const Lanes bounds_min =
+        lanes_set(static_cast<float>(splat.min_x) + .5f);
+    const Lanes bounds_max =
+        lanes_set(static_cast<float>(splat.max_x) + .5f);
+
+    const Lanes radius = lanes_set(splat.radius);
+    const Lanes center_x = lanes_set(splat.center_x);
+    const Lanes inv_t0 = lanes_set(splat.inv_t[0]);
+    const Lanes inv_t2 = lanes_set(splat.inv_t[2]);
+    const Lanes opacity = lanes_set(splat.color.w);
+    const Lanes color_r = lanes_set(splat.color.x);
+    const Lanes color_g = lanes_set(splat.color.y);
+    const Lanes color_b = lanes_set(splat.color.z);
+    const Lanes oit_weight = lanes_set(splat.oit_weight);
+
+    for (int32_t y = min_y; y <= max_y; ++y) {
+      float dy = static_cast<float>(y) + .5f - splat.center_y;
+      const Lanes sig_x_dy = lanes_set(splat.inv_t[1] * dy);
+      const Lanes sig_y_dy = lanes_set(splat.inv_t[3] * dy);
+      const uint32_t row = static_cast<uint32_t>(y - tile_y) * raster_tile_size;
+
+      for (uint32_t lane = first_lane; lane < end_lane; lane += num_lanes) {
+        const Lanes pixel_x = lanes_load(&pixel_centers_x[lane]);
+        const Lanes dx = lanes_sub(pixel_x, center_x);
+        // Interpolated `out_sig_div_sqrt_2`, i.e. the corner coordinates.
+        const Lanes sig_x = lanes_add(lanes_mul(inv_t0, dx), sig_x_dy);
+        const Lanes sig_y = lanes_add(lanes_mul(inv_t2, dx), sig_y_dy);
+        LaneMask covered =
+            mask_and(lanes_greater_equal(pixel_x, bounds_min),
+                     lanes_not_greater(pixel_x, bounds_max));
+        covered = mask_and(covered,
+                           lanes_not_greater(lanes_abs(sig_x), radius));
+        covered = mask_and(covered,
+                           lanes_not_greater(lanes_abs(sig_y), radius));
+        if (mask_bits(covered) == 0) {
+          continue;
+        }
+
+        const uint32_t pixel = row + lane;
+        const Lanes dst_a = lanes_load(&pixels.a[pixel]);
+        if (mode == SplatBlendMode::FrontToBack) {
+          LaneMask saturated =
+              mask_and(covered, lanes_greater_equal(dst_a, saturation));
+          stats.num_skipped += std::popcount(mask_bits(saturated));
+          covered = mask_and_not(covered, saturated);
+        }
+        const uint32_t shaded = mask_bits(covered);
+        if (shaded == 0) {
+          continue;
+        }
+        stats.num_shaded += std::popcount(shaded);
+        for (uint32_t i = 0; i < num_lanes; ++i) {
+          pixels.overdraw[pixel + i] += (shaded >> i) & 1;
+        }
+
+        const Lanes sig_sq_div_2 =
+            lanes_add(lanes_mul(sig_x, sig_x), lanes_mul(sig_y, sig_y));
+        float exponentials[num_lanes];
+        lanes_store(exponentials, sig_sq_div_2);
+        for (uint32_t i = 0; i < num_lanes; ++i) {
+          exponentials[i] = (shaded >> i) & 1 ? std::exp(exponentials[i]) : 1.f;
+        }
+        Lanes alpha =
+            lanes_select(lanes_less(sig_sq_div_2, cutoff),
+                         lanes_div(opacity, lanes_load(exponentials)), zero);
+        if (params.opacity_adaptive_radius) {
+          alpha = lanes_select(lanes_greater_equal(alpha, fragment_min_alpha),
+                               alpha, zero);
+        }
+
+        // As in `rasterize_splats`.
+        Lanes src_factor = alpha;
+        Lanes dst_factor = one;
+        if (mode == SplatBlendMode::BackToFront) {
+          dst_factor = lanes_sub(one, alpha);
+        } else if (mode == SplatBlendMode::FrontToBack) {
+          src_factor = lanes_mul(lanes_sub(one, dst_a), alpha);
+        } else {
+          src_factor = lanes_mul(alpha, oit_weight);
+          Lanes revealage = lanes_load(&pixels.revealage[pixel]);
+          Lanes blended = lanes_mul(revealage, lanes_sub(one, alpha));
+          lanes_store(&pixels.revealage[pixel],
+                      lanes_select(covered, blended, revealage));
+        }
+        float* planes[3] = {pixels.r, pixels.g, pixels.b};
+        const Lanes colors[3] = {color_r, color_g, color_b};
+        for (uint32_t channel = 0; channel < 3; ++channel) {
+          Lanes dst = lanes_load(&planes[channel][pixel]);
+          Lanes blended = lanes_add(lanes_mul(colors[channel], src_factor),
+                                    lanes_mul(dst, dst_factor));
+          lanes_store(&planes[channel][pixel],
+                      lanes_select(covered, blended, dst));
+        }
+        Lanes blended_a = lanes_add(src_factor, lanes_mul(dst_a, dst_factor));
+        lanes_store(&pixels.a[pixel], lanes_select(covered, blended_a, dst_a));
+      }
+    }
+  }
+}
+}  // namespace
+
+RasterStats rasterize_splats(std::span<const uint32_t> positions,
+                             std::span<const PackedTransform> transforms,
+                             std::span<const Float4> colors,
+                             std::span<const SortedSplat> sorted,
+                             const RasterParams& params,
+                             std::vector<Float4>& image) {
+  SPLAT_TRACE_STAGE(TraceStage::Rasterize);
+  SPLAT_TRACE_COUNT(TraceStage::Rasterize,
+                    sorted.size_bytes() + image.size() * sizeof(Float4),
+                    sorted.size());
+
+  RasterStats stats;
+  image.assign(static_cast<size_t>(params.width) * params.height, Float4());
+  if (params.width == 0 || params.height == 0) {
+    return stats;
+  }
+  const bool front_to_back = params.blend_mode == SplatBlendMode::FrontToBack;
+  const bool weighted_oit = params.blend_mode == SplatBlendMode::WeightedOIT;
+  // With `WeightedOIT`, `image` holds the accumulation target until resolved.
+  std::vector<float> revealage;
+  if (weighted_oit) {
+    revealage.assign(image.size(), 1.f);
+  }
+
+  for (const SortedSplat& sorted_splat : sorted) {
+    uint32_t index = sorted_splat.index;
+    ScreenSplat splat;
+    if (!setup_splat(positions[index], transforms[index], colors[index],
+                     params, splat)) {
+      continue;
+    }
+
+    const Float4& color = splat.color;
+    for (int32_t y = splat.min_y; y <= splat.max_y; ++y) {
+      float dy = static_cast<float>(y) + .5f - splat.center_y;
+      size_t row = static_cast<size_t>(y) * params.width;
+      for (int32_t x = splat.min_x; x <= splat.max_x; ++x) {
+        float dx = static_cast<float>(x) + .5f - splat.center_x;
+        // Interpolated `out_sig_div_sqrt_2`, i.e. the corner coordinates.
+        float sig_x = splat.inv_t[0] * dx + splat.inv_t[1] * dy;
+        float sig_y = splat.inv_t[2] * dx + splat.inv_t[3] * dy;
+        if (std::abs(sig_x) > splat.radius || std::abs(sig_y) > splat.radius) {
+          continue;
+        }
+
+        Float4& dst = image[row + x];
+        if (front_to_back && dst.w >= params.saturation_alpha) {
+          ++stats.num_skipped;
+          continue;
+        }
+        ++stats.num_shaded;
+
+        float alpha = shade_fragment(sig_x, sig_y, color.w,
+                                     params.opacity_adaptive_radius);
+        if (weighted_oit) {
+          float weight = alpha * splat.oit_weight;
+          dst.x += color.x * weight;
+          dst.y += color.y * weight;
+          dst.z += color.z * weight;
+          dst.w += weight;
+          revealage[row + x] *= 1.f - alpha;
+          continue;
+        }
+        // Over (back-to-front), or under (front-to-back), as in
+        // `get_blend_state`.
+        float src_factor = front_to_back ? (1.f - dst.w) * alpha : alpha;
+        float dst_factor = front_to_back ? 1.f : 1.f - alpha;
+        dst.x = color.x * src_factor + dst.x * dst_factor;
+        dst.y = color.y * src_factor + dst.y * dst_factor;
+        dst.z = color.z * src_factor + dst.z * dst_factor;
+        dst.w = src_factor + dst.w * dst_factor;
+      }
+    }
+  }
+
+  if (weighted_oit) {
+    for (size_t i = 0; i < image.size(); ++i) {
+      image[i] = resolve_weighted_oit(image[i], revealage[i]);
+    }
+  }
+  return stats;
+}
+
+RasterStats render_splats_tiled(std::span<const uint32_t> positions,
+                                std::span<const PackedCovariance> covariances,
+                                std::span<const Float4> colors,
+                                const TiledRenderParams& params,
+                                std::vector<Float4>& image,
+                                std::span<uint32_t> overdraw) {
+  const RasterParams& raster = params.raster;
+  RasterStats stats;
+  image.assign(static_cast<size_t>(raster.width) * raster.height, Float4());
+  if (raster.width == 0 || raster.height == 0) {
+    return stats;
+  }
+  const bool is_sorted_mode = is_sorted(raster.blend_mode);
+
+  // Keys and transforms, as by the fused compute pass.
+  DistanceParams distance_params = params.distance;
+  distance_params.front_to_back =
+      raster.blend_mode == SplatBlendMode::FrontToBack;
+  const size_t num_splats = positions.size();
+  std::vector<uint32_t> distances(num_splats);
+  std::vector<PackedTransform> transforms(num_splats);
+  std::vector<uint16_t> opacity_scales(num_splats);
+  compute_distances_and_transforms(positions, covariances, distance_params,
+                                   params.transform, distances, transforms,
+                                   opacity_scales);
+
+  SPLAT_TRACE_STAGE(TraceStage::Rasterize);
+  SPLAT_TRACE_COUNT(TraceStage::Rasterize,
+                    num_splats * sizeof(ScreenSplat) +
+                        image.size() * sizeof(Float4),
+                    num_splats);
+
+  const uint32_t not_visible = get_distance_not_visible(distance_params);
+  const uint32_t tiles_x =
+      (raster.width + raster_tile_size - 1) / raster_tile_size;
+  const uint32_t tiles_y =
+      (raster.height + raster_tile_size - 1) / raster_tile_size;
+  const uint32_t num_tiles = tiles_x * tiles_y;
+
+  // Set up visible splats, and count their tiles, per task. Concatenating
+  // tasks' splats keeps them in splat order.
+  uint32_t num_tasks = import::get_num_ranges(num_splats, min_splats_per_task);
+  auto get_begin = [&](uint32_t task) {
+    return num_splats * task / num_tasks;
+  };
+  std::vector<std::vector<ScreenSplat>> task_splats(num_tasks);
+  std::vector<std::vector<uint32_t>> task_keys(num_tasks);
+  std::vector<std::vector<uint32_t>> task_tile_counts(
+      num_tasks, std::vector<uint32_t>(num_tiles));
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    std::vector<ScreenSplat>& splats = task_splats[task];
+    std::vector<uint32_t>& tile_counts = task_tile_counts[task];
+    for (size_t i = get_begin(task), end = get_begin(task + 1); i < end; ++i) {
+      if (distances[i] == not_visible) {
+        continue;
+      }
+      // As `FOOTPRINT_LIMITS` compensates for clamping large splats.
+      Float4 color = colors[i];
+      color.w = std::min(color.w * f16tof32(opacity_scales[i]), 1.f);
+      ScreenSplat splat;
+      if (!setup_splat(positions[i], transforms[i], color, raster, splat)) {
+        continue;
+      }
+      for (uint32_t ty = splat.min_y / raster_tile_size;
+           ty <= splat.max_y / raster_tile_size; ++ty) {
+        for (uint32_t tx = splat.min_x / raster_tile_size;
+             tx <= splat.max_x / raster_tile_size; ++tx) {
+          ++tile_counts[ty * tiles_x + tx];
+        }
+      }
+      splats.push_back(splat);
+      task_keys[task].push_back(distances[i]);
+    }
+  });
+
+  std::vector<uint32_t> splat_offsets(num_tasks + 1);
+  for (uint32_t task = 0; task < num_tasks; ++task) {
+    splat_offsets[task + 1] =
+        splat_offsets[task] + static_cast<uint32_t>(task_splats[task].size());
+  }
+  // Tiles' entries are contiguous, and within a tile, tasks' entries are in
+  // task order. Counts become each task's first entry in each tile.
+  std::vector<uint32_t> tile_offsets(num_tiles + 1);
+  uint32_t num_entries = 0;
+  for (uint32_t tile = 0; tile < num_tiles; ++tile) {
+    tile_offsets[tile] = num_entries;
+    for (uint32_t task = 0; task < num_tasks; ++task) {
+      uint32_t count = task_tile_counts[task][tile];
+      task_tile_counts[task][tile] = num_entries;
+      num_entries += count;
+    }
+  }
+  tile_offsets[num_tiles] = num_entries;
+
+  std::vector<ScreenSplat> screen_splats(splat_offsets[num_tasks]);
+  std::vector<TileEntry> entries(num_entries);
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    std::vector<uint32_t>& cursors = task_tile_counts[task];
+    const std::vector<ScreenSplat>& splats = task_splats[task];
+    for (uint32_t i = 0; i < splats.size(); ++i) {
+      const ScreenSplat& splat = splats[i];
+      uint32_t screen_index = splat_offsets[task] + i;
+      screen_splats[screen_index] = splat;
+      for (uint32_t ty = splat.min_y / raster_tile_size;
+           ty <= splat.max_y / raster_tile_size; ++ty) {
+        for (uint32_t tx = splat.min_x / raster_tile_size;
+             tx <= splat.max_x / raster_tile_size; ++tx) {
+          entries[cursors[ty * tiles_x + tx]++] =
+              TileEntry{task_keys[task][i], screen_index};
+        }
+      }
+    }
+  });
+  task_splats.clear();
+  task_keys.clear();
+
+  // Tiles vary widely in cost, so tasks take the next tile until none remain.
+  std::atomic<uint32_t> next_tile = 0;
+  std::atomic<uint64_t> num_shaded = 0;
+  std::atomic<uint64_t> num_skipped = 0;
+  import::run_tasks(import::get_task_concurrency(), [&](uint32_t) {
+    TilePixels pixels;
+    RasterStats task_stats;
+    for (uint32_t tile = next_tile++; tile < num_tiles; tile = next_tile++) {
+      std::span<TileEntry> tile_entries(
+          entries.data() + tile_offsets[tile],
+          entries.data() + tile_offsets[tile + 1]);
+      // Sorting by key, then splat, matches the stable sort of all splats.
+      if (is_sorted_mode) {
+        std::sort(tile_entries.begin(), tile_entries.end(),
+                  [](const TileEntry& a, const TileEntry& b) {
+                    return a.key != b.key ? a.key < b.key
+                                          : a.screen_index < b.screen_index;
+                  });
+      }
+      int32_t tile_x = static_cast<int32_t>(tile % tiles_x * raster_tile_size);
+      int32_t tile_y = static_cast<int32_t>(tile / tiles_x * raster_tile_size);
+      blend_tile(tile_x, tile_y, tile_entries, screen_splats, raster, pixels,
+                 task_stats);
+
+      uint32_t width = std::min(raster_tile_size,
+                                raster.width - static_cast<uint32_t>(tile_x));
+      uint32_t height = std::min(raster_tile_size,
+                                 raster.height - static_cast<uint32_t>(tile_y));
+      for (uint32_t y = 0; y < height; ++y) {
+        size_t dst_row =
+            (static_cast<size_t>(tile_y) + y) * raster.width + tile_x;
+        for (uint32_t x = 0; x < width; ++x) {
+          uint32_t pixel = y * raster_tile_size + x;
+          Float4 color(pixels.r[pixel], pixels.g[pixel], pixels.b[pixel],
+                       pixels.a[pixel]);
+          image[dst_row + x] =
+              raster.blend_mode == SplatBlendMode::WeightedOIT
+                  ? resolve_weighted_oit(color, pixels.revealage[pixel])
+                  : color;
+          if (!overdraw.empty()) {
+            overdraw[dst_row + x] = pixels.overdraw[pixel];
+          }
+        }
+      }
+    }
+    num_shaded += task_stats.num_shaded;
+    num_skipped += task_stats.num_skipped;
+  });
+
+  stats.num_shaded = num_shaded;
+  stats.num_skipped = num_skipped;
+  return stats;
+}
+}  // namespace render
@@ -0,0 +1,141 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "render/splat_draw.h"
+#include "render/splat_sort.h"
+#include "render/splat_transform.h"
+
+namespace render {
+/**
+ * Constants of a reference rasterization.
+ */
+struct RasterParams {
+  /**
+   * Projection splats are drawn with, as `world_to_clip` in
+   * `render_splat.vs.hlsl`.
+   */
+  Float4x4 local_to_clip = Float4x4::identity();
+  Float3 pos_scale_cm;
+  Float3 pos_min_cm;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  /**
+   * Blending, which must match the order splats are given in.
+   */
+  SplatBlendMode blend_mode = SplatBlendMode::BackToFront;
+  /**
+   * With `FrontToBack`, fragments of pixels whose alpha has reached this are
+   * skipped. Above 1, nothing is skipped.
+   */
+  float saturation_alpha = render::saturation_alpha;
+  /**
+   * With `WeightedOIT`, the `oit_depth_scale` of `render_splat.vs.hlsl`, e.g.
+   * from centimeters to meters.
+   */
+  float oit_depth_scale = 0.01f;
+  /**
+   * Fits each splat's quad to where its alpha falls below `min_alpha`, and
+   * cuts fragments off there, matching `OPACITY_ADAPTIVE_RADIUS` (see
+   * `get_radius_sigma_over_sqrt_2`).
+   */
+  bool opacity_adaptive_radius = false;
+};
+
+/**
+ * Width and height of the screen tiles of `render_splats_tiled`, in pixels.
+ */
+constexpr uint32_t raster_tile_size = 16;
+
+/**
+ * Constants of a tiled CPU render, i.e. of every pass drawing splats.
+ */
+struct TiledRenderParams {
+  /**
+   * Sort constants. `front_to_back` is set to match `raster.blend_mode`. Its
+   * unpacking constants are used for the transforms too, as by
+   * `compute_distances_and_transforms`.
+   */
+  DistanceParams distance;
+  /**
+   * View constants of the transforms, including footprint limits.
+   */
+  TransformParams transform;
+  /**
+   * Resolution and blending. Its view must match `distance`'s.
+   */
+  RasterParams raster;
+};
+
+/**
+ * Fragment counts of a reference rasterization.
+ */
+struct RasterStats {
+  /**
+   * Fragments covered by splats' quads, which were shaded and blended.
+   */
+  uint64_t num_shaded = 0;
+  /**
+   * Fragments covered by splats' quads, but skipped as their pixel had
+   * saturated. The GPU only skips these after the next saturation pass, so
+   * skips fewer.
+   */
+  uint64_t num_skipped = 0;
+};
+
+/**
+ * CPU reference of drawing splats with `render_splat.vs.hlsl` and
+ * `render_splat.ps.hlsl`, with any blend mode, for validating them and
+ * comparing images between modes. Single-threaded, and in float32.
+ *
+ * @param positions - Packed x11y11z10 positions.
+ * @param transforms - Transforms, as written by `compute_transforms`.
+ * @param colors - Per splat, RGB and opacity, as in `colors`.
+ * @param sorted - Draw order, e.g. from `SplatSorter` with keys for
+ * `params.blend_mode`. Any order with `WeightedOIT`.
+ * @param params - View and blending constants.
+ * @param image - Output, `params.width` * `params.height` pixels (row 0 at
+ * the bottom), of RGB premultiplied by alpha (i.e. over black), and alpha.
+ * With `WeightedOIT`, as composited by `resolve_weighted_oit.ps.hlsl`.
+ * @return Fragment counts.
+ */
+SPLAT_EXPORT_API RasterStats rasterize_splats(
+    std::span<const uint32_t> positions,
+    std::span<const PackedTransform> transforms,
+    std::span<const Float4> colors, std::span<const SortedSplat> sorted,
+    const RasterParams& params, std::vector<Float4>& image);
+
+/**
+ * Renders splats without a GPU, reproducing
+ * `compute_distance_transform.cs.hlsl` (i.e. `compute_distance.cs.hlsl` and
+ * `compute_transform.cs.hlsl`),
+ * `render_splat.vs.hlsl` and `render_splat.ps.hlsl`, e.g. for thumbnails,
+ * golden images, or measuring fill rate.
+ *
+ * Visible splats are binned into tiles of `raster_tile_size` pixels, which are
+ * sorted and blended in parallel, `raster_tile_size` / 4 groups of 4 pixels
+ * per row, with SSE2 or NEON where available. Sorting each tile by key, then
+ * by splat, gives the order of `SplatSorter`, so the image matches that of
+ * `rasterize_splats` given its order. `WeightedOIT` tiles aren't sorted.
+ *
+ * @param positions - Packed x11y11z10 positions.
+ * @param covariances - Packed covariances.
+ * @param colors - Per splat, RGB and opacity, as in `colors`.
+ * @param params - View, sort and blending constants.
+ * @param image - Output, as by `rasterize_splats`.
+ * @param overdraw - Optional output, `params.raster.width` *
+ * `params.raster.height` counts of fragments shaded per pixel.
+ * @return Fragment counts.
+ */
+SPLAT_EXPORT_API RasterStats render_splats_tiled(
+    std::span<const uint32_t> positions,
+    std::span<const PackedCovariance> covariances,
+    std::span<const Float4> colors, const TiledRenderParams& params,
+    std::vector<Float4>& image, std::span<uint32_t> overdraw = {});
+}  // namespace render
\ No newline at end of file
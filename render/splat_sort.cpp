@@ -0,0 +1,556 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_sort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPLAT_SORT_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPLAT_SORT_NEON 1
+#endif
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+using import::TraceStage;
+
+constexpr uint32_t radix_bits = 8;
+constexpr uint32_t radix_size = 1 << radix_bits;
+constexpr uint32_t radix_mask = radix_size - 1;
+
+/**
+ * HLSL `saturate`, including mapping NaN to 0.
+ */
+inline float saturate(float value) {
+  return value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+}
+
+inline bool is_outside_frustum(const Float4& pos_clip) {
+  return pos_clip.x < -pos_clip.w || pos_clip.x > pos_clip.w ||
+         pos_clip.y < -pos_clip.w || pos_clip.y > pos_clip.w ||
+         pos_clip.z > pos_clip.w;
+}
+
+/**
+ * Mirror of `encode_distance` in `compute_distance.cs.hlsl`, for encodings of
+ * view depth.
+ *
+ * @param depth - View depth, i.e. clip space w.
+ */
+inline uint32_t encode_view_depth(float depth, const DistanceParams& params) {
+  float near_cm = params.distance_near_cm;
+  float far_cm = params.distance_far_cm;
+  depth = std::min(std::max(depth, near_cm), far_cm);
+  float scale = get_distance_scale(params.precision);
+  switch (params.encoding) {
+    case DistanceEncoding::LinearDepth: {
+      float t = (depth - near_cm) / (far_cm - near_cm);
+      return static_cast<uint32_t>((1.f - t) * scale);
+    }
+    case DistanceEncoding::LogDepth: {
+      float t = std::log2(depth / near_cm) / std::log2(far_cm / near_cm);
+      return static_cast<uint32_t>((1.f - saturate(t)) * scale);
+    }
+    default: {
+      uint32_t bits;
+      std::memcpy(&bits, &depth, sizeof(bits));
+      return ~(bits << 1) >> (32 - params.precision);
+    }
+  }
+}
+
+/**
+ * @return Largest key of a visible splat, which front-to-back keys are
+ * reversed within.
+ */
+inline uint32_t get_max_visible_key(const DistanceParams& params) {
+  return get_distance_not_visible(params) - 1;
+}
+
+inline uint32_t encode_distance(const Float4& pos_clip,
+                                const DistanceParams& params) {
+  uint32_t key;
+  if (params.encoding == DistanceEncoding::ClipDepth) {
+    float depth = saturate(pos_clip.z / pos_clip.w);
+    key = static_cast<uint32_t>(depth * get_distance_scale(params.precision));
+  } else {
+    key = encode_view_depth(pos_clip.w, params);
+  }
+  return params.front_to_back ? get_max_visible_key(params) - key : key;
+}
+
+inline uint32_t get_num_cull_views(const DistanceParams& params) {
+  return std::min<uint32_t>(params.num_cull_views, max_cull_views);
+}
+
+inline uint32_t compute_distance(uint32_t packed,
+                                 const DistanceParams& params) {
+  Float4 pos_local =
+      unpack_pos(packed, params.pos_scale_cm, params.pos_min_cm);
+  Float4 pos_clip = mul(pos_local, params.local_to_clip);
+
+  bool inside_frustum = !is_outside_frustum(pos_clip);
+  uint32_t num_cull_views = get_num_cull_views(params);
+  if (num_cull_views != 0) {
+    inside_frustum = false;
+    for (uint32_t view = 0; view < num_cull_views; ++view) {
+      inside_frustum |= !is_outside_frustum(
+          mul(pos_local, params.cull_local_to_clip[view]));
+    }
+  }
+
+  return inside_frustum ? encode_distance(pos_clip, params)
+                        : get_distance_not_visible(params);
+}
+
+#if defined(SPLAT_SORT_SSE2)
+inline void load_matrix(const Float4x4& M, __m128 m[4][4]) {
+  for (uint32_t r = 0; r < 4; ++r) {
+    for (uint32_t c = 0; c < 4; ++c) {
+      m[r][c] = _mm_set1_ps(M.m[r][c]);
+    }
+  }
+}
+
+inline void transform(__m128 x, __m128 y, __m128 z, const __m128 m[4][4],
+                      __m128 clip[4]) {
+  for (uint32_t c = 0; c < 4; ++c) {
+    clip[c] = _mm_add_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m[0][c]), _mm_mul_ps(y, m[1][c])),
+                   _mm_mul_ps(z, m[2][c])),
+        m[3][c]);
+  }
+}
+
+inline __m128 is_outside_frustum(const __m128 clip[4]) {
+  __m128 neg_w = _mm_sub_ps(_mm_setzero_ps(), clip[3]);
+  return _mm_or_ps(
+      _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(clip[0], neg_w),
+                          _mm_cmpgt_ps(clip[0], clip[3])),
+                _mm_or_ps(_mm_cmplt_ps(clip[1], neg_w),
+                          _mm_cmpgt_ps(clip[1], clip[3]))),
+      _mm_cmpgt_ps(clip[2], clip[3]));
+}
+#elif defined(SPLAT_SORT_NEON)
+inline void load_matrix(const Float4x4& M, float32x4_t m[4][4]) {
+  for (uint32_t r = 0; r < 4; ++r) {
+    for (uint32_t c = 0; c < 4; ++c) {
+      m[r][c] = vdupq_n_f32(M.m[r][c]);
+    }
+  }
+}
+
+inline void transform(float32x4_t x, float32x4_t y, float32x4_t z,
+                      const float32x4_t m[4][4], float32x4_t clip[4]) {
+  for (uint32_t c = 0; c < 4; ++c) {
+    clip[c] = vaddq_f32(
+        vaddq_f32(vaddq_f32(vmulq_f32(x, m[0][c]), vmulq_f32(y, m[1][c])),
+                  vmulq_f32(z, m[2][c])),
+        m[3][c]);
+  }
+}
+
+inline uint32x4_t is_outside_frustum(const float32x4_t clip[4]) {
+  float32x4_t neg_w = vnegq_f32(clip[3]);
+  return vorrq_u32(
+      vorrq_u32(vorrq_u32(vcltq_f32(clip[0], neg_w),
+                          vcgtq_f32(clip[0], clip[3])),
+                vorrq_u32(vcltq_f32(clip[1], neg_w),
+                          vcgtq_f32(clip[1], clip[3]))),
+      vcgtq_f32(clip[2], clip[3]));
+}
+#endif
+
+/**
+ * Computes distances for [begin, end), 4 splats at a time where possible.
+ */
+void compute_distances_range(const uint32_t* positions,
+                             const DistanceParams& params, uint32_t* distances,
+                             size_t begin, size_t end) {
+  size_t i = begin;
+
+#if defined(SPLAT_SORT_SSE2)
+  uint32_t num_cull_views = get_num_cull_views(params);
+  __m128 m[4][4];
+  load_matrix(params.local_to_clip, m);
+  __m128 cull_m[max_cull_views][4][4];
+  for (uint32_t view = 0; view < num_cull_views; ++view) {
+    load_matrix(params.cull_local_to_clip[view], cull_m[view]);
+  }
+  const __m128 scale_x = _mm_set1_ps(params.pos_scale_cm.x);
+  const __m128 scale_y = _mm_set1_ps(params.pos_scale_cm.y);
+  const __m128 scale_z = _mm_set1_ps(params.pos_scale_cm.z);
+  const __m128 min_x = _mm_set1_ps(params.pos_min_cm.x);
+  const __m128 min_y = _mm_set1_ps(params.pos_min_cm.y);
+  const __m128 min_z = _mm_set1_ps(params.pos_min_cm.z);
+  const __m128i mask_11 = _mm_set1_epi32(0x7FF);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 scale = _mm_set1_ps(get_distance_scale(params.precision));
+  const __m128i not_visible =
+      _mm_set1_epi32(static_cast<int>(get_distance_not_visible(params)));
+  const __m128i max_visible_key =
+      _mm_set1_epi32(static_cast<int>(get_max_visible_key(params)));
+  const bool is_clip_depth = params.encoding == DistanceEncoding::ClipDepth;
+
+  for (; i + 4 <= end; i += 4) {
+    __m128i packed =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(positions + i));
+    __m128 x = _mm_cvtepi32_ps(_mm_and_si128(packed, mask_11));
+    __m128 y =
+        _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 11), mask_11));
+    __m128 z = _mm_cvtepi32_ps(_mm_srli_epi32(packed, 22));
+    x = _mm_add_ps(_mm_mul_ps(x, scale_x), min_x);
+    y = _mm_add_ps(_mm_mul_ps(y, scale_y), min_y);
+    z = _mm_add_ps(_mm_mul_ps(z, scale_z), min_z);
+
+    __m128 clip[4];
+    transform(x, y, z, m, clip);
+    __m128 outside = is_outside_frustum(clip);
+    if (num_cull_views != 0) {
+      // Culled only if outside of all views.
+      outside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+      for (uint32_t view = 0; view < num_cull_views; ++view) {
+        __m128 cull_clip[4];
+        transform(x, y, z, cull_m[view], cull_clip);
+        outside = _mm_and_ps(outside, is_outside_frustum(cull_clip));
+      }
+    }
+
+    __m128i distance;
+    if (is_clip_depth) {
+      // max/min return their second operand for NaN, matching `saturate`.
+      __m128 depth = _mm_min_ps(
+          _mm_max_ps(_mm_div_ps(clip[2], clip[3]), zero), one);
+      distance = _mm_cvttps_epi32(_mm_mul_ps(depth, scale));
+    } else {
+      alignas(16) float depths[4];
+      alignas(16) uint32_t lanes[4];
+      _mm_store_ps(depths, clip[3]);
+      for (uint32_t lane = 0; lane < 4; ++lane) {
+        lanes[lane] = encode_view_depth(depths[lane], params);
+      }
+      distance = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+    }
+    if (params.front_to_back) {
+      distance = _mm_sub_epi32(max_visible_key, distance);
+    }
+    __m128i outside_mask = _mm_castps_si128(outside);
+    distance = _mm_or_si128(_mm_andnot_si128(outside_mask, distance),
+                            _mm_and_si128(outside_mask, not_visible));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(distances + i), distance);
+  }
+#elif defined(SPLAT_SORT_NEON)
+  uint32_t num_cull_views = get_num_cull_views(params);
+  float32x4_t m[4][4];
+  load_matrix(params.local_to_clip, m);
+  float32x4_t cull_m[max_cull_views][4][4];
+  for (uint32_t view = 0; view < num_cull_views; ++view) {
+    load_matrix(params.cull_local_to_clip[view], cull_m[view]);
+  }
+  const float32x4_t scale_x = vdupq_n_f32(params.pos_scale_cm.x);
+  const float32x4_t scale_y = vdupq_n_f32(params.pos_scale_cm.y);
+  const float32x4_t scale_z = vdupq_n_f32(params.pos_scale_cm.z);
+  const float32x4_t min_x = vdupq_n_f32(params.pos_min_cm.x);
+  const float32x4_t min_y = vdupq_n_f32(params.pos_min_cm.y);
+  const float32x4_t min_z = vdupq_n_f32(params.pos_min_cm.z);
+  const uint32x4_t mask_11 = vdupq_n_u32(0x7FF);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t scale = vdupq_n_f32(get_distance_scale(params.precision));
+  const uint32x4_t not_visible = vdupq_n_u32(get_distance_not_visible(params));
+  const uint32x4_t max_visible_key = vdupq_n_u32(get_max_visible_key(params));
+  const bool is_clip_depth = params.encoding == DistanceEncoding::ClipDepth;
+
+  for (; i + 4 <= end; i += 4) {
+    uint32x4_t packed = vld1q_u32(positions + i);
+    float32x4_t x = vcvtq_f32_u32(vandq_u32(packed, mask_11));
+    float32x4_t y = vcvtq_f32_u32(vandq_u32(vshrq_n_u32(packed, 11), mask_11));
+    float32x4_t z = vcvtq_f32_u32(vshrq_n_u32(packed, 22));
+    // Separate multiply and add (not vfma), to match the scalar path.
+    x = vaddq_f32(vmulq_f32(x, scale_x), min_x);
+    y = vaddq_f32(vmulq_f32(y, scale_y), min_y);
+    z = vaddq_f32(vmulq_f32(z, scale_z), min_z);
+
+    float32x4_t clip[4];
+    transform(x, y, z, m, clip);
+    uint32x4_t outside = is_outside_frustum(clip);
+    if (num_cull_views != 0) {
+      // Culled only if outside of all views.
+      outside = vdupq_n_u32(0xFFFFFFFF);
+      for (uint32_t view = 0; view < num_cull_views; ++view) {
+        float32x4_t cull_clip[4];
+        transform(x, y, z, cull_m[view], cull_clip);
+        outside = vandq_u32(outside, is_outside_frustum(cull_clip));
+      }
+    }
+
+    uint32x4_t distance;
+    if (is_clip_depth) {
+      // maxnm returns the non-NaN operand, matching `saturate`.
+      float32x4_t depth =
+          vminq_f32(vmaxnmq_f32(vdivq_f32(clip[2], clip[3]), zero), one);
+      distance = vcvtq_u32_f32(vmulq_f32(depth, scale));
+    } else {
+      float depths[4];
+      uint32_t lanes[4];
+      vst1q_f32(depths, clip[3]);
+      for (uint32_t lane = 0; lane < 4; ++lane) {
+        lanes[lane] = encode_view_depth(depths[lane], params);
+      }
+      distance = vld1q_u32(lanes);
+    }
+    if (params.front_to_back) {
+      distance = vsubq_u32(max_visible_key, distance);
+    }
+    distance = vbslq_u32(outside, not_visible, distance);
+    vst1q_u32(distances + i, distance);
+  }
+#endif
+
+  for (; i < end; ++i) {
+    distances[i] = compute_distance(positions[i], params);
+  }
+}
+}  // namespace
+
+DistanceParams get_valid_distance_params(const DistanceParams& params) {
+  DistanceParams valid = params;
+  valid.precision = get_distance_precision(params);
+  // Written so that NaN is replaced too.
+  if (!(valid.distance_near_cm >= min_distance_near_cm)) {
+    valid.distance_near_cm = min_distance_near_cm;
+  }
+  if (!(valid.distance_far_cm >= 2.f * valid.distance_near_cm)) {
+    valid.distance_far_cm = 2.f * valid.distance_near_cm;
+  }
+  return valid;
+}
+
+void compute_distances(std::span<const uint32_t> positions,
+                       const DistanceParams& params,
+                       std::span<uint32_t> distances) {
+  SPLAT_TRACE_STAGE(TraceStage::ComputeDistances);
+  SPLAT_TRACE_COUNT(TraceStage::ComputeDistances,
+                    positions.size_bytes() + distances.size_bytes(),
+                    positions.size());
+
+  DistanceParams valid_params = get_valid_distance_params(params);
+  import::parallel_for(
+      positions.size(), min_splats_per_task, [&](size_t begin, size_t end) {
+        SPLAT_TRACE_SCOPE("compute_distances_range");
+        compute_distances_range(positions.data(), valid_params,
+                                distances.data(), begin, end);
+      });
+}
+
+void compute_distances_batch(std::span<const uint32_t> positions,
+                             const DistanceParams& params,
+                             std::span<uint32_t> distances) {
+  compute_distances_range(positions.data(), get_valid_distance_params(params),
+                          distances.data(), 0, positions.size());
+}
+
+uint32_t SplatSorter::sort(std::span<const uint32_t> positions,
+                           const DistanceParams& params,
+                           std::span<SortedSplat> sorted) {
+  distances.resize(positions.size());
+  compute_distances(positions, params, distances);
+  return sort_distances(distances, sorted, get_distance_precision(params),
+                        get_distance_not_visible(params));
+}
+
+uint32_t SplatSorter::sort_subset(std::span<const uint32_t> positions,
+                                  std::span<const uint32_t> indices,
+                                  const DistanceParams& params,
+                                  std::span<SortedSplat> sorted) {
+  subset_positions.resize(indices.size());
+  import::parallel_for(
+      indices.size(), min_splats_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          subset_positions[i] = positions[indices[i]];
+        }
+      });
+  uint32_t num_visible = sort(subset_positions, params, sorted);
+  import::parallel_for(
+      indices.size(), min_splats_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          sorted[i].index = indices[sorted[i].index];
+        }
+      });
+  return num_visible;
+}
+
+uint32_t SplatSorter::sort_distances(std::span<const uint32_t> keys,
+                                     std::span<SortedSplat> sorted,
+                                     uint32_t key_bits, uint32_t not_visible) {
+  SPLAT_TRACE_STAGE(TraceStage::Sort);
+  uint32_t num_visible = sort_keys(keys, sorted, key_bits, not_visible);
+  SPLAT_TRACE_COUNT(TraceStage::Sort,
+                    keys.size() * (sizeof(uint32_t) + sizeof(SortedSplat)) +
+                        uint64_t{(key_bits - 1) / radix_bits} * num_visible *
+                            2 * sizeof(SortedSplat),
+                    keys.size());
+  return num_visible;
+}
+
+uint32_t SplatSorter::sort_keys(std::span<const uint32_t> keys,
+                                std::span<SortedSplat> sorted,
+                                uint32_t key_bits, uint32_t not_visible) {
+  size_t num_splats = keys.size();
+  if (num_splats == 0) {
+    return 0;
+  }
+  scratch.resize(num_splats);
+
+  uint32_t max_tasks = import::get_num_ranges(num_splats, min_splats_per_task);
+  histograms.resize(max_tasks * radix_size);
+  std::vector<size_t> tail_offsets(max_tasks + 1);
+
+  /**
+   * Converts per-task histograms to per-task scatter offsets, in place.
+   * Buckets are laid out in key order, and within a bucket, in task order,
+   * which keeps the sort stable.
+   *
+   * @return Whether the digit is identical for all keys, in which case the
+   * pass would not reorder anything.
+   */
+  auto to_offsets = [&](uint32_t num_tasks) {
+    uint32_t offset = 0;
+    uint32_t num_used_buckets = 0;
+    for (uint32_t bucket = 0; bucket < radix_size; ++bucket) {
+      uint32_t bucket_size = 0;
+      for (uint32_t task = 0; task < num_tasks; ++task) {
+        uint32_t& count = histograms[task * radix_size + bucket];
+        bucket_size += count;
+        uint32_t task_offset = offset;
+        offset += count;
+        count = task_offset;
+      }
+      num_used_buckets += bucket_size != 0;
+    }
+    return num_used_buckets <= 1;
+  };
+
+  /**
+   * First pass: histogram of the lowest digit of visible keys, and count of
+   * culled splats per task.
+   *
+   * Culled splats always sort last, so rather than carrying them through every
+   * pass, they're written straight to the tail of the output, in index order.
+   * Subsequent passes then only touch visible splats.
+   */
+  uint32_t num_tasks = max_tasks;
+  auto get_begin = [&](size_t count, uint32_t task) {
+    return count * task / num_tasks;
+  };
+
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    SPLAT_TRACE_SCOPE("radix_histogram");
+    uint32_t* histogram = &histograms[task * radix_size];
+    std::fill(histogram, histogram + radix_size, 0);
+    size_t num_not_visible = 0;
+    for (size_t i = get_begin(num_splats, task),
+                end = get_begin(num_splats, task + 1);
+         i < end; ++i) {
+      uint32_t key = keys[i];
+      bool is_visible = key != not_visible;
+      histogram[key & radix_mask] += is_visible;
+      num_not_visible += !is_visible;
+    }
+    tail_offsets[task + 1] = num_not_visible;
+  });
+
+  size_t num_not_visible = 0;
+  for (uint32_t task = 0; task < num_tasks; ++task) {
+    num_not_visible += tail_offsets[task + 1];
+  }
+  size_t num_visible = num_splats - num_not_visible;
+  tail_offsets[0] = num_visible;
+  for (uint32_t task = 0; task < num_tasks; ++task) {
+    tail_offsets[task + 1] += tail_offsets[task];
+  }
+
+  uint32_t num_passes = (key_bits + radix_bits - 1) / radix_bits;
+
+  // Pick the first destination such that the last pass lands in `sorted`.
+  SortedSplat* dst = num_passes % 2 == 1 ? sorted.data() : scratch.data();
+  SortedSplat* src = nullptr;
+
+  to_offsets(num_tasks);
+  import::run_tasks(num_tasks, [&](uint32_t task) {
+    SPLAT_TRACE_SCOPE("radix_scatter");
+    uint32_t* offsets = &histograms[task * radix_size];
+    size_t tail_offset = tail_offsets[task];
+    for (size_t i = get_begin(num_splats, task),
+                end = get_begin(num_splats, task + 1);
+         i < end; ++i) {
+      uint32_t key = keys[i];
+      SortedSplat splat{static_cast<uint32_t>(i), key};
+      if (key != not_visible) {
+        dst[offsets[key & radix_mask]++] = splat;
+      } else {
+        sorted[tail_offset++] = splat;
+      }
+    }
+  });
+  src = dst;
+  dst = dst == sorted.data() ? scratch.data() : sorted.data();
+
+  // Remaining passes, over visible splats only.
+  num_tasks = import::get_num_ranges(num_visible, min_splats_per_task);
+  for (uint32_t pass = 1; pass < num_passes; ++pass) {
+    uint32_t shift = pass * radix_bits;
+
+    import::run_tasks(num_tasks, [&](uint32_t task) {
+      SPLAT_TRACE_SCOPE("radix_histogram");
+      uint32_t* histogram = &histograms[task * radix_size];
+      std::fill(histogram, histogram + radix_size, 0);
+      for (size_t i = get_begin(num_visible, task),
+                  end = get_begin(num_visible, task + 1);
+           i < end; ++i) {
+        ++histogram[(src[i].distance >> shift) & radix_mask];
+      }
+    });
+
+    // All keys share this digit, so the pass wouldn't change the order.
+    if (to_offsets(num_tasks)) {
+      continue;
+    }
+
+    import::run_tasks(num_tasks, [&](uint32_t task) {
+      SPLAT_TRACE_SCOPE("radix_scatter");
+      uint32_t* offsets = &histograms[task * radix_size];
+      for (size_t i = get_begin(num_visible, task),
+                  end = get_begin(num_visible, task + 1);
+           i < end; ++i) {
+        SortedSplat splat = src[i];
+        dst[offsets[(splat.distance >> shift) & radix_mask]++] = splat;
+      }
+    });
+
+    std::swap(src, dst);
+  }
+
+  // Skipped passes may leave the result in scratch.
+  if (src != sorted.data()) {
+    import::parallel_for(num_visible, min_splats_per_task,
+                         [&](size_t begin, size_t end) {
+                           std::memcpy(&sorted[begin], &src[begin],
+                                       (end - begin) * sizeof(SortedSplat));
+                         });
+  }
+
+  return static_cast<uint32_t>(num_visible);
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,217 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "render/splat_constants.h"
+#include "render/splat_unpacking.h"
+
+namespace render {
+/**
+ * Max number of views culled against by `compute_distance.cs.hlsl`.
+ */
+constexpr uint32_t max_cull_views = 2;
+
+/**
+ * Shader constants consumed by `compute_distance.cs.hlsl`.
+ */
+struct DistanceParams {
+  /**
+   * Projection which keys are computed from, and, unless `num_cull_views` is
+   * set, which splats are culled against.
+   */
+  Float4x4 local_to_clip = Float4x4::identity();
+  Float3 pos_scale_cm;
+  Float3 pos_min_cm;
+
+  /**
+   * If non-zero, splats are culled only if outside of all of these views,
+   * rather than outside of `local_to_clip`. Matches `WITH_STEREO_SORT`, where
+   * both eyes share one sort (see `make_stereo_distance_params`).
+   */
+  uint32_t num_cull_views = 0;
+  Float4x4 cull_local_to_clip[max_cull_views];
+
+  /**
+   * Key encoding and number of key bits, matching `DISTANCE_ENCODING` and
+   * `DISTANCE_PRECISION`. Sorters follow these, as clamped by
+   * `get_valid_distance_params`.
+   */
+  DistanceEncoding encoding = DistanceEncoding::ClipDepth;
+  uint32_t precision = distance_precision;
+  /**
+   * View depth range over which keys are distributed, for all encodings but
+   * `ClipDepth`. Splats outside of the range are clamped to it.
+   */
+  float distance_near_cm = 10.f;
+  float distance_far_cm = 100000.f;
+  /**
+   * Reverses the keys of visible splats, so that sorting them in ascending
+   * order draws front-to-back, matching `FRONT_TO_BACK`. Culled splats keep
+   * the highest key.
+   */
+  bool front_to_back = false;
+};
+
+/**
+ * Smallest `DistanceParams::distance_near_cm` keys are computed with. Keys of
+ * view depth are only defined, and distinct from the key of culled splats,
+ * for positive depths.
+ */
+constexpr float min_distance_near_cm = 1e-3f;
+
+/**
+ * @return Key bits used for `params`: `precision`, clamped to [1, 24], as
+ * scaled keys are computed in float, or to [8, 32] for `FloatFlip`, whose
+ * keys start with the 8 exponent bits of depths. `FloatFlip` needs at least
+ * 24 bits for its mantissa to separate splats; see `DISTANCE_ENCODING`.
+ */
+inline uint32_t get_distance_precision(const DistanceParams& params) {
+  return params.encoding == DistanceEncoding::FloatFlip
+             ? std::clamp(params.precision, 8u, 32u)
+             : std::clamp(params.precision, 1u, 24u);
+}
+
+/**
+ * @return Key of culled splats, given the key precision of `params`.
+ */
+inline uint32_t get_distance_not_visible(const DistanceParams& params) {
+  return get_distance_not_visible(get_distance_precision(params));
+}
+
+/**
+ * Keys are always computed from these, so that they neither overflow nor
+ * collide with `get_distance_not_visible`.
+ *
+ * @return `params`, with `precision` clamped by `get_distance_precision`,
+ * `distance_near_cm` raised to at least `min_distance_near_cm`, and
+ * `distance_far_cm` to at least twice that.
+ */
+SPLAT_EXPORT_API DistanceParams
+get_valid_distance_params(const DistanceParams& params);
+
+/**
+ * Element of `Buffer<uint2> indices`, as read by `render_splat.vs.hlsl` when
+ * `GPU_SORT` is not defined.
+ */
+struct SortedSplat {
+  uint32_t index = 0;
+  uint32_t distance = 0;
+};
+static_assert(sizeof(SortedSplat) == 2 * sizeof(uint32_t),
+              "Must match the layout of Buffer<uint2>.");
+
+/**
+ * CPU mirror of `compute_distance.cs.hlsl`: writes the sort key of each splat,
+ * or `get_distance_not_visible(params)` for splats outside of the frustum.
+ *
+ * Vectorized with SSE2/NEON where available: fully so for `ClipDepth` keys,
+ * while other encodings vectorize transformation and culling, then encode each
+ * lane. Runs in parallel.
+ *
+ * @param positions - Packed x11y11z10 positions.
+ * @param params - View and unpacking constants.
+ * @param distances - Output keys, of the same size as `positions`.
+ */
+SPLAT_EXPORT_API void compute_distances(std::span<const uint32_t> positions,
+                                        const DistanceParams& params,
+                                        std::span<uint32_t> distances);
+
+/**
+ * Single-threaded, untraced variant of `compute_distances`, for small batches
+ * computed from within a caller's own task.
+ */
+SPLAT_EXPORT_API void compute_distances_batch(
+    std::span<const uint32_t> positions, const DistanceParams& params,
+    std::span<uint32_t> distances);
+
+/**
+ * CPU sorting engine, producing the index buffer consumed by
+ * `render_splat.vs.hlsl` when `GPU_SORT` is not defined.
+ *
+ * Sorting is a parallel LSD radix sort over 8-bit digits, so 16-bit keys take
+ * two passes over the data (and 32-bit keys, four). Splats are ordered by
+ * ascending key, which is back-to-front under the reversed-Z projections used
+ * by the engine (or front-to-back, with `DistanceParams::front_to_back`), and
+ * places culled splats (`get_distance_not_visible`) at the end. Culled splats
+ * are moved to the end during the first pass, so only visible splats pay for
+ * subsequent passes. The sort is stable, so output is deterministic.
+ *
+ * Scratch memory is retained between calls; keep one sorter per asset (or per
+ * thread) to avoid per-frame allocations.
+ */
+class SplatSorter {
+ public:
+  /**
+   * Computes distances for, and sorts, all splats.
+   *
+   * @param positions - Packed x11y11z10 positions.
+   * @param params - View and unpacking constants.
+   * @param sorted - Output (index, distance) pairs, of the same size as
+   * `positions`.
+   * @return Number of visible splats, i.e. the number of leading entries of
+   * `sorted` that need to be drawn.
+   */
+  SPLAT_EXPORT_API uint32_t sort(std::span<const uint32_t> positions,
+                                 const DistanceParams& params,
+                                 std::span<SortedSplat> sorted);
+
+  /**
+   * Computes distances for, and sorts, a subset of splats, e.g. a cut from
+   * `select_lod_cut`.
+   *
+   * @param positions - Packed x11y11z10 positions of all splats.
+   * @param indices - Splats to sort.
+   * @param params - View and unpacking constants.
+   * @param sorted - Output (index, distance) pairs, of the same size as
+   * `indices`. Indices are into `positions`.
+   * @return Number of visible splats.
+   */
+  SPLAT_EXPORT_API uint32_t sort_subset(std::span<const uint32_t> positions,
+                                        std::span<const uint32_t> indices,
+                                        const DistanceParams& params,
+                                        std::span<SortedSplat> sorted);
+
+  /**
+   * Sorts splats by precomputed keys.
+   *
+   * @param keys - Key of each splat, `not_visible` if culled.
+   * @param sorted - Output (index, distance) pairs, of the same size as
+   * `keys`.
+   * @param key_bits - Number of significant bits in each key.
+   * @param not_visible - Key marking culled splats.
+   * @return Number of visible splats.
+   */
+  SPLAT_EXPORT_API uint32_t
+  sort_distances(std::span<const uint32_t> keys,
+                 std::span<SortedSplat> sorted,
+                 uint32_t key_bits = distance_precision,
+                 uint32_t not_visible = distance_not_visible);
+
+  /**
+   * Same as `sort_distances`, but without tracing, for callers that already
+   * account for the sort in their own stage, e.g. `HierarchicalSorter`.
+   */
+  SPLAT_EXPORT_API uint32_t
+  sort_keys(std::span<const uint32_t> keys, std::span<SortedSplat> sorted,
+            uint32_t key_bits = distance_precision,
+            uint32_t not_visible = distance_not_visible);
+
+  /**
+   * @return Keys computed by the last call to `sort`.
+   */
+  std::span<const uint32_t> get_distances() const { return distances; }
+
+ private:
+  std::vector<uint32_t> distances;
+  std::vector<uint32_t> subset_positions;
+  std::vector<SortedSplat> scratch;
+  std::vector<uint32_t> histograms;
+};
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,109 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_sort_service.h"
+
+#include "import/splat_tracing.h"
+
+namespace render {
+SplatSortService::SplatSortService(std::span<const uint32_t> positions,
+                                   const IncrementalSortSettings& settings)
+    : positions(positions), sorter(settings) {
+  worker = std::thread([this] { run(); });
+}
+
+SplatSortService::~SplatSortService() {
+  {
+    std::lock_guard lock(mutex);
+    is_stopping = true;
+  }
+  condition.notify_all();
+  worker.join();
+}
+
+void SplatSortService::submit(const DistanceParams& params, uint64_t frame) {
+  {
+    std::lock_guard lock(mutex);
+    if (has_pending) {
+      num_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    pending_params = params;
+    pending_frame = frame;
+    has_pending = true;
+  }
+  condition.notify_all();
+}
+
+SortedFrame SplatSortService::acquire(uint64_t frame) {
+  SortedFrame result;
+  if (middle.load(std::memory_order_relaxed) & fresh_bit) {
+    // Acquire pairs with the worker's release, making the buffer's contents
+    // visible. The front buffer is handed back to the worker, not fresh.
+    uint32_t previous = middle.exchange(front, std::memory_order_acq_rel);
+    front = previous & buffer_index_mask;
+  }
+
+  const Buffer& buffer = buffers[front];
+  result.is_new = buffer.order_version != acquired_order_version;
+  acquired_order_version = buffer.order_version;
+  result.splats = buffer.splats;
+  result.num_visible = buffer.num_visible;
+  result.sorted_frame = buffer.frame;
+  result.age = frame > buffer.frame ? frame - buffer.frame : 0;
+  result.stats = buffer.stats;
+  return result;
+}
+
+void SplatSortService::wait_idle() {
+  std::unique_lock lock(mutex);
+  condition.wait(lock, [this] { return !has_pending && !is_busy; });
+}
+
+void SplatSortService::run() {
+  while (true) {
+    DistanceParams params;
+    uint64_t frame = 0;
+    {
+      std::unique_lock lock(mutex);
+      condition.wait(lock, [this] { return has_pending || is_stopping; });
+      if (is_stopping) {
+        return;
+      }
+      params = pending_params;
+      frame = pending_frame;
+      has_pending = false;
+      is_busy = true;
+    }
+
+    {
+      SPLAT_TRACE_SCOPE("sort_service");
+      Buffer& buffer = buffers[back];
+      buffer.num_visible = sorter.sort(positions, params);
+      if (sorter.get_stats().result != IncrementalSortResult::Skipped) {
+        ++order_version;
+      }
+      // Skipped sorts leave the order as-is, so it may not need copying.
+      if (buffer.order_version != order_version) {
+        std::span<const SortedSplat> sorted = sorter.get_sorted();
+        buffer.splats.assign(sorted.begin(), sorted.end());
+        buffer.order_version = order_version;
+      }
+      buffer.frame = frame;
+      buffer.stats = sorter.get_stats();
+    }
+
+    // Publish the back buffer as the fresh middle one, and reuse whichever
+    // buffer was in the middle, whether or not it was ever acquired.
+    uint32_t previous =
+        middle.exchange(back | fresh_bit, std::memory_order_acq_rel);
+    back = previous & buffer_index_mask;
+
+    {
+      std::lock_guard lock(mutex);
+      is_busy = false;
+    }
+    condition.notify_all();
+  }
+}
+}  // namespace render
\ No newline at end of file
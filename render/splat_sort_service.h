@@ -0,0 +1,169 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "render/splat_incremental_sort.h"
+
+namespace render {
+/**
+ * Newest sorted order available to the render thread, as returned by
+ * `SplatSortService::acquire`.
+ */
+struct SortedFrame {
+  /**
+   * (index, distance) pairs, laid out as the `Buffer<uint2>` read by
+   * `render_splat.vs.hlsl`. Empty until the first sort completes.
+   */
+  std::span<const SortedSplat> splats;
+  uint32_t num_visible = 0;
+  /**
+   * Frame number passed to `submit` along with the view that was sorted.
+   */
+  uint64_t sorted_frame = 0;
+  /**
+   * Frames between the view that was sorted and the one being rendered.
+   * 0 if sorting kept up.
+   */
+  uint64_t age = 0;
+  /**
+   * Whether a new order was sorted since the previous call to `acquire`, i.e.
+   * whether it needs to be uploaded. Skipped sorts republish the same order,
+   * only updating `sorted_frame`, so don't set this.
+   */
+  bool is_new = false;
+  /**
+   * How the sort was produced.
+   */
+  IncrementalSortStats stats;
+};
+
+/**
+ * Runs sorting on a dedicated worker thread, so that its latency overlaps
+ * rendering rather than adding to every frame.
+ *
+ * The render thread submits the latest view each frame, and picks up the
+ * newest completed order without blocking. Views submitted while the worker
+ * is busy replace each other, so the worker always sorts the latest one.
+ *
+ * Completed orders are exchanged through a lock-free triple buffer: the worker
+ * fills the back buffer, then swaps it with the middle one; `acquire` swaps the
+ * middle buffer with the front one if it's newer. The front buffer is never
+ * touched by the worker, so it remains valid until the next `acquire`.
+ *
+ * If the worker keeps up, orders lag rendering by at most one frame.
+ */
+class SplatSortService {
+ public:
+  /**
+   * Starts the worker.
+   *
+   * @param positions - Packed x11y11z10 positions. Must outlive the service.
+   * @param settings - Settings of the worker's incremental sorter.
+   */
+  SPLAT_EXPORT_API explicit SplatSortService(
+      std::span<const uint32_t> positions,
+      const IncrementalSortSettings& settings = IncrementalSortSettings());
+
+  /**
+   * Stops the worker, waiting for any sort in flight to complete.
+   */
+  SPLAT_EXPORT_API ~SplatSortService();
+
+  SplatSortService(const SplatSortService&) = delete;
+  SplatSortService& operator=(const SplatSortService&) = delete;
+
+  /**
+   * Requests a sort for a new view, replacing any request which the worker
+   * hasn't started yet. Never waits for sorting.
+   *
+   * @param params - View and unpacking constants.
+   * @param frame - Monotonically increasing frame number.
+   */
+  SPLAT_EXPORT_API void submit(const DistanceParams& params, uint64_t frame);
+
+  /**
+   * Picks up the newest completed order, without blocking. The returned span
+   * remains valid until the next call to `acquire`.
+   *
+   * Must only be called from one thread (typically the render thread).
+   *
+   * @param frame - Frame number being rendered, to compute `age`.
+   * @return Newest completed order.
+   */
+  SPLAT_EXPORT_API SortedFrame acquire(uint64_t frame);
+
+  /**
+   * Blocks until all submitted views have been sorted. Useful for tests and
+   * for the first frame, where there is no previous order to fall back on.
+   */
+  SPLAT_EXPORT_API void wait_idle();
+
+  /**
+   * @return Number of submitted views which were replaced before the worker
+   * could sort them.
+   */
+  uint64_t get_num_dropped() const {
+    return num_dropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Buffer {
+    std::vector<SortedSplat> splats;
+    uint32_t num_visible = 0;
+    uint64_t frame = 0;
+    IncrementalSortStats stats;
+    /**
+     * Value of `order_version` when `splats` was copied.
+     */
+    uint64_t order_version = 0;
+  };
+
+  /**
+   * Bits of `middle` holding the index of the middle buffer. The remaining bit
+   * marks it as completed since it was last acquired.
+   */
+  static constexpr uint32_t buffer_index_mask = 0x3;
+  static constexpr uint32_t fresh_bit = 0x4;
+
+  void run();
+
+  std::span<const uint32_t> positions;
+  IncrementalSorter sorter;
+  /**
+   * Incremented whenever the sorter's order changes. Starts above the initial
+   * `Buffer::order_version`, as no order has been copied yet.
+   */
+  uint64_t order_version = 1;
+
+  std::array<Buffer, 3> buffers;
+  uint32_t back = 0;
+  std::atomic<uint32_t> middle = 1;
+  uint32_t front = 2;
+  /**
+   * `Buffer::order_version` of the order last returned by `acquire`.
+   */
+  uint64_t acquired_order_version = 0;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  DistanceParams pending_params;
+  uint64_t pending_frame = 0;
+  bool has_pending = false;
+  bool is_busy = false;
+  bool is_stopping = false;
+  std::atomic<uint64_t> num_dropped = 0;
+
+  std::thread worker;
+};
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,124 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_stereo_sort.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "import/splat_parallel.h"
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+
+/**
+ * Adjacent pair counts over a range of the shared order, along with the keys
+ * at either end, so that ranges can be joined.
+ */
+struct RangeErrors {
+  uint64_t num_misordered = 0;
+  uint64_t num_pairs = 0;
+  uint32_t max_key_error = 0;
+  bool is_empty = true;
+  uint32_t first = 0;
+  uint32_t last = 0;
+};
+}  // namespace
+
+Float4x4 get_midpoint_local_to_clip(const Float4x4& left_local_to_clip,
+                                    const Float4x4& right_local_to_clip) {
+  Float4x4 result;
+  for (uint32_t r = 0; r < 4; ++r) {
+    for (uint32_t c = 0; c < 4; ++c) {
+      result.m[r][c] = 0.5f * (left_local_to_clip.m[r][c] +
+                               right_local_to_clip.m[r][c]);
+    }
+  }
+  return result;
+}
+
+DistanceParams make_stereo_distance_params(const Float4x4& left_local_to_clip,
+                                           const Float4x4& right_local_to_clip,
+                                           const Float3& pos_scale_cm,
+                                           const Float3& pos_min_cm) {
+  DistanceParams params;
+  params.local_to_clip =
+      get_midpoint_local_to_clip(left_local_to_clip, right_local_to_clip);
+  params.pos_scale_cm = pos_scale_cm;
+  params.pos_min_cm = pos_min_cm;
+  params.num_cull_views = 2;
+  params.cull_local_to_clip[0] = left_local_to_clip;
+  params.cull_local_to_clip[1] = right_local_to_clip;
+  return params;
+}
+
+StereoOrderErrors measure_stereo_order_errors(
+    std::span<const uint32_t> positions, const DistanceParams& params,
+    std::span<const SortedSplat> sorted, uint32_t num_visible) {
+  StereoOrderErrors errors;
+  num_visible = std::min<uint32_t>(num_visible, sorted.size());
+  std::vector<uint32_t> eye_distances(positions.size());
+  uint32_t num_tasks = import::get_num_ranges(num_visible, min_splats_per_task);
+  std::vector<RangeErrors> ranges(num_tasks);
+
+  uint32_t not_visible = get_distance_not_visible(params);
+  uint32_t num_eyes = std::min<uint32_t>(params.num_cull_views, max_cull_views);
+  for (uint32_t eye = 0; eye < num_eyes; ++eye) {
+    DistanceParams eye_params = params;
+    eye_params.local_to_clip = params.cull_local_to_clip[eye];
+    eye_params.num_cull_views = 0;
+    compute_distances(positions, eye_params, eye_distances);
+
+    // Splats culled for this eye aren't drawn by it, so are skipped over.
+    import::run_tasks(num_tasks, [&](uint32_t task) {
+      RangeErrors& range = ranges[task];
+      range = RangeErrors();
+      for (size_t i = num_visible * task / num_tasks,
+                  end = num_visible * (task + 1) / num_tasks;
+           i < end; ++i) {
+        uint32_t distance = eye_distances[sorted[i].index];
+        if (distance == not_visible) {
+          continue;
+        }
+        if (!range.is_empty) {
+          ++range.num_pairs;
+          if (distance < range.last) {
+            ++range.num_misordered;
+            range.max_key_error =
+                std::max(range.max_key_error, range.last - distance);
+          }
+        } else {
+          range.first = distance;
+          range.is_empty = false;
+        }
+        range.last = distance;
+      }
+    });
+
+    bool is_empty = true;
+    uint32_t last = 0;
+    for (const RangeErrors& range : ranges) {
+      errors.num_misordered[eye] += range.num_misordered;
+      errors.num_pairs[eye] += range.num_pairs;
+      errors.max_key_error[eye] =
+          std::max(errors.max_key_error[eye], range.max_key_error);
+      if (range.is_empty) {
+        continue;
+      }
+      if (!is_empty) {
+        ++errors.num_pairs[eye];
+        if (range.first < last) {
+          ++errors.num_misordered[eye];
+          errors.max_key_error[eye] =
+              std::max(errors.max_key_error[eye], last - range.first);
+        }
+      }
+      last = range.last;
+      is_empty = false;
+    }
+  }
+  return errors;
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,83 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "render/splat_sort.h"
+
+namespace render {
+/**
+ * Computes the midpoint of two eyes' projections, from which keys shared by
+ * both eyes are measured.
+ *
+ * Clip space coordinates are linear in the matrix, so for eyes which only
+ * differ by a translation (the usual case of parallel projections), this is
+ * exactly the projection of a camera halfway between them.
+ *
+ * @param left_local_to_clip - Left eye projection.
+ * @param right_local_to_clip - Right eye projection.
+ * @return Cyclopean projection.
+ */
+SPLAT_EXPORT_API Float4x4
+get_midpoint_local_to_clip(const Float4x4& left_local_to_clip,
+                           const Float4x4& right_local_to_clip);
+
+/**
+ * Builds constants for a single sort shared by both eyes, as consumed by
+ * `compute_distance.cs.hlsl` with `WITH_STEREO_SORT`: keys are measured from
+ * the midpoint view, and splats are culled against the union of both eyes'
+ * frustums.
+ *
+ * Engines with an explicit cyclopean camera may override `local_to_clip` of
+ * the result.
+ *
+ * @param left_local_to_clip - Left eye projection.
+ * @param right_local_to_clip - Right eye projection.
+ * @param pos_scale_cm - Position unpacking scale.
+ * @param pos_min_cm - Position unpacking offset.
+ * @return Constants usable by any sorter.
+ */
+SPLAT_EXPORT_API DistanceParams make_stereo_distance_params(
+    const Float4x4& left_local_to_clip, const Float4x4& right_local_to_clip,
+    const Float3& pos_scale_cm, const Float3& pos_min_cm);
+
+/**
+ * Artifacts caused by sharing one order between both eyes.
+ */
+struct StereoOrderErrors {
+  /**
+   * Per eye, adjacent pairs of splats visible to that eye, which that eye's
+   * own sort would order the other way around.
+   */
+  uint64_t num_misordered[max_cull_views] = {};
+  /**
+   * Per eye, adjacent pairs of splats visible to that eye.
+   */
+  uint64_t num_pairs[max_cull_views] = {};
+  /**
+   * Per eye, largest key difference of a misordered pair. With 16-bit keys,
+   * neighbours often differ by a single key unit, so this separates genuine
+   * artifacts from quantization noise.
+   */
+  uint32_t max_key_error[max_cull_views] = {};
+};
+
+/**
+ * Measures how many pairs a shared order draws in the wrong order for each
+ * eye, compared with sorting per eye. Costs about one key computation per
+ * eye, so is intended for profiling rather than every frame.
+ *
+ * @param positions - Packed x11y11z10 positions.
+ * @param params - Constants of the shared sort, with one cull view per eye.
+ * @param sorted - Shared order.
+ * @param num_visible - Number of leading entries of `sorted` that are drawn.
+ * @return Per eye errors.
+ */
+SPLAT_EXPORT_API StereoOrderErrors measure_stereo_order_errors(
+    std::span<const uint32_t> positions, const DistanceParams& params,
+    std::span<const SortedSplat> sorted, uint32_t num_visible);
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,717 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_transform.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+#include "import/splat_parallel.h"
+#include "import/splat_tracing.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPLAT_TRANSFORM_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SPLAT_TRANSFORM_NEON 1
+#endif
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+using import::TraceStage;
+
+/**
+ * Row vector * matrix, i.e. HLSL's `mul(v, M)`.
+ */
+inline Float3 mul(const Float3& v, const Float3x3& M) {
+  Float3 result;
+  for (uint32_t j = 0; j < 3; ++j) {
+    result[j] = v.x * M.m[0][j] + v.y * M.m[1][j] + v.z * M.m[2][j];
+  }
+  return result;
+}
+
+/**
+ * HLSL's `clamp(scale, -MAX_TRANSFORM_SCALE, MAX_TRANSFORM_SCALE)`.
+ */
+inline float clamp_scale(float scale) {
+  return std::min(std::max(scale, -max_transform_scale), max_transform_scale);
+}
+
+/**
+ * Sums `FootprintCounts` over parallel tasks.
+ */
+struct AtomicFootprintCounts {
+  void add(uint64_t num_culled, uint64_t num_clamped) {
+    this->num_culled += num_culled;
+    this->num_clamped += num_clamped;
+  }
+
+  std::atomic<uint64_t> num_culled = 0;
+  std::atomic<uint64_t> num_clamped = 0;
+};
+
+/**
+ * Outputs of `compute_transforms_range`.
+ */
+struct TransformOutputs {
+  PackedTransform* transforms = nullptr;
+  /**
+   * Optional, one float16 per splat.
+   */
+  uint16_t* opacity_scales = nullptr;
+  /**
+   * Optional. Splats whose distance is `not_visible` are given a zero
+   * transform and aren't counted, and those culled by their footprint are
+   * given `not_visible`.
+   */
+  uint32_t* distances = nullptr;
+  uint32_t not_visible = 0;
+};
+
+/**
+ * Transforms splat `i`, as `compute_transforms_range` does.
+ */
+inline void compute_transform_output(size_t i, const uint32_t* positions,
+                                     const PackedCovariance* covariances,
+                                     const TransformParams& params,
+                                     const TransformOutputs& outputs,
+                                     FootprintCounts& counts) {
+  if (outputs.distances && outputs.distances[i] == outputs.not_visible) {
+    outputs.transforms[i] = PackedTransform();
+    if (outputs.opacity_scales) {
+      outputs.opacity_scales[i] = static_cast<uint16_t>(f32tof16(1.f));
+    }
+    return;
+  }
+  Float4 pos_local =
+      unpack_pos(positions[i], params.pos_scale_cm, params.pos_min_cm);
+  Float4 transform = compute_transform(pos_local, covariances[i], params);
+  float opacity_scale;
+  FootprintAction action = limit_footprint(transform, params, opacity_scale);
+  if (action == FootprintAction::Culled && outputs.distances) {
+    outputs.distances[i] = outputs.not_visible;
+  }
+  counts.num_culled += action == FootprintAction::Culled;
+  counts.num_clamped += action == FootprintAction::Clamped;
+
+  outputs.transforms[i] = pack_transform(transform);
+  if (outputs.opacity_scales) {
+    outputs.opacity_scales[i] = static_cast<uint16_t>(f32tof16(opacity_scale));
+  }
+}
+
+#if defined(SPLAT_TRANSFORM_SSE2) || defined(SPLAT_TRANSFORM_NEON)
+/**
+ * Splats transformed at once by `compute_transforms_range`.
+ */
+constexpr uint32_t num_lanes = 4;
+#endif
+
+#if defined(SPLAT_TRANSFORM_SSE2)
+using Lanes = __m128;
+using IntLanes = __m128i;
+using LaneMask = __m128i;
+
+inline Lanes lanes_set(float value) { return _mm_set1_ps(value); }
+inline Lanes lanes_add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+inline Lanes lanes_sub(Lanes a, Lanes b) { return _mm_sub_ps(a, b); }
+inline Lanes lanes_mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+inline Lanes lanes_div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+inline Lanes lanes_sqrt(Lanes a) { return _mm_sqrt_ps(a); }
+inline Lanes lanes_neg(Lanes a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+// `std::min(a, b)`, i.e. `b < a ? b : a`, including for NaN.
+inline Lanes lanes_min(Lanes a, Lanes b) { return _mm_min_ps(b, a); }
+// `std::max(a, b)`, i.e. `a < b ? b : a`, including for NaN.
+inline Lanes lanes_max(Lanes a, Lanes b) { return _mm_max_ps(b, a); }
+inline LaneMask lanes_less(Lanes a, Lanes b) {
+  return _mm_castps_si128(_mm_cmplt_ps(a, b));
+}
+inline LaneMask lanes_greater(Lanes a, Lanes b) {
+  return _mm_castps_si128(_mm_cmpgt_ps(a, b));
+}
+inline Lanes lanes_select(LaneMask mask, Lanes a, Lanes b) {
+  __m128 m = _mm_castsi128_ps(mask);
+  return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+inline Lanes int_as_lanes(IntLanes a) { return _mm_castsi128_ps(a); }
+inline IntLanes lanes_as_int(Lanes a) { return _mm_castps_si128(a); }
+// Lanes must be below 2^31.
+inline Lanes int_to_lanes(IntLanes a) { return _mm_cvtepi32_ps(a); }
+
+inline IntLanes int_set(uint32_t value) {
+  return _mm_set1_epi32(static_cast<int>(value));
+}
+inline IntLanes int_load(const uint32_t* values) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+}
+inline void int_store(uint32_t* values, IntLanes a) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(values), a);
+}
+inline IntLanes int_add(IntLanes a, IntLanes b) { return _mm_add_epi32(a, b); }
+inline IntLanes int_sub(IntLanes a, IntLanes b) { return _mm_sub_epi32(a, b); }
+inline IntLanes int_and(IntLanes a, IntLanes b) { return _mm_and_si128(a, b); }
+inline IntLanes int_or(IntLanes a, IntLanes b) { return _mm_or_si128(a, b); }
+template <int shift>
+inline IntLanes int_shl(IntLanes a) {
+  return _mm_slli_epi32(a, shift);
+}
+template <int shift>
+inline IntLanes int_shr(IntLanes a) {
+  return _mm_srli_epi32(a, shift);
+}
+inline LaneMask int_equal(IntLanes a, IntLanes b) {
+  return _mm_cmpeq_epi32(a, b);
+}
+// Lanes must be below 2^31.
+inline LaneMask int_less(IntLanes a, IntLanes b) {
+  return _mm_cmplt_epi32(a, b);
+}
+inline LaneMask int_greater(IntLanes a, IntLanes b) {
+  return _mm_cmpgt_epi32(a, b);
+}
+inline IntLanes int_select(LaneMask mask, IntLanes a, IntLanes b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+inline LaneMask mask_and_not(LaneMask a, LaneMask b) {
+  return _mm_andnot_si128(b, a);
+}
+inline uint32_t mask_bits(LaneMask mask) {
+  return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+}
+
+/**
+ * Loads the `x` and `y` words of 4 covariances.
+ */
+inline void load_covariances(const PackedCovariance* covariances, IntLanes& x,
+                             IntLanes& y) {
+  __m128 a = _mm_loadu_ps(reinterpret_cast<const float*>(covariances));
+  __m128 b = _mm_loadu_ps(reinterpret_cast<const float*>(covariances + 2));
+  x = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+  y = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+/**
+ * Stores 4 transforms, from float16 bits in the low 16 bits of each lane.
+ */
+inline void store_transforms(PackedTransform* transforms,
+                             const IntLanes halves[4]) {
+  __m128i xy = _mm_or_si128(halves[0], _mm_slli_epi32(halves[1], 16));
+  __m128i zw = _mm_or_si128(halves[2], _mm_slli_epi32(halves[3], 16));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(transforms),
+                   _mm_unpacklo_epi32(xy, zw));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(transforms + 2),
+                   _mm_unpackhi_epi32(xy, zw));
+}
+#elif defined(SPLAT_TRANSFORM_NEON)
+using Lanes = float32x4_t;
+using IntLanes = uint32x4_t;
+using LaneMask = uint32x4_t;
+
+inline Lanes lanes_set(float value) { return vdupq_n_f32(value); }
+// Separate multiply and add (not vfma), to match the scalar path.
+inline Lanes lanes_add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+inline Lanes lanes_sub(Lanes a, Lanes b) { return vsubq_f32(a, b); }
+inline Lanes lanes_mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+inline Lanes lanes_div(Lanes a, Lanes b) { return vdivq_f32(a, b); }
+inline Lanes lanes_sqrt(Lanes a) { return vsqrtq_f32(a); }
+inline Lanes lanes_neg(Lanes a) { return vnegq_f32(a); }
+// `std::min(a, b)`, i.e. `b < a ? b : a`, including for NaN.
+inline Lanes lanes_min(Lanes a, Lanes b) {
+  return vbslq_f32(vcltq_f32(b, a), b, a);
+}
+// `std::max(a, b)`, i.e. `a < b ? b : a`, including for NaN.
+inline Lanes lanes_max(Lanes a, Lanes b) {
+  return vbslq_f32(vcltq_f32(a, b), b, a);
+}
+inline LaneMask lanes_less(Lanes a, Lanes b) { return vcltq_f32(a, b); }
+inline LaneMask lanes_greater(Lanes a, Lanes b) { return vcgtq_f32(a, b); }
+inline Lanes lanes_select(LaneMask mask, Lanes a, Lanes b) {
+  return vbslq_f32(mask, a, b);
+}
+inline Lanes int_as_lanes(IntLanes a) { return vreinterpretq_f32_u32(a); }
+inline IntLanes lanes_as_int(Lanes a) { return vreinterpretq_u32_f32(a); }
+inline Lanes int_to_lanes(IntLanes a) { return vcvtq_f32_u32(a); }
+
+inline IntLanes int_set(uint32_t value) { return vdupq_n_u32(value); }
+inline IntLanes int_load(const uint32_t* values) { return vld1q_u32(values); }
+inline void int_store(uint32_t* values, IntLanes a) { vst1q_u32(values, a); }
+inline IntLanes int_add(IntLanes a, IntLanes b) { return vaddq_u32(a, b); }
+inline IntLanes int_sub(IntLanes a, IntLanes b) { return vsubq_u32(a, b); }
+inline IntLanes int_and(IntLanes a, IntLanes b) { return vandq_u32(a, b); }
+inline IntLanes int_or(IntLanes a, IntLanes b) { return vorrq_u32(a, b); }
+template <int shift>
+inline IntLanes int_shl(IntLanes a) {
+  return vshlq_n_u32(a, shift);
+}
+template <int shift>
+inline IntLanes int_shr(IntLanes a) {
+  return vshrq_n_u32(a, shift);
+}
+inline LaneMask int_equal(IntLanes a, IntLanes b) { return vceqq_u32(a, b); }
+inline LaneMask int_less(IntLanes a, IntLanes b) { return vcltq_u32(a, b); }
+inline LaneMask int_greater(IntLanes a, IntLanes b) {
+  return vcgtq_u32(a, b);
+}
+inline IntLanes int_select(LaneMask mask, IntLanes a, IntLanes b) {
+  return vbslq_u32(mask, a, b);
+}
+inline LaneMask mask_and_not(LaneMask a, LaneMask b) {
+  return vbicq_u32(a, b);
+}
+inline uint32_t mask_bits(LaneMask mask) {
+  const uint32_t bits[num_lanes] = {1, 2, 4, 8};
+  return vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+}
+
+/**
+ * Loads the `x` and `y` words of 4 covariances.
+ */
+inline void load_covariances(const PackedCovariance* covariances, IntLanes& x,
+                             IntLanes& y) {
+  uint32x4x2_t words =
+      vld2q_u32(reinterpret_cast<const uint32_t*>(covariances));
+  x = words.val[0];
+  y = words.val[1];
+}
+
+/**
+ * Stores 4 transforms, from float16 bits in the low 16 bits of each lane.
+ */
+inline void store_transforms(PackedTransform* transforms,
+                             const IntLanes halves[4]) {
+  uint16x4x4_t interleaved = {{vmovn_u32(halves[0]), vmovn_u32(halves[1]),
+                               vmovn_u32(halves[2]), vmovn_u32(halves[3])}};
+  vst4_u16(reinterpret_cast<uint16_t*>(transforms), interleaved);
+}
+#endif
+
+#if defined(SPLAT_TRANSFORM_SSE2) || defined(SPLAT_TRANSFORM_NEON)
+/**
+ * `f16tof32` of the low 16 bits of each lane. Unlike converting by scaling,
+ * subnormals are exact even when denormals are flushed.
+ */
+inline Lanes lanes_from_f16(IntLanes packed) {
+  IntLanes exponent = int_and(packed, int_set(0x7C00u));
+  // Normal: rebias the exponent. Inf / NaN: also set all exponent bits.
+  IntLanes bits = int_add(int_shl<13>(int_and(packed, int_set(0x7FFFu))),
+                          int_set(0x38000000u));
+  bits = int_or(bits, int_and(int_equal(exponent, int_set(0x7C00u)),
+                              int_set(0x7F800000u)));
+  // Zero / subnormal: mantissa * 2^-24.
+  Lanes subnormal = lanes_mul(int_to_lanes(int_and(packed, int_set(0x3FFu))),
+                              lanes_set(1.f / 16777216.f));
+  Lanes value = lanes_select(int_equal(exponent, int_set(0)), subnormal,
+                             int_as_lanes(bits));
+  return int_as_lanes(int_or(lanes_as_int(value),
+                             int_shl<16>(int_and(packed, int_set(0x8000u)))));
+}
+
+/**
+ * `f32tof16` of each lane, in the low 16 bits.
+ */
+inline IntLanes lanes_to_f16(Lanes value) {
+  IntLanes bits = lanes_as_int(value);
+  IntLanes sign = int_and(int_shr<16>(bits), int_set(0x8000u));
+  IntLanes abs_bits = int_and(bits, int_set(0x7FFFFFFFu));
+
+  // Normal: rebias exponent, then round the 13 dropped mantissa bits to
+  // nearest even.
+  IntLanes half_bits = int_shr<13>(
+      int_add(int_sub(abs_bits, int_set(0x38000000u)),
+              int_add(int_set(0xFFFu),
+                      int_and(int_shr<13>(abs_bits), int_set(1u)))));
+  // Subnormal: adding 0.5 rounds to a multiple of 2^-24 (the float16
+  // subnormal step), to nearest even, leaving it in the low mantissa bits.
+  IntLanes subnormal = int_sub(
+      lanes_as_int(lanes_add(int_as_lanes(abs_bits), lanes_set(.5f))),
+      int_set(0x3F000000u));
+  half_bits = int_select(int_less(abs_bits, int_set(0x38800000u)), subnormal,
+                         half_bits);
+  // Overflow, Inf / NaN (NaN keeps a mantissa bit set).
+  IntLanes infinite = int_or(
+      int_set(0x7C00u),
+      int_and(int_greater(abs_bits, int_set(0x7F800000u)), int_set(0x200u)));
+  half_bits = int_select(int_greater(abs_bits, int_set(0x477FEFFFu)),
+                         infinite, half_bits);
+  return int_or(sign, half_bits);
+}
+
+/**
+ * `clamp_scale` of each lane.
+ */
+inline Lanes lanes_clamp_scale(Lanes scale) {
+  return lanes_min(lanes_max(scale, lanes_set(-max_transform_scale)),
+                   lanes_set(max_transform_scale));
+}
+
+/**
+ * Vector version of `compute_transform` and `limit_footprint`, in the same
+ * order of operations, so results are bitwise identical.
+ */
+class TransformLanes {
+ public:
+  explicit TransformLanes(const TransformParams& params) {
+    for (uint32_t i = 0; i < 4; ++i) {
+      for (uint32_t j = 0; j < 3; ++j) {
+        W[i][j] = lanes_set(params.local_to_view.m[i][j]);
+      }
+    }
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      pos_scale_cm[axis] = lanes_set(params.pos_scale_cm[axis]);
+      pos_min_cm[axis] = lanes_set(params.pos_min_cm[axis]);
+    }
+    two_focal_length = lanes_set(params.two_focal_length);
+    min_radius_pixels = lanes_set(params.min_radius_pixels);
+    max_radius_pixels = lanes_set(params.max_radius_pixels);
+  }
+
+  /**
+   * Transforms 4 splats.
+   *
+   * @param positions - 4 packed x11y11z10 positions.
+   * @param covariances - 4 packed covariances.
+   * @param transforms - Output, after `limit_footprint`.
+   * @param opacity_scales - Output, from `limit_footprint`.
+   * @param culled, clamped - Output, splats culled or clamped by
+   * `limit_footprint`.
+   */
+  void compute(const uint32_t* positions, const PackedCovariance* covariances,
+               Lanes transforms[4], Lanes& opacity_scale, LaneMask& culled,
+               LaneMask& clamped) const {
+    // See `transform.hlsl` for the derivation; names match.
+    IntLanes packed = int_load(positions);
+    const IntLanes mask_11 = int_set(0x7FFu);
+    Lanes pos_local[3] = {int_to_lanes(int_and(packed, mask_11)),
+                          int_to_lanes(int_and(int_shr<11>(packed), mask_11)),
+                          int_to_lanes(int_shr<22>(packed))};
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      pos_local[axis] = lanes_add(
+          lanes_mul(pos_local[axis], pos_scale_cm[axis]), pos_min_cm[axis]);
+    }
+    Lanes pos_view[3];
+    for (uint32_t j = 0; j < 3; ++j) {
+      pos_view[j] = lanes_add(
+          lanes_add(lanes_add(lanes_mul(pos_local[0], W[0][j]),
+                              lanes_mul(pos_local[1], W[1][j])),
+                    lanes_mul(pos_local[2], W[2][j])),
+          W[3][j]);
+    }
+
+    // Fields of `unpack_cov_mat`, as float16 bits.
+    IntLanes cov_x, cov_y;
+    load_covariances(covariances, cov_x, cov_y);
+    const IntLanes mask_e5m5 = int_set(0x7FE0u);
+    const IntLanes mask_s1e5m5 = int_set(0xFFE0u);
+    Lanes xx = lanes_from_f16(int_and(int_shr<17>(cov_y), mask_e5m5));
+    Lanes xy = lanes_from_f16(int_and(int_shr<6>(cov_y), mask_s1e5m5));
+    Lanes xz = lanes_from_f16(int_and(int_shl<5>(cov_y), mask_s1e5m5));
+    Lanes yy = lanes_from_f16(int_and(int_shr<17>(cov_x), mask_e5m5));
+    Lanes yz = lanes_from_f16(int_and(int_shr<6>(cov_x), mask_s1e5m5));
+    Lanes zz = lanes_from_f16(int_and(int_shl<4>(cov_x), int_set(0x7FF0u)));
+    const Lanes sig[3][3] = {{xx, xy, xz}, {xy, yy, yz}, {xz, yz, zz}};
+
+    Lanes scale_x = lanes_div(lanes_neg(pos_view[0]), pos_view[2]);
+    Lanes scale_y = lanes_div(lanes_neg(pos_view[1]), pos_view[2]);
+    Lanes jw_0[3], jw_1[3];
+    for (uint32_t i = 0; i < 3; ++i) {
+      jw_0[i] = lanes_add(W[i][0], lanes_mul(scale_x, W[i][2]));
+      jw_1[i] = lanes_add(W[i][1], lanes_mul(scale_y, W[i][2]));
+    }
+
+    Lanes jw_sig_0[3], jw_sig_1[3];
+    mul(jw_0, sig, jw_sig_0);
+    mul(jw_1, sig, jw_sig_1);
+
+    Lanes sig_p_00 = dot(jw_sig_0, jw_0);
+    Lanes sig_p_01_10 = dot(jw_sig_0, jw_1);
+    Lanes sig_p_11 = dot(jw_sig_1, jw_1);
+
+    Lanes det = lanes_sub(lanes_mul(sig_p_00, sig_p_11),
+                          lanes_mul(sig_p_01_10, sig_p_01_10));
+    Lanes trace = lanes_add(sig_p_00, sig_p_11);
+    Lanes sqrt_disc = lanes_sqrt(lanes_sub(lanes_mul(trace, trace),
+                                           lanes_mul(lanes_set(4.f), det)));
+
+    Lanes two_lmb_0 = lanes_add(trace, sqrt_disc);
+    Lanes two_lmb_1 = lanes_sub(trace, sqrt_disc);
+    Lanes sqrt_two_sigma_0 = lanes_sqrt(two_lmb_0);
+    Lanes sqrt_two_sigma_1 = lanes_sqrt(two_lmb_1);
+
+    Lanes v_0_x = sig_p_01_10;
+    Lanes v_0_y = lanes_sub(lanes_div(two_lmb_0, lanes_set(2.f)), sig_p_00);
+    Lanes inv_length =
+        lanes_div(lanes_set(1.f), lanes_sqrt(lanes_add(
+                                      lanes_mul(v_0_x, v_0_x),
+                                      lanes_mul(v_0_y, v_0_y))));
+    v_0_x = lanes_mul(v_0_x, inv_length);
+    v_0_y = lanes_mul(v_0_y, inv_length);
+
+    Lanes focal_over_depth = lanes_div(two_focal_length, pos_view[2]);
+    Lanes scale_0 = lanes_clamp_scale(
+        lanes_mul(focal_over_depth, sqrt_two_sigma_0));
+    Lanes scale_1 = lanes_clamp_scale(
+        lanes_mul(focal_over_depth, sqrt_two_sigma_1));
+    transforms[0] = lanes_mul(v_0_x, scale_0);
+    transforms[1] = lanes_mul(lanes_neg(v_0_y), scale_1);
+    transforms[2] = lanes_mul(v_0_y, scale_0);
+    transforms[3] = lanes_mul(v_0_x, scale_1);
+
+    // `limit_footprint`.
+    Lanes radius = lanes_mul(
+        lanes_sqrt(lanes_add(lanes_mul(transforms[0], transforms[0]),
+                             lanes_mul(transforms[2], transforms[2]))),
+        lanes_set(radius_sigma_over_sqrt_2 / 2.f));
+    culled = lanes_less(radius, min_radius_pixels);
+    clamped = mask_and_not(lanes_greater(radius, max_radius_pixels), culled);
+    Lanes scale = lanes_div(max_radius_pixels, radius);
+    opacity_scale = lanes_select(
+        clamped,
+        lanes_min(lanes_div(lanes_set(1.f), lanes_mul(scale, scale)),
+                  lanes_set(1.f / min_alpha)),
+        lanes_set(1.f));
+    for (uint32_t i = 0; i < 4; ++i) {
+      transforms[i] = lanes_select(
+          culled, lanes_set(0.f),
+          lanes_select(clamped, lanes_mul(transforms[i], scale),
+                       transforms[i]));
+    }
+  }
+
+ private:
+  /**
+   * Row vector * matrix, i.e. HLSL's `mul(v, M)`.
+   */
+  static void mul(const Lanes v[3], const Lanes M[3][3], Lanes result[3]) {
+    for (uint32_t j = 0; j < 3; ++j) {
+      result[j] = lanes_add(
+          lanes_add(lanes_mul(v[0], M[0][j]), lanes_mul(v[1], M[1][j])),
+          lanes_mul(v[2], M[2][j]));
+    }
+  }
+
+  static Lanes dot(const Lanes a[3], const Lanes b[3]) {
+    return lanes_add(lanes_add(lanes_mul(a[0], b[0]), lanes_mul(a[1], b[1])),
+                     lanes_mul(a[2], b[2]));
+  }
+
+  Lanes W[4][3];
+  Lanes pos_scale_cm[3];
+  Lanes pos_min_cm[3];
+  Lanes two_focal_length;
+  Lanes min_radius_pixels;
+  Lanes max_radius_pixels;
+};
+#endif
+
+/**
+ * Transforms splats [begin, end), 4 at a time where possible.
+ */
+void compute_transforms_range(const uint32_t* positions,
+                              const PackedCovariance* covariances,
+                              const TransformParams& params,
+                              const TransformOutputs& outputs, size_t begin,
+                              size_t end, FootprintCounts& counts) {
+  size_t i = begin;
+
+#if defined(SPLAT_TRANSFORM_SSE2) || defined(SPLAT_TRANSFORM_NEON)
+  const TransformLanes lanes(params);
+  const IntLanes not_visible = int_set(outputs.not_visible);
+  const uint32_t all_lanes = (1u << num_lanes) - 1;
+  for (; i + num_lanes <= end; i += num_lanes) {
+    LaneMask visible = int_set(0xFFFFFFFFu);
+    IntLanes distances = not_visible;
+    if (outputs.distances) {
+      distances = int_load(outputs.distances + i);
+      visible = mask_and_not(visible, int_equal(distances, not_visible));
+    }
+    uint32_t visible_bits = mask_bits(visible);
+    Lanes transforms[4] = {lanes_set(0.f), lanes_set(0.f), lanes_set(0.f),
+                           lanes_set(0.f)};
+    Lanes opacity_scale = lanes_set(1.f);
+    if (visible_bits != 0) {
+      LaneMask culled, clamped;
+      lanes.compute(positions + i, covariances + i, transforms, opacity_scale,
+                    culled, clamped);
+      if (visible_bits != all_lanes) {
+        for (uint32_t j = 0; j < 4; ++j) {
+          transforms[j] =
+              lanes_select(visible, transforms[j], lanes_set(0.f));
+        }
+        opacity_scale = lanes_select(visible, opacity_scale, lanes_set(1.f));
+      }
+      uint32_t culled_bits = mask_bits(culled) & visible_bits;
+      counts.num_culled += std::popcount(culled_bits);
+      counts.num_clamped += std::popcount(mask_bits(clamped) & visible_bits);
+      if (outputs.distances && culled_bits != 0) {
+        int_store(outputs.distances + i,
+                  int_select(culled, not_visible, distances));
+      }
+    }
+
+    IntLanes halves[4];
+    for (uint32_t j = 0; j < 4; ++j) {
+      halves[j] = lanes_to_f16(transforms[j]);
+    }
+    store_transforms(outputs.transforms + i, halves);
+    if (outputs.opacity_scales) {
+      uint32_t opacity_scales[num_lanes];
+      int_store(opacity_scales, lanes_to_f16(opacity_scale));
+      for (uint32_t lane = 0; lane < num_lanes; ++lane) {
+        outputs.opacity_scales[i + lane] =
+            static_cast<uint16_t>(opacity_scales[lane]);
+      }
+    }
+  }
+#endif
+
+  for (; i < end; ++i) {
+    compute_transform_output(i, positions, covariances, params, outputs,
+                             counts);
+  }
+}
+}  // namespace
+
+Float4 compute_transform(const Float4& pos_local,
+                         const PackedCovariance& covariance,
+                         const TransformParams& params) {
+  // See `transform.hlsl` for the derivation; names match.
+  Float3 pos_view = mul(pos_local, params.local_to_view).xyz();
+  Float3x3 sig = unpack_cov_mat(covariance.x, covariance.y);
+  const float(&W)[4][4] = params.local_to_view.m;
+
+  float scale_x = -pos_view.x / pos_view.z;
+  float scale_y = -pos_view.y / pos_view.z;
+
+  Float3 jw_0(W[0][0] + scale_x * W[0][2], W[1][0] + scale_x * W[1][2],
+              W[2][0] + scale_x * W[2][2]);
+  Float3 jw_1(W[0][1] + scale_y * W[0][2], W[1][1] + scale_y * W[1][2],
+              W[2][1] + scale_y * W[2][2]);
+
+  Float3 jw_sig_0 = mul(jw_0, sig);
+  Float3 jw_sig_1 = mul(jw_1, sig);
+
+  float sig_p_00 = dot(jw_sig_0, jw_0);
+  float sig_p_01_10 = dot(jw_sig_0, jw_1);
+  float sig_p_11 = dot(jw_sig_1, jw_1);
+
+  float det = sig_p_00 * sig_p_11 - sig_p_01_10 * sig_p_01_10;
+  float trace = sig_p_00 + sig_p_11;
+  float sqrt_disc = std::sqrt(trace * trace - 4 * det);
+
+  float two_lmb_0 = trace + sqrt_disc;
+  float two_lmb_1 = trace - sqrt_disc;
+  float sqrt_two_sigma_0 = std::sqrt(two_lmb_0);
+  float sqrt_two_sigma_1 = std::sqrt(two_lmb_1);
+
+  float v_0_x = sig_p_01_10;
+  float v_0_y = two_lmb_0 / 2.f - sig_p_00;
+  float inv_length = 1.f / std::sqrt(v_0_x * v_0_x + v_0_y * v_0_y);
+  v_0_x *= inv_length;
+  v_0_y *= inv_length;
+
+  float scale_0 = clamp_scale(params.two_focal_length / pos_view.z *
+                              sqrt_two_sigma_0);
+  float scale_1 = clamp_scale(params.two_focal_length / pos_view.z *
+                              sqrt_two_sigma_1);
+  return Float4(v_0_x * scale_0, -v_0_y * scale_1, v_0_y * scale_0,
+                v_0_x * scale_1);
+}
+
+FootprintAction limit_footprint(Float4& transform,
+                                const TransformParams& params,
+                                float& opacity_scale) {
+  // Transforms are in pixels * 2, and the first column is the major axis.
+  float radius =
+      std::sqrt(transform.x * transform.x + transform.z * transform.z) *
+      (radius_sigma_over_sqrt_2 / 2.f);
+  opacity_scale = 1.f;
+
+  if (radius < params.min_radius_pixels) {
+    transform = Float4();
+    return FootprintAction::Culled;
+  }
+  if (radius > params.max_radius_pixels) {
+    float scale = params.max_radius_pixels / radius;
+    transform = Float4(transform.x * scale, transform.y * scale,
+                       transform.z * scale, transform.w * scale);
+    opacity_scale = std::min(1.f / (scale * scale), 1.f / min_alpha);
+    return FootprintAction::Clamped;
+  }
+  return FootprintAction::Kept;
+}
+
+void compute_transforms(std::span<const uint32_t> positions,
+                        std::span<const PackedCovariance> covariances,
+                        const TransformParams& params,
+                        std::span<PackedTransform> transforms,
+                        std::span<uint16_t> opacity_scales,
+                        FootprintCounts* counts) {
+  SPLAT_TRACE_STAGE(TraceStage::Transform);
+  SPLAT_TRACE_COUNT(TraceStage::Transform,
+                    positions.size_bytes() + covariances.size_bytes() +
+                        transforms.size_bytes() + opacity_scales.size_bytes(),
+                    positions.size());
+
+  TransformOutputs outputs;
+  outputs.transforms = transforms.data();
+  outputs.opacity_scales =
+      opacity_scales.empty() ? nullptr : opacity_scales.data();
+  AtomicFootprintCounts total;
+  import::parallel_for(
+      positions.size(), min_splats_per_task, [&](size_t begin, size_t end) {
+        FootprintCounts task_counts;
+        compute_transforms_range(positions.data(), covariances.data(), params,
+                                 outputs, begin, end, task_counts);
+        total.add(task_counts.num_culled, task_counts.num_clamped);
+      });
+
+  if (counts) {
+    *counts = FootprintCounts{total.num_culled, total.num_clamped};
+  }
+}
+
+void compute_distances_and_transforms(
+    std::span<const uint32_t> positions,
+    std::span<const PackedCovariance> covariances,
+    const DistanceParams& distance_params,
+    const TransformParams& transform_params, std::span<uint32_t> distances,
+    std::span<PackedTransform> transforms, std::span<uint16_t> opacity_scales,
+    FootprintCounts* counts) {
+  compute_distances(positions, distance_params, distances);
+
+  SPLAT_TRACE_STAGE(TraceStage::Transform);
+  SPLAT_TRACE_COUNT(TraceStage::Transform,
+                    distances.size_bytes() + transforms.size_bytes() +
+                        opacity_scales.size_bytes(),
+                    positions.size());
+
+  // The fused kernel unpacks each position once, with the sort's constants.
+  TransformParams params = transform_params;
+  params.pos_scale_cm = distance_params.pos_scale_cm;
+  params.pos_min_cm = distance_params.pos_min_cm;
+  TransformOutputs outputs;
+  outputs.transforms = transforms.data();
+  outputs.opacity_scales =
+      opacity_scales.empty() ? nullptr : opacity_scales.data();
+  outputs.distances = distances.data();
+  outputs.not_visible = get_distance_not_visible(distance_params);
+  AtomicFootprintCounts total;
+  import::parallel_for(
+      positions.size(), min_splats_per_task, [&](size_t begin, size_t end) {
+        FootprintCounts task_counts;
+        compute_transforms_range(positions.data(), covariances.data(), params,
+                                 outputs, begin, end, task_counts);
+        total.add(task_counts.num_culled, task_counts.num_clamped);
+      });
+
+  if (counts) {
+    *counts = FootprintCounts{total.num_culled, total.num_clamped};
+  }
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "render/splat_sort.h"
+#include "render/splat_unpacking.h"
+
+namespace render {
+/**
+ * Shader constants consumed by `compute_transform.cs.hlsl`.
+ */
+struct TransformParams {
+  /**
+   * Only the first three columns are used, as by the shader's `float3`
+   * result.
+   */
+  Float4x4 local_to_view = Float4x4::identity();
+  /**
+   * Focal length in pixels, * 2.
+   */
+  float two_focal_length = 1.f;
+  Float3 pos_scale_cm;
+  Float3 pos_min_cm;
+  /**
+   * With `FOOTPRINT_LIMITS`, radii (in pixels, see `limit_footprint`) below
+   * which splats are culled, and above which they are clamped. The defaults
+   * disable both.
+   */
+  float min_radius_pixels = 0.f;
+  float max_radius_pixels = std::numeric_limits<float>::infinity();
+};
+
+/**
+ * Outcome of `limit_footprint` for a splat.
+ */
+enum class FootprintAction : uint32_t {
+  Kept,
+  Culled,
+  Clamped,
+};
+
+/**
+ * Number of splats affected by each footprint limit, as counted by
+ * `FOOTPRINT_COUNTERS`.
+ */
+struct FootprintCounts {
+  uint64_t num_culled = 0;
+  uint64_t num_clamped = 0;
+};
+
+/**
+ * Element of `Buffer<uint2> covariances`, as read by
+ * `compute_transform.cs.hlsl`.
+ */
+struct PackedCovariance {
+  uint32_t x = 0;
+  uint32_t y = 0;
+};
+static_assert(sizeof(PackedCovariance) == 2 * sizeof(uint32_t),
+              "Must match the layout of Buffer<uint2>");
+
+/**
+ * Element of `RWBuffer<half4> transforms`, as float16 bits.
+ */
+struct PackedTransform {
+  uint16_t x = 0;
+  uint16_t y = 0;
+  uint16_t z = 0;
+  uint16_t w = 0;
+};
+static_assert(sizeof(PackedTransform) == 4 * sizeof(uint16_t),
+              "Must match the layout of RWBuffer<half4>");
+
+/**
+ * CPU mirror of `compute_transform` in `transform.hlsl`: the 2x2 transform of
+ * a quad of radius σ, in pixels * 2.
+ *
+ * Computed in float32, as the shader is. GPUs may contract multiplies and adds
+ * differently, so results agree to within a few float16 ulps rather than
+ * bitwise.
+ *
+ * @param pos_local - Local space position.
+ * @param covariance - Packed covariance.
+ * @param params - View constants.
+ * @return Transform, before packing to float16.
+ */
+SPLAT_EXPORT_API Float4 compute_transform(const Float4& pos_local,
+                                          const PackedCovariance& covariance,
+                                          const TransformParams& params);
+
+/**
+ * CPU mirror of `limit_footprint` in `transform.hlsl`: culls splats whose
+ * quad has a radius (at `radius_sigma`, along its major axis) below
+ * `params.min_radius_pixels`, and scales down those above
+ * `params.max_radius_pixels`, compensating with opacity.
+ *
+ * @param transform - Transform from `compute_transform`. Set to 0 if culled.
+ * @param params - View constants.
+ * @param opacity_scale - Output, factor for the splat's opacity.
+ * @return What was done to the splat.
+ */
+SPLAT_EXPORT_API FootprintAction limit_footprint(Float4& transform,
+                                                 const TransformParams& params,
+                                                 float& opacity_scale);
+
+/**
+ * Rounds a transform to float16, as when written to `transforms`.
+ */
+inline PackedTransform pack_transform(const Float4& transform) {
+  return PackedTransform{static_cast<uint16_t>(f32tof16(transform.x)),
+                         static_cast<uint16_t>(f32tof16(transform.y)),
+                         static_cast<uint16_t>(f32tof16(transform.z)),
+                         static_cast<uint16_t>(f32tof16(transform.w))};
+}
+
+/**
+ * CPU mirror of `compute_transform.cs.hlsl`, with `FOOTPRINT_LIMITS` (which
+ * has no effect with the default limits). Runs in parallel, 4 splats at a time
+ * with SSE2 or NEON.
+ *
+ * Results are bitwise those of `compute_transform` and `limit_footprint`
+ * (other than the sign of NaNs), so agree with the GPU's to within a few
+ * float16 ulps. Subnormal covariances are exact even when denormals are
+ * flushed.
+ *
+ * @param positions - Packed x11y11z10 positions.
+ * @param covariances - Packed covariances.
+ * @param params - View and unpacking constants.
+ * @param transforms - Output, one per splat.
+ * @param opacity_scales - Optional output, one float16 per splat, as written
+ * to `opacity_scales`.
+ * @param counts - Optional output, splats affected by each limit.
+ */
+SPLAT_EXPORT_API void compute_transforms(
+    std::span<const uint32_t> positions,
+    std::span<const PackedCovariance> covariances,
+    const TransformParams& params, std::span<PackedTransform> transforms,
+    std::span<uint16_t> opacity_scales = {}, FootprintCounts* counts = nullptr);
+
+/**
+ * CPU mirror of `compute_distance_transform.cs.hlsl`: keys as written by
+ * `compute_distances`, and transforms as written by `compute_transforms` for
+ * visible splats, or zero for culled ones. Splats culled by their footprint are
+ * given the culled key. Runs in parallel, and vectorized as
+ * `compute_transforms` is.
+ *
+ * @param positions - Packed x11y11z10 positions.
+ * @param covariances - Packed covariances.
+ * @param distance_params - Sort constants. Its unpacking constants are used
+ * for both outputs, as the fused kernel unpacks each position once.
+ * @param transform_params - View constants. Unpacking constants are ignored.
+ * @param distances - Output, one per splat.
+ * @param transforms - Output, one per splat.
+ * @param opacity_scales - Optional output, one float16 per splat.
+ * @param counts - Optional output, splats affected by each limit. Splats
+ * outside the frustum aren't counted.
+ */
+SPLAT_EXPORT_API void compute_distances_and_transforms(
+    std::span<const uint32_t> positions,
+    std::span<const PackedCovariance> covariances,
+    const DistanceParams& distance_params,
+    const TransformParams& transform_params, std::span<uint32_t> distances,
+    std::span<PackedTransform> transforms,
+    std::span<uint16_t> opacity_scales = {}, FootprintCounts* counts = nullptr);
+}  // namespace render
\ No newline at end of file
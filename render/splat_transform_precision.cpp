@@ -0,0 +1,286 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_transform_precision.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "import/splat_parallel.h"
+
+namespace render {
+namespace {
+using import::min_splats_per_task;
+
+/**
+ * Arithmetic in the precision of each stage.
+ */
+class StageMath {
+ public:
+  explicit StageMath(TransformPrecision precision) : precision(precision) {}
+
+  float round(TransformStage stage, float value) const {
+    return precision & get_stage_bit(stage) ? round_to_f16(value) : value;
+  }
+  float add(TransformStage stage, float a, float b) const {
+    return round(stage, round(stage, a) + round(stage, b));
+  }
+  float sub(TransformStage stage, float a, float b) const {
+    return round(stage, round(stage, a) - round(stage, b));
+  }
+  float mul(TransformStage stage, float a, float b) const {
+    return round(stage, round(stage, a) * round(stage, b));
+  }
+  float div(TransformStage stage, float a, float b) const {
+    return round(stage, round(stage, a) / round(stage, b));
+  }
+  float sqrt(TransformStage stage, float a) const {
+    return round(stage, std::sqrt(round(stage, a)));
+  }
+  float dot(TransformStage stage, const Float3& a, const Float3& b) const {
+    return add(stage, add(stage, mul(stage, a.x, b.x), mul(stage, a.y, b.y)),
+               mul(stage, a.z, b.z));
+  }
+  /**
+   * Row vector * matrix, i.e. HLSL's `mul(v, M)`.
+   */
+  Float3 mul(TransformStage stage, const Float3& v, const Float3x3& M) const {
+    Float3 result;
+    for (uint32_t j = 0; j < 3; ++j) {
+      result[j] = dot(stage, v, Float3(M.m[0][j], M.m[1][j], M.m[2][j]));
+    }
+    return result;
+  }
+
+ private:
+  TransformPrecision precision;
+};
+
+/**
+ * `compute_transform`, in float64.
+ *
+ * @return Whether the view depth is positive.
+ */
+bool compute_reference_transform(const Float4& pos_local,
+                                 const PackedCovariance& covariance,
+                                 const TransformParams& params,
+                                 double transform[4]) {
+  const float(&W)[4][4] = params.local_to_view.m;
+  double pos_view[3];
+  for (uint32_t j = 0; j < 3; ++j) {
+    pos_view[j] = double(pos_local.x) * W[0][j] +
+                  double(pos_local.y) * W[1][j] +
+                  double(pos_local.z) * W[2][j] + double(W[3][j]);
+  }
+  if (!(pos_view[2] > 0.)) {
+    return false;
+  }
+  Float3x3 sig = unpack_cov_mat(covariance.x, covariance.y);
+
+  double scale_x = -pos_view[0] / pos_view[2];
+  double scale_y = -pos_view[1] / pos_view[2];
+  double jw[2][3];
+  for (uint32_t i = 0; i < 3; ++i) {
+    jw[0][i] = W[i][0] + scale_x * W[i][2];
+    jw[1][i] = W[i][1] + scale_y * W[i][2];
+  }
+  double jw_sig[2][3] = {};
+  for (uint32_t row = 0; row < 2; ++row) {
+    for (uint32_t j = 0; j < 3; ++j) {
+      for (uint32_t i = 0; i < 3; ++i) {
+        jw_sig[row][j] += jw[row][i] * sig.m[i][j];
+      }
+    }
+  }
+  double sig_p_00 = 0.;
+  double sig_p_01_10 = 0.;
+  double sig_p_11 = 0.;
+  for (uint32_t i = 0; i < 3; ++i) {
+    sig_p_00 += jw_sig[0][i] * jw[0][i];
+    sig_p_01_10 += jw_sig[0][i] * jw[1][i];
+    sig_p_11 += jw_sig[1][i] * jw[1][i];
+  }
+
+  double det = sig_p_00 * sig_p_11 - sig_p_01_10 * sig_p_01_10;
+  double trace = sig_p_00 + sig_p_11;
+  double sqrt_disc = std::sqrt(trace * trace - 4. * det);
+  double two_lmb_0 = trace + sqrt_disc;
+  double two_lmb_1 = trace - sqrt_disc;
+
+  double v_0_x = sig_p_01_10;
+  double v_0_y = two_lmb_0 / 2. - sig_p_00;
+  double inv_length = 1. / std::sqrt(v_0_x * v_0_x + v_0_y * v_0_y);
+  v_0_x *= inv_length;
+  v_0_y *= inv_length;
+
+  // Clamped as by `compute_transform`, which is exact.
+  double max_scale = max_transform_scale;
+  double scale_0 =
+      std::clamp(params.two_focal_length / pos_view[2] * std::sqrt(two_lmb_0),
+                 -max_scale, max_scale);
+  double scale_1 =
+      std::clamp(params.two_focal_length / pos_view[2] * std::sqrt(two_lmb_1),
+                 -max_scale, max_scale);
+  transform[0] = v_0_x * scale_0;
+  transform[1] = -v_0_y * scale_1;
+  transform[2] = v_0_y * scale_0;
+  transform[3] = v_0_x * scale_1;
+  return true;
+}
+
+/**
+ * Ellipse drawn by a transform T, i.e. the symmetric T * T^T, as its (0, 0),
+ * (0, 1) and (1, 1) entries.
+ */
+inline void get_ellipse(const double t[4], double ellipse[3]) {
+  ellipse[0] = t[0] * t[0] + t[1] * t[1];
+  ellipse[1] = t[0] * t[2] + t[1] * t[3];
+  ellipse[2] = t[2] * t[2] + t[3] * t[3];
+}
+
+/**
+ * Frobenius norm of a symmetric 2x2 matrix, from its 3 unique entries.
+ */
+inline double get_norm(const double m[3]) {
+  return std::sqrt(m[0] * m[0] + 2. * m[1] * m[1] + m[2] * m[2]);
+}
+}  // namespace
+
+const char* get_transform_stage_name(TransformStage stage) {
+  switch (stage) {
+    case TransformStage::ViewPosition:
+      return "view_position";
+    case TransformStage::Jacobian:
+      return "jacobian";
+    case TransformStage::CovarianceProduct:
+      return "covariance_product";
+    case TransformStage::ProjectedCovariance:
+      return "projected_covariance";
+    case TransformStage::Eigenvalues:
+      return "eigenvalues";
+    case TransformStage::Eigenvector:
+      return "eigenvector";
+    case TransformStage::Scale:
+      return "scale";
+  }
+  return "unknown";
+}
+
+Float4 compute_transform_emulated(const Float4& pos_local,
+                                  const PackedCovariance& covariance,
+                                  const TransformParams& params,
+                                  TransformPrecision precision) {
+  // See `transform.hlsl` for the derivation; names match.
+  using Stage = TransformStage;
+  const StageMath math(precision);
+  const float(&W)[4][4] = params.local_to_view.m;
+
+  Float3 pos_view;
+  for (uint32_t j = 0; j < 3; ++j) {
+    const Stage stage = Stage::ViewPosition;
+    float sum = math.add(stage, math.mul(stage, pos_local.x, W[0][j]),
+                         math.mul(stage, pos_local.y, W[1][j]));
+    sum = math.add(stage, sum, math.mul(stage, pos_local.z, W[2][j]));
+    pos_view[j] = math.add(stage, sum, math.mul(stage, pos_local.w, W[3][j]));
+  }
+
+  Float3x3 sig = unpack_cov_mat(covariance.x, covariance.y);
+
+  const Stage jacobian = Stage::Jacobian;
+  float scale_x = math.div(jacobian, -pos_view.x, pos_view.z);
+  float scale_y = math.div(jacobian, -pos_view.y, pos_view.z);
+  Float3 jw_0, jw_1;
+  for (uint32_t i = 0; i < 3; ++i) {
+    jw_0[i] = math.add(jacobian, W[i][0], math.mul(jacobian, scale_x, W[i][2]));
+    jw_1[i] = math.add(jacobian, W[i][1], math.mul(jacobian, scale_y, W[i][2]));
+  }
+
+  Float3 jw_sig_0 = math.mul(Stage::CovarianceProduct, jw_0, sig);
+  Float3 jw_sig_1 = math.mul(Stage::CovarianceProduct, jw_1, sig);
+
+  const Stage projected = Stage::ProjectedCovariance;
+  float sig_p_00 = math.dot(projected, jw_sig_0, jw_0);
+  float sig_p_01_10 = math.dot(projected, jw_sig_0, jw_1);
+  float sig_p_11 = math.dot(projected, jw_sig_1, jw_1);
+
+  const Stage eigenvalues = Stage::Eigenvalues;
+  float det = math.sub(eigenvalues, math.mul(eigenvalues, sig_p_00, sig_p_11),
+                       math.mul(eigenvalues, sig_p_01_10, sig_p_01_10));
+  float trace = math.add(eigenvalues, sig_p_00, sig_p_11);
+  float sqrt_disc = math.sqrt(
+      eigenvalues, math.sub(eigenvalues, math.mul(eigenvalues, trace, trace),
+                            math.mul(eigenvalues, 4.f, det)));
+  float two_lmb_0 = math.add(eigenvalues, trace, sqrt_disc);
+  float two_lmb_1 = math.sub(eigenvalues, trace, sqrt_disc);
+  float sqrt_two_sigma_0 = math.sqrt(eigenvalues, two_lmb_0);
+  float sqrt_two_sigma_1 = math.sqrt(eigenvalues, two_lmb_1);
+
+  const Stage eigenvector = Stage::Eigenvector;
+  float v_0_x = math.round(eigenvector, sig_p_01_10);
+  float v_0_y = math.sub(eigenvector, math.div(eigenvector, two_lmb_0, 2.f),
+                         sig_p_00);
+  float inv_length = math.div(
+      eigenvector, 1.f,
+      math.sqrt(eigenvector,
+                math.add(eigenvector, math.mul(eigenvector, v_0_x, v_0_x),
+                         math.mul(eigenvector, v_0_y, v_0_y))));
+  v_0_x = math.mul(eigenvector, v_0_x, inv_length);
+  v_0_y = math.mul(eigenvector, v_0_y, inv_length);
+
+  const Stage scale = Stage::Scale;
+  float focal_over_depth =
+      math.div(scale, params.two_focal_length, pos_view.z);
+  float scale_0 =
+      std::clamp(math.mul(scale, focal_over_depth, sqrt_two_sigma_0),
+                 -max_transform_scale, max_transform_scale);
+  float scale_1 =
+      std::clamp(math.mul(scale, focal_over_depth, sqrt_two_sigma_1),
+                 -max_transform_scale, max_transform_scale);
+  return Float4(math.mul(scale, v_0_x, scale_0),
+                math.mul(scale, -v_0_y, scale_1),
+                math.mul(scale, v_0_y, scale_0),
+                math.mul(scale, v_0_x, scale_1));
+}
+
+void compute_transform_errors(std::span<const uint32_t> positions,
+                              std::span<const PackedCovariance> covariances,
+                              const TransformParams& params,
+                              TransformPrecision precision,
+                              std::span<float> errors) {
+  import::parallel_for(
+      positions.size(), min_splats_per_task, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          errors[i] = std::numeric_limits<float>::quiet_NaN();
+          Float4 pos_local =
+              unpack_pos(positions[i], params.pos_scale_cm, params.pos_min_cm);
+          double reference[4];
+          if (!compute_reference_transform(pos_local, covariances[i], params,
+                                           reference)) {
+            continue;
+          }
+          double reference_ellipse[3];
+          get_ellipse(reference, reference_ellipse);
+          double reference_norm = get_norm(reference_ellipse);
+          if (!std::isfinite(reference_norm) || !(reference_norm > 0.)) {
+            continue;
+          }
+
+          PackedTransform packed = pack_transform(compute_transform_emulated(
+              pos_local, covariances[i], params, precision));
+          double transform[4] = {f16tof32(packed.x), f16tof32(packed.y),
+                                 f16tof32(packed.z), f16tof32(packed.w)};
+          double ellipse[3];
+          get_ellipse(transform, ellipse);
+          double difference[3] = {ellipse[0] - reference_ellipse[0],
+                                  ellipse[1] - reference_ellipse[1],
+                                  ellipse[2] - reference_ellipse[2]};
+          double error = get_norm(difference) / reference_norm;
+          errors[i] = std::isfinite(error)
+                          ? static_cast<float>(error)
+                          : std::numeric_limits<float>::infinity();
+        }
+      });
+}
+}  // namespace render
\ No newline at end of file
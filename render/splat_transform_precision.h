@@ -0,0 +1,118 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "render/splat_transform.h"
+
+namespace render {
+/**
+ * Groups of intermediates of `compute_transform` in `transform.hlsl`, named
+ * after its variables, which `compute_transform_emulated` can evaluate in
+ * float16.
+ */
+enum class TransformStage : uint32_t {
+  /**
+   * `pos_view`, including `local_to_view`'s translation.
+   */
+  ViewPosition,
+  /**
+   * `scale_x`, `scale_y`, `jw_0` and `jw_1`, i.e. J * W.
+   */
+  Jacobian,
+  /**
+   * `jw_sig_0` and `jw_sig_1`, i.e. J * W * Σ. Σ is unpacked from float16, so
+   * is exact in either precision.
+   */
+  CovarianceProduct,
+  /**
+   * `sig_p_00`, `sig_p_01_10` and `sig_p_11`, i.e. Σ'.
+   */
+  ProjectedCovariance,
+  /**
+   * `det`, `trace`, `sqrt_disc`, `two_lmb` and `sqrt_two_sigma`.
+   */
+  Eigenvalues,
+  /**
+   * `v_0`, normalized.
+   */
+  Eigenvector,
+  /**
+   * `scale`, and the returned transform.
+   */
+  Scale,
+};
+constexpr uint32_t num_transform_stages = 7;
+
+/**
+ * Set of `TransformStage`s evaluated in float16, one bit per stage.
+ */
+using TransformPrecision = uint32_t;
+constexpr TransformPrecision transform_all_float32 = 0;
+constexpr TransformPrecision transform_all_float16 =
+    (1u << num_transform_stages) - 1;
+
+/**
+ * @return Bit of `stage` in a `TransformPrecision`.
+ */
+inline TransformPrecision get_stage_bit(TransformStage stage) {
+  return 1u << static_cast<uint32_t>(stage);
+}
+
+/**
+ * @return Name of `stage`, e.g. for reports.
+ */
+SPLAT_EXPORT_API const char* get_transform_stage_name(TransformStage stage);
+
+/**
+ * Emulation of `compute_transform` in `transform.hlsl`, with each stage in
+ * either float32 or float16.
+ *
+ * In a float16 stage, operands (including constants) are rounded to float16
+ * as they enter, and the result of every operation is rounded to float16 with
+ * round-to-nearest-even, as a GPU's float16 ALUs do. Rounding a float32 result
+ * gives the correctly rounded float16 result for each of +, -, *, / and sqrt.
+ * Fused multiply-adds, which some GPUs use, round once rather than twice, so
+ * real shaders may be slightly more accurate than emulated.
+ *
+ * With `transform_all_float32`, matches `compute_transform`.
+ *
+ * @param pos_local - Local space position.
+ * @param covariance - Packed covariance.
+ * @param params - View constants.
+ * @param precision - Stages to evaluate in float16.
+ * @return Transform, before packing to float16.
+ */
+SPLAT_EXPORT_API Float4 compute_transform_emulated(
+    const Float4& pos_local, const PackedCovariance& covariance,
+    const TransformParams& params, TransformPrecision precision);
+
+/**
+ * Error of `compute_transform_emulated`, after packing to float16 as written
+ * to `transforms`, against a float64 evaluation of the same math. Runs in
+ * parallel.
+ *
+ * The error is that of the ellipse each transform draws, T * T^T, relative to
+ * the reference's (by Frobenius norm). Unlike comparing transforms directly,
+ * this ignores the sign and, for round splats, the direction of eigenvectors,
+ * which don't change the quad that is drawn.
+ *
+ * @param positions - Packed x11y11z10 positions.
+ * @param covariances - Packed covariances.
+ * @param params - View and unpacking constants.
+ * @param precision - Stages to evaluate in float16.
+ * @param errors - Output, per splat, the relative error. Infinity if the
+ * result isn't finite while the reference is, and NaN for splats which aren't
+ * measured: those with a non-positive view depth, or whose reference is
+ * degenerate (e.g. from a covariance which packing made indefinite).
+ */
+SPLAT_EXPORT_API void compute_transform_errors(
+    std::span<const uint32_t> positions,
+    std::span<const PackedCovariance> covariances,
+    const TransformParams& params, TransformPrecision precision,
+    std::span<float> errors);
+}  // namespace render
\ No newline at end of file
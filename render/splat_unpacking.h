@@ -0,0 +1,169 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+#include "import/splat_math.h"
+
+namespace render {
+using import::Float2;
+using import::Float3;
+using import::Float4;
+using import::Float4x4;
+
+/**
+ * CPU mirror of `unpacking.hlsl`, plus the HLSL intrinsics it depends on. Keep
+ * in sync.
+ */
+
+/**
+ * HLSL `f16tof32`: interprets the low 16 bits of `packed` as an IEEE float16.
+ */
+inline float f16tof32(uint32_t packed) {
+  uint32_t sign = (packed & 0x8000u) << 16;
+  uint32_t exponent = (packed >> 10) & 0x1Fu;
+  uint32_t mantissa = packed & 0x3FFu;
+
+  if (exponent == 0) {
+    // Zero / subnormal: mantissa * 2^-24.
+    float value = static_cast<float>(mantissa) * (1.f / 16777216.f);
+    return sign ? -value : value;
+  }
+  if (exponent == 0x1F) {
+    // Inf / NaN.
+    return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+  }
+  return std::bit_cast<float>(sign | ((exponent + 112) << 23) |
+                              (mantissa << 13));
+}
+
+/**
+ * HLSL `f32tof16`: converts to an IEEE float16 (in the low 16 bits), with
+ * round-to-nearest-even, as used when writing to `half` UAVs.
+ */
+inline uint32_t f32tof16(float value) {
+  uint32_t bits = std::bit_cast<uint32_t>(value);
+  uint32_t sign = (bits >> 16) & 0x8000u;
+  uint32_t abs_bits = bits & 0x7FFFFFFFu;
+
+  if (abs_bits >= 0x7F800000u) {
+    // Inf / NaN (NaN keeps a mantissa bit set).
+    return sign | 0x7C00u | (abs_bits > 0x7F800000u ? 0x200u : 0u);
+  }
+  if (abs_bits >= 0x477FF000u) {
+    // Rounds to >= 65520, i.e. overflows.
+    return sign | 0x7C00u;
+  }
+  if (abs_bits < 0x38800000u) {
+    // Subnormal or zero in float16. Scale such that the float16 subnormal
+    // step (2^-24) is the unit, then round to nearest even.
+    float scaled = std::bit_cast<float>(abs_bits) * 16777216.f;
+    uint32_t truncated = static_cast<uint32_t>(scaled);
+    float remainder = scaled - static_cast<float>(truncated);
+    if (remainder > .5f || (remainder == .5f && (truncated & 1u))) {
+      ++truncated;
+    }
+    return sign | truncated;
+  }
+
+  // Normal: rebias exponent, then round the 13 dropped mantissa bits.
+  uint32_t half_bits = (abs_bits - 0x38000000u) >> 13;
+  uint32_t dropped = abs_bits & 0x1FFFu;
+  if (dropped > 0x1000u || (dropped == 0x1000u && (half_bits & 1u))) {
+    ++half_bits;
+  }
+  return sign | half_bits;
+}
+
+/**
+ * Rounds `value` to the nearest float16, returned as a float.
+ */
+inline float round_to_f16(float value) { return f16tof32(f32tof16(value)); }
+
+/**
+ * Extract a float16 packed into offset.
+ *
+ * @param s - Number of sign bits in packed type.
+ * @param e - Number of exponent bits.
+ * @param m - Number of significand bits.
+ * @param packed - uint storing packed float.
+ * @param offset - First lowest bit holding the value to unpack, of size s+e+m.
+ * @return float containing the extracted value.
+ */
+inline float unpack_f16(uint32_t s, uint32_t e, uint32_t m, uint32_t packed,
+                        uint32_t offset) {
+  uint32_t shift = 15 - e - m;
+  uint32_t mask = ((1u << (s + e + m)) - 1) << shift;
+  if (s == 1 && offset == 0) {
+    return f16tof32(packed << shift);
+  } else if (offset < shift) {
+    return f16tof32((packed << (shift - offset)) & mask);
+  } else {
+    return f16tof32((packed >> (offset - shift)) & mask);
+  }
+}
+
+/**
+ * Extract an unsigned, normalized integer from bits in offset, and return it
+ * as its unnormalized value.
+ *
+ * @param bits - Number of bits comprising packed value.
+ * @param packed - uint storing packed UNorm.
+ * @param offset - First lowest bit holding the value to unpack, of size bits.
+ * @return float containing unnormalized value equal to the packed UNorm, when
+ * interpreted as an integer.
+ */
+inline float unpack_unorm(uint32_t bits, uint32_t packed, uint32_t offset) {
+  uint32_t mask = (1u << bits) - 1;
+  return static_cast<float>((packed >> offset) & mask);
+}
+
+/**
+ * Symmetric 3x3 matrix, e.g. a covariance matrix.
+ */
+struct Float3x3 {
+  float m[3][3] = {};
+};
+
+/**
+ * Extracts the 3x3 covariance matrix packed into `packed_cov_mat`.
+ *
+ * @param packed_cov_mat_x - First component of the packed covariance.
+ * @param packed_cov_mat_y - Second component of the packed covariance.
+ * @return Extracted covariance matrix, fully populated (not upper triangular).
+ */
+inline Float3x3 unpack_cov_mat(uint32_t packed_cov_mat_x,
+                               uint32_t packed_cov_mat_y) {
+  float xx = unpack_f16(0, 5, 5, packed_cov_mat_y, 22);
+  float xy = unpack_f16(1, 5, 5, packed_cov_mat_y, 11);
+  float xz = unpack_f16(1, 5, 5, packed_cov_mat_y, 0);
+  float yy = unpack_f16(0, 5, 5, packed_cov_mat_x, 22);
+  float yz = unpack_f16(1, 5, 5, packed_cov_mat_x, 11);
+  float zz = unpack_f16(0, 5, 6, packed_cov_mat_x, 0);
+
+  return Float3x3{{{xx, xy, xz}, {xy, yy, yz}, {xz, yz, zz}}};
+}
+
+/**
+ * Extracts the position from packed, where each channel has been normalized
+ * and offset.
+ *
+ * @param packed - uint holding x11y11z10 position.
+ * @param scale - Scaling factor: (PosMax - PosMin) * 100cm / UNormMax.
+ * @param offset - The origin that all packed positions are relative to.
+ * @return Unpacked (x, y, z, 1).
+ */
+inline Float4 unpack_pos(uint32_t packed, const Float3& scale,
+                         const Float3& offset) {
+  float x = unpack_unorm(11, packed, 0);
+  float y = unpack_unorm(11, packed, 11);
+  float z = unpack_unorm(10, packed, 22);
+
+  return Float4(x * scale.x + offset.x, y * scale.y + offset.y,
+                z * scale.z + offset.z, 1.f);
+}
+}  // namespace render
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Required headers:
+ * - constants.hlsl
+ * - compaction.hlsl
+ *
+ * Required shaders constants:
+ * - num_splats
+ */
+
+Buffer<uint> distances;
+RWBuffer<uint> group_counts;
+
+groupshared uint group_count;
+
+/**
+ * Count the visible splats of one thread group, as written by
+ * `compute_distance.cs.hlsl`.
+ *
+ * @param group_id - The x component is 1:1 with the entry of `group_counts`
+ * being written.
+ * @param group_index - Index of the thread within its group.
+ * @param dispatch_thread_id - The x component is 1:1 with the index of the
+ * splat being counted.
+ */
+[numthreads(THREAD_GROUP_SIZE_X, 1, 1)] void main(
+    uint3 group_id : SV_GroupID, uint group_index : SV_GroupIndex,
+    uint3 dispatch_thread_id : SV_DispatchThreadID) {
+  if (group_index == 0) {
+    group_count = 0;
+  }
+  GroupMemoryBarrierWithGroupSync();
+
+  // No early out, as all threads must reach the barriers.
+  if (dispatch_thread_id.x < num_splats &&
+      distances[dispatch_thread_id.x] != DISTANCE_NOT_VISIBLE) {
+    InterlockedAdd(group_count, 1);
+  }
+  GroupMemoryBarrierWithGroupSync();
+
+  if (group_index == 0) {
+    group_counts[group_id.x] = group_count;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Required headers:
+ * - constants.hlsl
+ * - compaction.hlsl
+ *
+ * Required shaders constants:
+ * - num_splats
+ *
+ * Dispatched as a single thread group.
+ */
+
+RWBuffer<uint> group_counts;
+RWBuffer<uint> indirect_args;
+
+/**
+ * Replace the per-group counts of `compact_count.cs.hlsl` with each group's
+ * offset into the compacted buffers (an exclusive prefix sum), then write the
+ * total to `indirect_args`.
+ *
+ * The single group walks the counts THREAD_GROUP_SIZE_X at a time. For 5M
+ * splats in groups of 64, that's about 1200 iterations of a 64-wide scan,
+ * which is small next to the passes over all splats.
+ *
+ * @param group_index - Index of the thread within the group.
+ */
+[numthreads(THREAD_GROUP_SIZE_X, 1, 1)] void main(
+    uint group_index : SV_GroupIndex) {
+  uint num_groups =
+      (num_splats + THREAD_GROUP_SIZE_X - 1) / THREAD_GROUP_SIZE_X;
+
+  uint num_visible = 0;
+  for (uint first = 0; first < num_groups; first += THREAD_GROUP_SIZE_X) {
+    uint i = first + group_index;
+    uint count = i < num_groups ? group_counts[i] : 0;
+
+    uint total;
+    uint offset = group_exclusive_scan(group_index, count, total);
+    if (i < num_groups) {
+      group_counts[i] = num_visible + offset;
+    }
+    num_visible += total;
+  }
+
+  if (group_index == 0) {
+    indirect_args[INDIRECT_DISPATCH_ARGS_OFFSET + 0] =
+        (num_visible + THREAD_GROUP_SIZE_X - 1) / THREAD_GROUP_SIZE_X;
+    indirect_args[INDIRECT_DISPATCH_ARGS_OFFSET + 1] = 1;
+    indirect_args[INDIRECT_DISPATCH_ARGS_OFFSET + 2] = 1;
+
+    indirect_args[INDIRECT_DRAW_ARGS_OFFSET + 0] =
+        num_visible * VERTICES_PER_SPLAT;
+    indirect_args[INDIRECT_DRAW_ARGS_OFFSET + 1] = 1;
+    indirect_args[INDIRECT_DRAW_ARGS_OFFSET + 2] = 0;
+    indirect_args[INDIRECT_DRAW_ARGS_OFFSET + 3] = 0;
+
+    indirect_args[INDIRECT_DRAW_INDEXED_ARGS_OFFSET + 0] =
+        QUADS_PER_INSTANCE * INDICES_PER_QUAD;
+    indirect_args[INDIRECT_DRAW_INDEXED_ARGS_OFFSET + 1] =
+        (num_visible + QUADS_PER_INSTANCE - 1) / QUADS_PER_INSTANCE;
+    indirect_args[INDIRECT_DRAW_INDEXED_ARGS_OFFSET + 2] = 0;
+    indirect_args[INDIRECT_DRAW_INDEXED_ARGS_OFFSET + 3] = 0;
+    indirect_args[INDIRECT_DRAW_INDEXED_ARGS_OFFSET + 4] = 0;
+
+    indirect_args[INDIRECT_NUM_VISIBLE_OFFSET] = num_visible;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Required headers:
+ * - constants.hlsl
+ * - compaction.hlsl
+ *
+ * Required shaders constants:
+ * - num_splats
+ */
+
+Buffer<uint> indices;
+Buffer<uint> distances;
+Buffer<uint> group_offsets;
+RWBuffer<uint> compacted_indices;
+RWBuffer<uint> compacted_distances;
+
+/**
+ * Write each visible splat to its place in the compacted buffers: its group's
+ * offset from `compact_scan.cs.hlsl`, plus the number of visible splats before
+ * it within the group.
+ *
+ * @param group_id - The x component is 1:1 with the entry of `group_offsets`
+ * being read.
+ * @param group_index - Index of the thread within its group.
+ * @param dispatch_thread_id - The x component is 1:1 with the index of the
+ * splat being written.
+ */
+[numthreads(THREAD_GROUP_SIZE_X, 1, 1)] void main(
+    uint3 group_id : SV_GroupID, uint group_index : SV_GroupIndex,
+    uint3 dispatch_thread_id : SV_DispatchThreadID) {
+  uint i = dispatch_thread_id.x;
+  uint distance = i < num_splats ? distances[i] : DISTANCE_NOT_VISIBLE;
+  bool is_visible = distance != DISTANCE_NOT_VISIBLE;
+
+  // No early out, as all threads must reach the scan's barriers.
+  uint total;
+  uint rank = group_exclusive_scan(group_index, is_visible ? 1 : 0, total);
+
+  if (is_visible) {
+    uint offset = group_offsets[group_id.x] + rank;
+    compacted_indices[offset] = indices[i];
+    compacted_distances[offset] = distance;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Shared by the compaction passes, which remove culled splats after
+ * `compute_distance.cs.hlsl`, so that sorting and drawing only touch visible
+ * splats:
+ *
+ * 1. compact_count.cs.hlsl: Counts visible splats per thread group.
+ * 2. compact_scan.cs.hlsl: Turns counts into offsets, and writes the visible
+ *    count into indirect arguments.
+ * 3. compact_scatter.cs.hlsl: Writes visible splats to their offsets.
+ *
+ * Visible splats keep their relative order, so the output (and any stable
+ * sort of it) is deterministic, unlike appending with atomics.
+ *
+ * All three passes must be compiled with the same THREAD_GROUP_SIZE_X.
+ *
+ * Required headers:
+ * - constants.hlsl
+ */
+
+groupshared uint scan_values[THREAD_GROUP_SIZE_X];
+
+/**
+ * Exclusive prefix sum over a thread group (Hillis-Steele), in thread order.
+ * Must be reached by all threads of the group.
+ *
+ * @param group_index - SV_GroupIndex.
+ * @param value - This thread's value.
+ * @param total - Sum over the whole group.
+ * @return Sum of the values of all threads before this one.
+ */
+uint group_exclusive_scan(uint group_index, uint value, out uint total) {
+  scan_values[group_index] = value;
+  GroupMemoryBarrierWithGroupSync();
+
+  for (uint stride = 1; stride < THREAD_GROUP_SIZE_X; stride <<= 1) {
+    uint addend =
+        group_index >= stride ? scan_values[group_index - stride] : 0;
+    GroupMemoryBarrierWithGroupSync();
+    scan_values[group_index] += addend;
+    GroupMemoryBarrierWithGroupSync();
+  }
+
+  total = scan_values[THREAD_GROUP_SIZE_X - 1];
+  uint result = scan_values[group_index] - value;
+  // Allow the group to scan again without overwriting values still being read.
+  GroupMemoryBarrierWithGroupSync();
+  return result;
+}
\ No newline at end of file
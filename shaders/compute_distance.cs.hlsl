@@ -6,9 +6,27 @@
  * Required headers:
  * - constants.hlsl
  * - unpacking.hlsl
+ * - distance.hlsl
+ *
+ * Required defines:
+ * - WITH_STEREO_SORT
+ *
+ * Optional defines:
+ * - DISTANCE_ENCODING (see constants.hlsl)
+ * - DISTANCE_PRECISION
+ * - FRONT_TO_BACK: Sort front-to-back (see constants.hlsl).
+ * - CHUNKED_DISPATCH: Only measure splats of chunks not culled on the CPU
+ *   (see `render::cull_chunks`). Thread group `g` measures the
+ *   `chunk_groups[g].y` splats from `chunk_groups[g].x`, as written by
+ *   `render::get_chunk_thread_groups`, and outputs are dense, so downstream
+ *   passes sort `num_groups * THREAD_GROUP_SIZE_X` entries rather than
+ *   `num_splats`.
  *
  * Required shaders constants:
  * - local_to_clip
+ * - cull_local_to_clip[2] (if WITH_STEREO_SORT)
+ * - distance_near_cm, distance_far_cm (unless DISTANCE_ENCODING is
+ *   CLIP_DEPTH)
  * - num_splats
  * - pos_scale_cm
  * - pos_min_cm
@@ -17,31 +35,47 @@
 Buffer<uint> positions;
 RWBuffer<uint> indices;
 RWBuffer<uint> distances;
+#ifdef CHUNKED_DISPATCH
+Buffer<uint2> chunk_groups;
+#endif
 
 /**
  * Measure the distance to a splat.
  *
  * @param dispatch_thread_id - The x component is 1:1 with the index of the splat
- * that is being measured.
+ * that is being measured, or, with CHUNKED_DISPATCH, with the output slot.
+ * @param group_id - With CHUNKED_DISPATCH, the thread group's entry of
+ * `chunk_groups`.
+ * @param group_thread_id - With CHUNKED_DISPATCH, the offset of the splat from
+ * the thread group's first.
  */
 [numthreads(THREAD_GROUP_SIZE_X, 1, 1)] void main(
-    uint3 dispatch_thread_id : SV_DispatchThreadID) {
+    uint3 dispatch_thread_id : SV_DispatchThreadID,
+    uint3 group_id : SV_GroupID, uint3 group_thread_id : SV_GroupThreadID) {
+#ifdef CHUNKED_DISPATCH
+  // Every slot is written, so that slots past the end of a range sort as
+  // culled rather than holding stale entries.
+  uint2 chunk_group = chunk_groups[group_id.x];
+  uint index = chunk_group.x + group_thread_id.x;
+  if (group_thread_id.x >= chunk_group.y) {
+    indices[dispatch_thread_id.x] = 0;
+    distances[dispatch_thread_id.x] = DISTANCE_NOT_VISIBLE;
+    return;
+  }
+#else
   if (dispatch_thread_id.x >= num_splats) {
     return;
   }
+  uint index = dispatch_thread_id.x;
+#endif
 
-  float4 pos_local =
-      unpack_pos(positions[dispatch_thread_id.x], pos_scale_cm, pos_min_cm);
+  float4 pos_local = unpack_pos(positions[index], pos_scale_cm, pos_min_cm);
   float4 pos_clip = mul(pos_local, local_to_clip);
 
-  bool inside_frustum = !(pos_clip.x < -pos_clip.w || pos_clip.x > pos_clip.w ||
-                          pos_clip.y < -pos_clip.w || pos_clip.y > pos_clip.w ||
-                          pos_clip.z > pos_clip.w);
+  bool inside_frustum = is_inside_frustum(pos_local, pos_clip);
 
-  uint index = dispatch_thread_id.x;
-  uint distance = inside_frustum
-                      ? uint(saturate(pos_clip.z / pos_clip.w) * DISTANCE_SCALE)
-                      : DISTANCE_NOT_VISIBLE;
+  uint distance =
+      inside_frustum ? encode_distance(pos_clip) : DISTANCE_NOT_VISIBLE;
 
   indices[dispatch_thread_id.x] = index;
   distances[dispatch_thread_id.x] = distance;
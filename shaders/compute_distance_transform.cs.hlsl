@@ -0,0 +1,93 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Fused `compute_distance.cs.hlsl` and `compute_transform.cs.hlsl`: each
+ * position is read and unpacked once, and the (comparatively expensive)
+ * transform, along with the covariance it is computed from, is skipped for
+ * culled splats.
+ *
+ * Required headers:
+ * - constants.hlsl
+ * - unpacking.hlsl
+ * - distance.hlsl
+ * - transform.hlsl
+ *
+ * Required defines:
+ * - WITH_STEREO_SORT
+ *
+ * Optional defines:
+ * - DISTANCE_ENCODING (see constants.hlsl)
+ * - DISTANCE_PRECISION
+ * - FRONT_TO_BACK: Sort front-to-back (see constants.hlsl).
+ * - FOOTPRINT_LIMITS, FOOTPRINT_COUNTERS (see transform.hlsl): Splats culled
+ *   for their footprint are also culled from the sort.
+ *
+ * Required shaders constants:
+ * - local_to_clip
+ * - local_to_view
+ * - two_focal_length
+ * - min_radius_pixels, max_radius_pixels (if FOOTPRINT_LIMITS)
+ * - cull_local_to_clip[2] (if WITH_STEREO_SORT)
+ * - distance_near_cm, distance_far_cm (unless DISTANCE_ENCODING is
+ *   CLIP_DEPTH)
+ * - num_splats
+ * - pos_scale_cm
+ * - pos_min_cm
+ */
+
+Buffer<uint> positions;
+Buffer<uint2> covariances;
+RWBuffer<uint> indices;
+RWBuffer<uint> distances;
+RWBuffer<half4> transforms;
+#ifdef FOOTPRINT_LIMITS
+RWBuffer<half> opacity_scales;
+#endif
+
+/**
+ * Measure the distance to a splat, and transform it if visible.
+ *
+ * @param dispatch_thread_id - The x component is 1:1 with the index of the
+ * splat that is being measured.
+ */
+[numthreads(THREAD_GROUP_SIZE_X, 1, 1)] void main(
+    uint3 dispatch_thread_id : SV_DispatchThreadID) {
+  uint splat_id = dispatch_thread_id.x;
+
+  if (splat_id >= num_splats) {
+    return;
+  }
+
+  float4 pos_local = unpack_pos(positions[splat_id], pos_scale_cm, pos_min_cm);
+  float4 pos_clip = mul(pos_local, local_to_clip);
+
+  bool inside_frustum = is_inside_frustum(pos_local, pos_clip);
+
+  /**
+   * Culled splats get an empty footprint rather than being skipped, so that a
+   * stale transform is never drawn, e.g. if the vertex shader's (half
+   * precision, per eye) frustum test disagrees at the edges.
+   *
+   * Note: An if rather than ?:, as HLSL evaluates both sides of the latter.
+   */
+  float4 transform = float4(0.f, 0.f, 0.f, 0.f);
+#ifdef FOOTPRINT_LIMITS
+  half opacity_scale = 1.f;
+#endif
+  if (inside_frustum) {
+    transform = compute_transform(pos_local, covariances[splat_id]);
+#ifdef FOOTPRINT_LIMITS
+    inside_frustum = limit_footprint(transform, opacity_scale);
+#endif
+  }
+
+  indices[splat_id] = splat_id;
+  distances[splat_id] =
+      inside_frustum ? encode_distance(pos_clip) : DISTANCE_NOT_VISIBLE;
+  transforms[splat_id] = half4(transform);
+#ifdef FOOTPRINT_LIMITS
+  opacity_scales[splat_id] = opacity_scale;
+#endif
+}
\ No newline at end of file
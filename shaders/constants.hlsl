@@ -16,8 +16,133 @@
   (RADIUS_SIGMA_OVER_SQRT_2 * RADIUS_SIGMA_OVER_SQRT_2)
 
 /**
- * Precision with which to sort splats, when using GPU sorting pipeline.
+ * Lowest alpha a fragment can contribute to an 8-bit render target. With
+ * OPACITY_ADAPTIVE_RADIUS (see render_splat.vs.hlsl), each splat is only
+ * evaluated out to where its alpha falls below this, which for splats of
+ * opacity under exp(CUTOFF_RADIUS_SIGMA_SQUARED_OVER_2) * MIN_ALPHA (~0.21) is
+ * within RADIUS_SIGMA.
  */
+#define MIN_ALPHA (1.f / 255.f)
+
+/**
+ * Largest scale of each axis of a splat's transform, in pixels * 2. Splats just
+ * in front of the camera project to (nearly) infinite sizes, which overflow
+ * half; this is far beyond any screen, yet fits.
+ */
+#define MAX_TRANSFORM_SCALE 32768.f
+
+/**
+ * Blending order. By default, splats are sorted back-to-front, and blended
+ * with the over operator. With FRONT_TO_BACK, they are sorted front-to-back
+ * (see distance.hlsl), `render_splat.ps.hlsl` outputs premultiplied colors,
+ * and they are blended with the under operator (see `get_blend_state` in
+ * splat_draw.h):
+ *
+ * C_dst += (1 - A_dst) * A_src * C_src
+ * A_dst += (1 - A_dst) * A_src
+ *
+ * Starting from an empty pixel, this gives the same image, so splats are drawn
+ * into their own target, cleared to 0, then composited over the scene by
+ * `resolve_front_to_back.ps.hlsl`. Pixels stop changing once A_dst saturates,
+ * so hidden layers can be skipped: drawn in batches, `saturation_mask.ps.hlsl`
+ * marks pixels whose alpha has reached SATURATION_ALPHA in the stencil buffer
+ * after each batch, and the stencil test rejects later fragments there before
+ * they are shaded. Past SATURATION_ALPHA, all remaining layers together could
+ * add less than MIN_ALPHA.
+ */
+#define SATURATION_ALPHA (1.f - MIN_ALPHA)
+
+/**
+ * Sort-free blending, for assets where ordering errors are hard to see (e.g.
+ * distant backgrounds), to spare the sort. With WEIGHTED_OIT,
+ * `render_splat.ps.hlsl` outputs to two targets, blended additively and
+ * multiplicatively respectively (see `get_blend_state` in splat_draw.h):
+ *
+ * accumulated = Σ (C_src * A_src, A_src) * w(A_src, z)
+ * revealage   = Π (1 - A_src)
+ *
+ * where w favors near splats (see weighted_oit.hlsl). Then
+ * `resolve_weighted_oit.ps.hlsl` blends their weighted average color over the
+ * scene, with alpha 1 - revealage. This is exact for a single layer, and
+ * otherwise approximates the order of overlapping splats by their weights.
+ *
+ * Weights are clamped to [OIT_MIN_WEIGHT, OIT_MAX_WEIGHT]. The maximum keeps
+ * hundreds of opaque layers within the range of an RGBA16F accumulation
+ * target.
+ */
+#define OIT_MIN_WEIGHT 1e-2f
+#define OIT_MAX_WEIGHT 3e2f
+
+/**
+ * Geometry of each splat, as drawn by render_splat.vs.hlsl.
+ *
+ * By default, each splat is two independent triangles, i.e. VERTICES_PER_SPLAT
+ * vertex shader invocations. With INDEXED_QUADS, splats are drawn with a
+ * static 16-bit index buffer of QUADS_PER_INSTANCE quads, instanced to cover
+ * all splats, so each splat costs VERTICES_PER_QUAD invocations (the post
+ * transform cache reuses the two shared corners).
+ */
+#define VERTICES_PER_SPLAT 6
+#define VERTICES_PER_QUAD 4
+#define INDICES_PER_QUAD 6
+#define QUADS_PER_INSTANCE 16384
+
+/**
+ * Layout of `indirect_args`, as written by the compaction passes (see
+ * compaction.hlsl), in uints:
+ * - Dispatch arguments (thread group counts) for a pass with one thread per
+ *   visible splat, of THREAD_GROUP_SIZE_X threads per group.
+ * - Draw arguments for `render_splat.vs.hlsl`, of VERTICES_PER_SPLAT vertices
+ *   per visible splat.
+ * - Indexed draw arguments for `render_splat.vs.hlsl` with INDEXED_QUADS, of
+ *   QUADS_PER_INSTANCE quads per instance.
+ * - Number of visible splats, e.g. for the sort.
+ */
+#define INDIRECT_DISPATCH_ARGS_OFFSET 0
+#define INDIRECT_DRAW_ARGS_OFFSET 3
+#define INDIRECT_DRAW_INDEXED_ARGS_OFFSET 7
+#define INDIRECT_NUM_VISIBLE_OFFSET 12
+#define INDIRECT_ARGS_SIZE 13
+
+/**
+ * Encoding of the keys which splats are sorted by. For all encodings, sorting
+ * keys in ascending order draws splats back-to-front.
+ *
+ * - CLIP_DEPTH: Post-projection z / w. With reversed-Z, this is proportional to
+ *   1 / depth, so most keys are spent close to the camera, and far splats
+ *   share keys.
+ * - LINEAR_DEPTH: View depth, linearly over [distance_near_cm,
+ *   distance_far_cm].
+ * - LOG_DEPTH: View depth, logarithmically over [distance_near_cm,
+ *   distance_far_cm], giving each key the same relative depth precision.
+ * - FLOAT_FLIP: Bits of the float view depth (clamped to [distance_near_cm,
+ *   distance_far_cm]) without its sign bit, inverted. Use with a precision of
+ *   32 for exact keys. Fewer bits keep the exponent and highest mantissa bits,
+ *   which is piecewise-logarithmic, but 8 of them are spent on an exponent
+ *   which barely varies over a depth range: at 16 bits, most splats share
+ *   keys. Use at least 24 bits, or LOG_DEPTH.
+ */
+#define DISTANCE_ENCODING_CLIP_DEPTH 0
+#define DISTANCE_ENCODING_LINEAR_DEPTH 1
+#define DISTANCE_ENCODING_LOG_DEPTH 2
+#define DISTANCE_ENCODING_FLOAT_FLIP 3
+
+#ifndef DISTANCE_ENCODING
+#define DISTANCE_ENCODING DISTANCE_ENCODING_CLIP_DEPTH
+#endif
+
+/**
+ * Precision with which to sort splats, when using GPU sorting pipeline. At
+ * most 24 bits (the precision of a float), unless using FLOAT_FLIP, which
+ * supports 32.
+ */
+#ifndef DISTANCE_PRECISION
 #define DISTANCE_PRECISION 16
-#define DISTANCE_SCALE half((1 << DISTANCE_PRECISION) - 2)
-#define DISTANCE_NOT_VISIBLE ((1 << DISTANCE_PRECISION) - 1)
\ No newline at end of file
+#endif
+
+#if DISTANCE_PRECISION == 32
+#define DISTANCE_NOT_VISIBLE 0xFFFFFFFF
+#else
+#define DISTANCE_NOT_VISIBLE ((1 << DISTANCE_PRECISION) - 1)
+#endif
+#define DISTANCE_SCALE float(DISTANCE_NOT_VISIBLE - 1)
\ No newline at end of file
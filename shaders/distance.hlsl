@@ -0,0 +1,91 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Culling and sort keys, shared by `compute_distance.cs.hlsl` and
+ * `compute_distance_transform.cs.hlsl`.
+ *
+ * Required headers:
+ * - constants.hlsl
+ *
+ * Required defines:
+ * - WITH_STEREO_SORT
+ *
+ * Optional defines:
+ * - FRONT_TO_BACK (see constants.hlsl)
+ *
+ * Required shaders constants:
+ * - cull_local_to_clip[2] (if WITH_STEREO_SORT)
+ * - distance_near_cm, distance_far_cm (unless DISTANCE_ENCODING is
+ *   CLIP_DEPTH)
+ */
+
+bool is_outside_frustum(float4 pos_clip) {
+  return pos_clip.x < -pos_clip.w || pos_clip.x > pos_clip.w ||
+         pos_clip.y < -pos_clip.w || pos_clip.y > pos_clip.w ||
+         pos_clip.z > pos_clip.w;
+}
+
+/**
+ * Whether a splat is visible, i.e. needs to be sorted and drawn.
+ *
+ * @param pos_local - Local space position.
+ * @param pos_clip - Clip space position, under local_to_clip.
+ */
+bool is_inside_frustum(float4 pos_local, float4 pos_clip) {
+#if WITH_STEREO_SORT
+  /**
+   * One sort is shared by both eyes. local_to_clip is then the midpoint of the
+   * two eyes' projections, which distances are measured from, and splats are
+   * only culled if outside of both eyes' frustums.
+   */
+  return !is_outside_frustum(mul(pos_local, cull_local_to_clip[0])) ||
+         !is_outside_frustum(mul(pos_local, cull_local_to_clip[1]));
+#else
+  return !is_outside_frustum(pos_clip);
+#endif
+}
+
+/**
+ * Encodes the back-to-front sort key of a visible splat, in [0,
+ * DISTANCE_NOT_VISIBLE). Further splats have lower keys.
+ *
+ * @param pos_clip - Clip space position. w is the view depth.
+ */
+uint encode_back_to_front_distance(float4 pos_clip) {
+#if DISTANCE_ENCODING == DISTANCE_ENCODING_CLIP_DEPTH
+  return uint(saturate(pos_clip.z / pos_clip.w) * DISTANCE_SCALE);
+#else
+  float depth = clamp(pos_clip.w, distance_near_cm, distance_far_cm);
+#if DISTANCE_ENCODING == DISTANCE_ENCODING_LINEAR_DEPTH
+  float t = (depth - distance_near_cm) / (distance_far_cm - distance_near_cm);
+  return uint((1.f - t) * DISTANCE_SCALE);
+#elif DISTANCE_ENCODING == DISTANCE_ENCODING_LOG_DEPTH
+  float t = log2(depth / distance_near_cm) /
+            log2(distance_far_cm / distance_near_cm);
+  return uint((1.f - saturate(t)) * DISTANCE_SCALE);
+#else
+  // Positive floats order as their bits do, so inverting them orders far
+  // splats first. The sign bit is always 0, so is shifted out rather than
+  // spending a key bit on it. As depth >= distance_near_cm > 0, this never
+  // reaches DISTANCE_NOT_VISIBLE.
+  return (~(asuint(depth) << 1)) >> (32 - DISTANCE_PRECISION);
+#endif
+#endif
+}
+
+/**
+ * Encodes the sort key of a visible splat, in [0, DISTANCE_NOT_VISIBLE).
+ * Further splats have lower keys, or with FRONT_TO_BACK, higher keys.
+ *
+ * @param pos_clip - Clip space position. w is the view depth.
+ */
+uint encode_distance(float4 pos_clip) {
+#ifdef FRONT_TO_BACK
+  // Reversed within the visible range, so culled splats still sort last.
+  return (DISTANCE_NOT_VISIBLE - 1) - encode_back_to_front_distance(pos_clip);
+#else
+  return encode_back_to_front_distance(pos_clip);
+#endif
+}
\ No newline at end of file
@@ -5,6 +5,14 @@
 /**
  * Required headers:
  * - constants.hlsl
+ * - weighted_oit.hlsl (if WEIGHTED_OIT)
+ *
+ * Optional defines:
+ * - OPACITY_ADAPTIVE_RADIUS: Must match `render_splat.vs.hlsl`.
+ * - FRONT_TO_BACK: Output premultiplied colors, for the under operator (see
+ *   constants.hlsl).
+ * - WEIGHTED_OIT: Output weighted colors and revealage, for sort-free
+ *   blending (see constants.hlsl). Must match `render_splat.vs.hlsl`.
  */
 
 /**
@@ -13,10 +21,17 @@
  * @param sig_div_sqrt_2 - The distance to the center of the splat, in σ's, over
  * sqrt(2).
  * @param in_color - The splat's base color.
- * @param out_color - Fragment color.
+ * @param in_oit_depth - With WEIGHTED_OIT, the splat's scaled view depth.
+ * @param out_color - Fragment color. With WEIGHTED_OIT, weighted
+ * premultiplied color and alpha, for the accumulation target.
+ * @param out_revealage - With WEIGHTED_OIT, alpha, for the revealage target.
  */
 void main(in half2 sig_div_sqrt_2 : DELTA_STD_DEVS,
           in nointerpolation half4 in_color : COLOR,
+#ifdef WEIGHTED_OIT
+          in nointerpolation float in_oit_depth : OIT_DEPTH,
+          out half out_revealage : SV_Target1,
+#endif
           out half4 out_color : SV_Target0) {
   /**
 	 * Find the square of the distance from the center of the splat, in standard
@@ -64,5 +79,23 @@ void main(in half2 sig_div_sqrt_2 : DELTA_STD_DEVS,
   half alpha_gaussian = (sig_sq_div_2 < CUTOFF_RADIUS_SIGMA_SQUARED_OVER_2)
                             ? in_color.a / exp(sig_sq_div_2)
                             : 0;
+
+#ifdef OPACITY_ADAPTIVE_RADIUS
+  /**
+	 * The vertex shader fits the quad to the radius r_σ at which alpha falls
+	 * below MIN_ALPHA. The quad's corners lie beyond it, so cut off there, i.e.
+	 * at r_σ^2 / 2 = ln(a / MIN_ALPHA). That is the same as testing alpha
+	 * directly, which saves a log per fragment.
+	 */
+  alpha_gaussian = (alpha_gaussian >= MIN_ALPHA) ? alpha_gaussian : 0;
+#endif
+#if defined(WEIGHTED_OIT)
+  half weight = get_oit_weight(alpha_gaussian, in_oit_depth);
+  out_color = half4(in_color.rgb * weight, weight);
+  out_revealage = alpha_gaussian;
+#elif defined(FRONT_TO_BACK)
+  out_color = half4(in_color.rgb * alpha_gaussian, alpha_gaussian);
+#else
   out_color = half4(in_color.rgb, alpha_gaussian);
+#endif
 }
\ No newline at end of file
@@ -6,8 +6,31 @@
  * Required defines:
  * - WITH_VIEW_ID
  *
+ * Optional defines:
+ * - GPU_SORT
+ * - INDEXED_QUADS: Draw with the index buffer of `generate_quad_indices` (see
+ *   splat_draw.h), rather than 6 non-indexed vertices per splat.
+ * - WITH_COMPACTION: With INDEXED_QUADS, read the number of splats from the
+ *   `indirect_args` of `compact_scan.cs.hlsl`, rather than `num_splats`.
+ * - OPACITY_ADAPTIVE_RADIUS: Shrink the quads of translucent splats to where
+ *   their alpha falls below MIN_ALPHA, rather than always RADIUS_SIGMA. Use
+ *   with the same define in `render_splat.ps.hlsl`.
+ * - FOOTPRINT_LIMITS: Scale opacities by the `opacity_scales` written by the
+ *   transform pass (see transform.hlsl).
+ * - BATCHED_DRAW: Draw the sorted splats from first_splat on, e.g. to mark
+ *   saturated pixels between batches of FRONT_TO_BACK draws (see
+ *   `get_batched_draw_calls` in splat_draw.h). Not with WITH_COMPACTION, as
+ *   batches are split by a count known on the CPU.
+ * - WEIGHTED_OIT: Draw splats unsorted, and output their depth for the
+ *   weights of `render_splat.ps.hlsl` (see constants.hlsl). Without
+ *   WITH_COMPACTION, `indices` isn't read, and the sort can be skipped.
+ *
  * Required shaders constants:
  * - local_to_world
+ * - num_splats (if INDEXED_QUADS, and not WITH_COMPACTION)
+ * - first_splat (if BATCHED_DRAW)
+ * - oit_depth_scale (if WEIGHTED_OIT): Scales view depth (clip w) to meters,
+ *   the units weights are tuned for. Larger values favor nearer splats more.
  * - pos_scale_cm
  * - pos_min_cm
  *
@@ -16,35 +39,101 @@
  * - get_render_resolution: () -> half2
  */
 
+#if defined(BATCHED_DRAW) && defined(WITH_COMPACTION)
+#error "BATCHED_DRAW needs the number of splats on the CPU"
+#endif
+
+// Unsorted WEIGHTED_OIT draws are in index order.
+#if !defined(WEIGHTED_OIT) || defined(WITH_COMPACTION)
 #ifdef GPU_SORT
 Buffer<uint> indices;
 #else
 Buffer<uint2> indices;
 #endif
+#endif
 Buffer<uint> positions;
 Buffer<half4> transforms;
 Buffer<half4> colors;
+#ifdef FOOTPRINT_LIMITS
+Buffer<half> opacity_scales;
+#endif
+#if defined(INDEXED_QUADS) && defined(WITH_COMPACTION)
+Buffer<uint> indirect_args;
+#endif
 
 /**
  * Generates a vertex bounding a splat.
  *
- * @param in_id - Vertex index, of 6 * the number of splats.
+ * @param in_id - Vertex index, of 6 * the number of splats (or of visible
+ * splats, when drawn with the indirect arguments of `compact_scan.cs.hlsl`).
+ * With INDEXED_QUADS, vertex index within the instance, of 4 *
+ * QUADS_PER_INSTANCE.
+ * @param in_instance_id - With INDEXED_QUADS, block of QUADS_PER_INSTANCE
+ * splats.
  * @param in_view_id - Eye index (if relevant).
  * @param out_position - Clip space position, where (x, y) bounds the splat at
  * chosen value of σ.
  * @param out_sig_div_sqrt_2 - the radius of the splat, in σ's, over sqrt(2).
  * @param out_color - Base color of the splat.
+ * @param out_oit_depth - With WEIGHTED_OIT, view depth of the splat, scaled
+ * by `oit_depth_scale`.
  */
 void main(in uint in_id : SV_VertexID,
+#ifdef INDEXED_QUADS
+          in uint in_instance_id : SV_InstanceID,
+#endif
 #if WITH_VIEW_ID
           in uint in_view_id : SV_ViewID,
 #endif
           out half2 out_sig_div_sqrt_2 : DELTA_STD_DEVS,
           out nointerpolation half4 out_color : COLOR,
+#ifdef WEIGHTED_OIT
+          out nointerpolation float out_oit_depth : OIT_DEPTH,
+#endif
           out half4 out_position : SV_Position) {
+  // Zero every output up front, so that early returns emit a fully written,
+  // degenerate vertex.
+  out_sig_div_sqrt_2 = half2(0.f, 0.f);
+  out_color = half4(0.f, 0.f, 0.f, 0.f);
+#ifdef WEIGHTED_OIT
+  out_oit_depth = 0.f;
+#endif
+  out_position = half4(0.f, 0.f, 0.f, 0.f);
+
+#ifdef BATCHED_DRAW
+  uint first_sorted_index = first_splat;
+#else
+  uint first_sorted_index = 0;
+#endif
+
+#ifdef INDEXED_QUADS
+  uint sorted_index = first_sorted_index + in_instance_id * QUADS_PER_INSTANCE +
+                      in_id / VERTICES_PER_QUAD;
+  uint corner_id = in_id % VERTICES_PER_QUAD;
+
+#ifdef WITH_COMPACTION
+  uint num_drawn = indirect_args[INDIRECT_NUM_VISIBLE_OFFSET];
+#else
+  uint num_drawn = num_splats;
+#endif
+  // The last instance is only partially filled.
+  if (sorted_index >= num_drawn) {
+    return;
+  }
+#else
+  // Two triangles, sharing the two corners on the diagonal: 0 1 2, 1 2 3.
+  static const uint triangle_corners[VERTICES_PER_SPLAT] = {0, 1, 2, 1, 2, 3};
+  uint sorted_index = first_sorted_index + in_id / VERTICES_PER_SPLAT;
+  uint corner_id = triangle_corners[in_id % VERTICES_PER_SPLAT];
+#endif
+
+#if defined(WEIGHTED_OIT) && !defined(WITH_COMPACTION)
+  uint splat_id = sorted_index;
+#else
   // If using CPU sorting, indices are packed as (index, distance). No #if
   // needed if explicitly adding .x.
-  uint splat_id = indices[in_id / 6].x;
+  uint splat_id = indices[sorted_index].x;
+#endif
 
   half3 pos_local = unpack_pos(positions[splat_id], pos_scale_cm, pos_min_cm);
   half3 pos_world = mul(pos_local, (half3x3)local_to_world);
@@ -61,7 +150,6 @@ void main(in uint in_id : SV_VertexID,
                          pos_clip.z > pos_clip.w;
 
   if (outside_frustum) {
-    out_position = half4(0.f, 0.f, 0.f, 0.f);
     return;
   }
 
@@ -81,19 +169,32 @@ void main(in uint in_id : SV_VertexID,
 	 * the fragment shader, and used to determine the distance in σ from the
 	 * splat's center that a fragment is at.
 	 *
-	 * Note: Using RADIUS_SIGMA_OVER_SQRT_2 here rather than just +/-1, as it
+	 * Note: Using the radius over sqrt(2) here rather than just +/-1, as it
 	 * removes a multiply from the below `out_sig_div_sqrt_2` assignment.
 	 */
   half4 t = transforms[splat_id];
-  half2 corners[6] = {
-      half2(-RADIUS_SIGMA_OVER_SQRT_2, -RADIUS_SIGMA_OVER_SQRT_2),
-      half2(RADIUS_SIGMA_OVER_SQRT_2, -RADIUS_SIGMA_OVER_SQRT_2),
-      half2(-RADIUS_SIGMA_OVER_SQRT_2, RADIUS_SIGMA_OVER_SQRT_2),
-      half2(RADIUS_SIGMA_OVER_SQRT_2, -RADIUS_SIGMA_OVER_SQRT_2),
-      half2(-RADIUS_SIGMA_OVER_SQRT_2, RADIUS_SIGMA_OVER_SQRT_2),
-      half2(RADIUS_SIGMA_OVER_SQRT_2, RADIUS_SIGMA_OVER_SQRT_2)};
+  half4 color = colors[splat_id];
+#ifdef FOOTPRINT_LIMITS
+  // Compensates for clamping the footprint of large splats.
+  color.a = min(color.a * opacity_scales[splat_id], 1.f);
+#endif
+
+#ifdef OPACITY_ADAPTIVE_RADIUS
+  /**
+	 * A fragment's alpha is a * exp(-r_σ^2 / 2), which falls below MIN_ALPHA at
+	 * r_σ^2 / 2 = ln(a / MIN_ALPHA). Fragments beyond this contribute nothing,
+	 * so the quad is fit to it (capped at RADIUS_SIGMA). Splats with a <
+	 * MIN_ALPHA collapse to a point, and aren't rasterized at all.
+	 */
+  half radius = sqrt(clamp(log(color.a / MIN_ALPHA), 0.f,
+                           CUTOFF_RADIUS_SIGMA_SQUARED_OVER_2));
+#else
+  half radius = RADIUS_SIGMA_OVER_SQRT_2;
+#endif
+  half2 corners[4] = {half2(-radius, -radius), half2(radius, -radius),
+                      half2(-radius, radius), half2(radius, radius)};
   // Scale to xσ/sqrt(2).
-  half2 offset = mul(half2x2(t.x, t.y, t.z, t.w), corners[in_id % 6]);
+  half2 offset = mul(half2x2(t.x, t.y, t.z, t.w), corners[corner_id]);
   // (Pixel size * 2) to NDC.
   offset /= get_render_resolution();
 
@@ -101,7 +202,10 @@ void main(in uint in_id : SV_VertexID,
   out_position =
       half4(pos_clip.xy + offset * pos_clip.w, pos_clip.z, pos_clip.w);
   // Distance from center, in σ, for interpolating in fragment shader.
-  out_sig_div_sqrt_2 = corners[in_id % 6];
+  out_sig_div_sqrt_2 = corners[corner_id];
   // Color.
-  out_color = colors[splat_id];
+  out_color = color;
+#ifdef WEIGHTED_OIT
+  out_oit_depth = pos_clip.w * oit_depth_scale;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Composites splats drawn with FRONT_TO_BACK (see constants.hlsl) over the
+ * scene.
+ *
+ * The under operator starts from an empty pixel, so splats are drawn into
+ * their own target, cleared to 0 (alpha included), rather than into the
+ * scene's, whose alpha would hide them. The scene's depth may still be bound
+ * for the depth test. This pass then draws the result as a full-screen pass,
+ * with the blend state of back-to-front splats (over, see `get_blend_state`
+ * in splat_draw.h).
+ *
+ * Required headers:
+ * - constants.hlsl
+ */
+
+/**
+ * The color target splats were accumulated into, bound for reading.
+ */
+Texture2D<half4> accumulated;
+
+/**
+ * @param in_position - Pixel position.
+ * @param out_color - Color of the pixel's splats, and their total alpha.
+ */
+void main(in float4 in_position : SV_Position,
+          out half4 out_color : SV_Target0) {
+  half4 splats = accumulated.Load(int3(in_position.xy, 0));
+  // No splat visibly covered this pixel.
+  if (splats.a < MIN_ALPHA) {
+    discard;
+  }
+
+  // Colors were accumulated premultiplied, and the over blend state
+  // multiplies by alpha again.
+  out_color = half4(splats.rgb / splats.a, splats.a);
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Composites splats drawn with WEIGHTED_OIT (see constants.hlsl) over the
+ * scene.
+ *
+ * Drawn as a full-screen pass, with the blend state of back-to-front splats
+ * (over, see `get_blend_state` in splat_draw.h).
+ *
+ * Required headers:
+ * - constants.hlsl
+ */
+
+/**
+ * The accumulation and revealage targets splats were drawn into, bound for
+ * reading.
+ */
+Texture2D<half4> accumulated;
+Texture2D<half> revealage;
+
+/**
+ * @param in_position - Pixel position.
+ * @param out_color - Weighted average color of the pixel's splats, and their
+ * total alpha.
+ */
+void main(in float4 in_position : SV_Position,
+          out half4 out_color : SV_Target0) {
+  int3 pixel = int3(in_position.xy, 0);
+  half transmittance = revealage.Load(pixel);
+  // No splat visibly covered this pixel.
+  if (transmittance > 1.f - MIN_ALPHA) {
+    discard;
+  }
+
+  // Bounded, as the sum of weights may be tiny where only faint splats
+  // contribute.
+  float4 sum = accumulated.Load(pixel);
+  float3 average = sum.rgb / max(sum.a, 1e-5f);
+  out_color = half4(average, 1.f - transmittance);
+}
\ No newline at end of file
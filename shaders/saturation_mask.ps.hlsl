@@ -0,0 +1,34 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Marks saturated pixels for the FRONT_TO_BACK early-out (see
+ * constants.hlsl).
+ *
+ * Drawn between batches of splats as a full-screen pass, with color writes
+ * disabled, and the stencil set to replace with a reference of 1 where the
+ * fragment passes. Splat draws then test for a stencil of 0, so that early
+ * stencil rejects their fragments in pixels this marked.
+ *
+ * Each pass reads back the color target, which on tiled GPUs ends the render
+ * pass, so batches should be large (see `get_batched_draw_calls`).
+ *
+ * Required headers:
+ * - constants.hlsl
+ */
+
+/**
+ * The color target splats are accumulated into, bound for reading.
+ */
+Texture2D<half4> accumulated;
+
+/**
+ * @param in_position - Pixel position.
+ */
+void main(in float4 in_position : SV_Position) {
+  half alpha = accumulated.Load(int3(in_position.xy, 0)).a;
+  if (alpha < SATURATION_ALPHA) {
+    discard;
+  }
+}
\ No newline at end of file
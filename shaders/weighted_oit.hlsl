@@ -0,0 +1,31 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Depth weights of weighted blended order-independent transparency (see
+ * WEIGHTED_OIT in constants.hlsl).
+ *
+ * Required headers:
+ * - constants.hlsl
+ */
+
+/**
+ * Weights a fragment by its depth, so that near splats dominate the average
+ * color of each pixel. This is equation (9) of McGuire and Bavoil, "Weighted
+ * Blended Order-Independent Transparency" (2013), which is tuned for depths in
+ * [0.1, 500], i.e. meters.
+ *
+ * Computed in float, as the falloff overflows half past a few hundred.
+ *
+ * @param alpha - Alpha of the fragment.
+ * @param depth - View depth of the splat, scaled by `oit_depth_scale`.
+ * @return Weight of the fragment's color and alpha.
+ */
+float get_oit_weight(float alpha, float depth) {
+  float near = depth / 5.f;
+  float far = depth / 200.f;
+  float far_cubed = far * far * far;
+  float weight = 10.f / (1e-5f + near * near + far_cubed * far_cubed);
+  return alpha * clamp(weight, OIT_MIN_WEIGHT, OIT_MAX_WEIGHT);
+}
\ No newline at end of file
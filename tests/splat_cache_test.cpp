@@ -0,0 +1,162 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Tests of `SplatImportCache`.
+ *
+ * In a fresh temporary directory, checks that keys follow the source and
+ * settings, that stored buffers load back unchanged, that `load_or_import`
+ * only imports on a miss, and that failed imports, as well as corrupt and
+ * truncated entries, are never returned.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tests/splat_cache_test.cpp import/splat_cache.cpp \
+ *       import/splat_hash.cpp import/splat_logging.cpp -o splat_cache_test
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "import/splat_cache.h"
+#include "tests/splat_test.h"
+
+namespace tests {
+namespace {
+using import::ImportBuffers;
+using import::ImportCacheKey;
+using import::SplatImportCache;
+
+std::vector<uint8_t> make_bytes(size_t size, uint8_t seed) {
+  std::vector<uint8_t> bytes(size);
+  for (size_t i = 0; i < size; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 31 + seed);
+  }
+  return bytes;
+}
+
+void check_keys() {
+  std::vector<uint8_t> source = make_bytes(1000, 1);
+  std::vector<uint8_t> settings = make_bytes(16, 2);
+  ImportCacheKey key = SplatImportCache::make_key(source, settings);
+  SPLAT_CHECK(key == SplatImportCache::make_key(source, settings));
+  SPLAT_CHECK(key.source_size == source.size());
+
+  std::vector<uint8_t> edited = source;
+  edited[500] ^= 1;
+  SPLAT_CHECK(!(key == SplatImportCache::make_key(edited, settings)));
+  std::vector<uint8_t> other_settings = settings;
+  other_settings.back() ^= 1;
+  SPLAT_CHECK(!(key == SplatImportCache::make_key(source, other_settings)));
+}
+
+void check_round_trip(const SplatImportCache& cache) {
+  // Including empty buffers, and no buffers at all.
+  std::vector<ImportBuffers> cases = {
+      {make_bytes(12, 3), {}, make_bytes(1 << 20, 4)}, {}, {{}}};
+  for (size_t i = 0; i < cases.size(); ++i) {
+    std::vector<uint8_t> source = make_bytes(100 + i, 5);
+    ImportCacheKey key = SplatImportCache::make_key(source, {});
+    ImportBuffers loaded;
+    SPLAT_CHECK(!cache.load(key, loaded));
+    SPLAT_CHECK(cache.store(key, cases[i]));
+    loaded = {make_bytes(3, 6)};
+    SPLAT_CHECK(cache.load(key, loaded) && loaded == cases[i]);
+  }
+}
+
+void check_load_or_import(const SplatImportCache& cache) {
+  std::vector<uint8_t> source = make_bytes(5000, 7);
+  std::vector<uint8_t> settings = make_bytes(8, 8);
+  ImportBuffers imported = {make_bytes(64, 9), make_bytes(128, 10)};
+  uint32_t num_imports = 0;
+  auto import_fn = [&](ImportBuffers& buffers) {
+    ++num_imports;
+    buffers = imported;
+    return true;
+  };
+
+  ImportBuffers buffers;
+  SPLAT_CHECK(cache.load_or_import(source, settings, import_fn, buffers));
+  SPLAT_CHECK(num_imports == 1 && buffers == imported);
+  buffers.clear();
+  SPLAT_CHECK(cache.load_or_import(source, settings, import_fn, buffers));
+  SPLAT_CHECK(num_imports == 1 && buffers == imported);
+
+  // Failed imports are reported, and not cached.
+  std::vector<uint8_t> other_source = make_bytes(5000, 11);
+  auto fail_fn = [&](ImportBuffers&) {
+    ++num_imports;
+    return false;
+  };
+  SPLAT_CHECK(!cache.load_or_import(other_source, settings, fail_fn, buffers));
+  SPLAT_CHECK(num_imports == 2);
+  SPLAT_CHECK(!cache.load(SplatImportCache::make_key(other_source, settings),
+                          buffers));
+}
+
+void check_damaged_entries(const SplatImportCache& cache) {
+  std::vector<uint8_t> source = make_bytes(300, 12);
+  ImportCacheKey key = SplatImportCache::make_key(source, {});
+  ImportBuffers stored = {make_bytes(4096, 13)};
+  std::filesystem::path path = cache.get_entry_path(key);
+
+  // A flipped byte in the middle of the data.
+  SPLAT_CHECK(cache.store(key, stored));
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(2000);
+    char byte = static_cast<char>(file.get());
+    file.seekp(2000);
+    file.put(static_cast<char>(~byte));
+  }
+  ImportBuffers loaded;
+  SPLAT_CHECK(!cache.load(key, loaded));
+
+  // A partial entry.
+  SPLAT_CHECK(cache.store(key, stored));
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+  SPLAT_CHECK(!cache.load(key, loaded));
+
+  // Damaged entries are imported again, and replaced.
+  uint32_t num_imports = 0;
+  auto import_fn = [&](ImportBuffers& buffers) {
+    ++num_imports;
+    buffers = stored;
+    return true;
+  };
+  SPLAT_CHECK(cache.load_or_import(source, {}, import_fn, loaded));
+  SPLAT_CHECK(num_imports == 1 && loaded == stored);
+  SPLAT_CHECK(cache.load(key, loaded) && loaded == stored);
+}
+}  // namespace
+}  // namespace tests
+
+int main() {
+  using namespace tests;
+
+  set_log_recv(count_log);
+
+  std::error_code ec;
+  std::filesystem::path directory =
+      std::filesystem::temp_directory_path(ec) / "splat_cache_test";
+  std::filesystem::remove_all(directory, ec);
+
+  {
+    // Created on the first store.
+    SplatImportCache cache(directory / "entries");
+    check_keys();
+    check_round_trip(cache);
+    check_load_or_import(cache);
+    check_damaged_entries(cache);
+  }
+
+  std::filesystem::remove_all(directory, ec);
+  return report("splat_cache_test");
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Tests of `compact_visible`.
+ *
+ * Compacts random keys, with varying fractions of culled splats, and checks
+ * the result against a stable partition: visible splats first, in their
+ * original order, with the rest of the compacted buffers untouched. Sizes
+ * cover the empty case, a single thread group, and several tasks. Also checks
+ * the indirect arguments derived from the count.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tests/splat_compaction_test.cpp render/splat_compaction.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp -o splat_compaction_test
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "render/splat_compaction.h"
+#include "render/splat_constants.h"
+#include "tests/splat_test.h"
+
+namespace tests {
+namespace {
+constexpr uint32_t thread_group_size = 64;
+// Written to the compacted buffers beforehand, to check the tail is kept.
+constexpr uint32_t untouched = 0xDEADBEEF;
+
+void check_compaction(uint32_t num_splats, float visible_ratio) {
+  std::mt19937 random(num_splats);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+  std::uniform_int_distribution<uint32_t> key(
+      0, render::distance_not_visible - 1);
+  std::vector<uint32_t> indices(num_splats);
+  std::vector<uint32_t> distances(num_splats);
+  for (uint32_t i = 0; i < num_splats; ++i) {
+    // Shuffled indices, as written in any order by the distance pass.
+    indices[i] = static_cast<uint32_t>(random());
+    distances[i] = unit(random) < visible_ratio
+                       ? key(random)
+                       : render::distance_not_visible;
+  }
+
+  std::vector<uint32_t> expected_indices(num_splats, untouched);
+  std::vector<uint32_t> expected_distances(num_splats, untouched);
+  uint32_t num_visible = 0;
+  for (uint32_t i = 0; i < num_splats; ++i) {
+    if (distances[i] != render::distance_not_visible) {
+      expected_indices[num_visible] = indices[i];
+      expected_distances[num_visible++] = distances[i];
+    }
+  }
+
+  std::vector<uint32_t> compacted_indices(num_splats, untouched);
+  std::vector<uint32_t> compacted_distances(num_splats, untouched);
+  render::CompactionArgs args = render::compact_visible(
+      indices, distances, render::distance_not_visible, thread_group_size,
+      compacted_indices, compacted_distances);
+  SPLAT_CHECK(compacted_indices == expected_indices);
+  SPLAT_CHECK(compacted_distances == expected_distances);
+
+  SPLAT_CHECK(args.num_visible == num_visible);
+  uint32_t num_threads = args.dispatch_thread_group_count[0] *
+                         thread_group_size;
+  SPLAT_CHECK(num_threads >= num_visible &&
+              num_threads < num_visible + thread_group_size);
+  SPLAT_CHECK(args.dispatch_thread_group_count[1] == 1 &&
+              args.dispatch_thread_group_count[2] == 1);
+  SPLAT_CHECK(args.draw_vertex_count_per_instance ==
+              num_visible * render::vertices_per_splat);
+  SPLAT_CHECK(args.draw_instance_count == 1);
+  SPLAT_CHECK(args.draw_indexed_index_count_per_instance ==
+              render::quads_per_instance * render::indices_per_quad);
+  uint32_t num_quads =
+      args.draw_indexed_instance_count * render::quads_per_instance;
+  SPLAT_CHECK(num_quads >= num_visible &&
+              num_quads < num_visible + render::quads_per_instance);
+}
+}  // namespace
+}  // namespace tests
+
+int main() {
+  using namespace tests;
+
+  set_log_recv(count_log);
+
+  for (uint32_t num_splats : {0u, 1u, 63u, 1'000u, 300'001u}) {
+    for (float visible_ratio : {0.f, 0.01f, 0.5f, 1.f}) {
+      check_compaction(num_splats, visible_ratio);
+    }
+  }
+  return report("splat_compaction_test");
+}
\ No newline at end of file
@@ -0,0 +1,228 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Tests of the draw setup of `splat_draw.h`.
+ *
+ * Replays the draw calls of `get_draw_call` and `get_batched_draw_calls`,
+ * with the index buffer of `generate_quad_indices`, through the vertex
+ * indexing of `render_splat.vs.hlsl`, and checks that each splat is drawn
+ * exactly once, as the two triangles of its quad. Then blends random layers
+ * with the states of `get_blend_state`, and checks that front-to-back drawing
+ * composited by `resolve_front_to_back.ps.hlsl`, and a single layer of
+ * weighted blended transparency composited by `resolve_weighted_oit.ps.hlsl`,
+ * both match back-to-front drawing over the scene.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tests/splat_draw_test.cpp render/splat_draw.cpp \
+ *       import/splat_logging.cpp -o splat_draw_test
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "render/splat_constants.h"
+#include "render/splat_draw.h"
+#include "tests/splat_test.h"
+
+namespace tests {
+namespace {
+using render::BlendFactor;
+using render::SplatBlendMode;
+using render::SplatBlendState;
+using render::SplatDrawCall;
+using render::SplatDrawMode;
+
+typedef std::array<float, 4> Color;
+
+/**
+ * Replays draw calls as `render_splat.vs.hlsl` indexes them.
+ *
+ * @return Per splat, the corners of each triangle drawn, in order.
+ */
+std::vector<std::vector<uint32_t>> replay(
+    SplatDrawMode mode, uint32_t num_splats,
+    const std::vector<SplatDrawCall>& draw_calls,
+    const std::vector<uint16_t>& quad_indices) {
+  constexpr uint32_t triangle_corners[render::vertices_per_splat] = {
+      0, 1, 2, 1, 2, 3};
+  // Extra entries catch splats drawn past the end.
+  std::vector<std::vector<uint32_t>> corners(num_splats + 1);
+  for (const SplatDrawCall& draw_call : draw_calls) {
+    SPLAT_CHECK(draw_call.is_indexed == (mode == SplatDrawMode::IndexedQuads));
+    for (uint32_t instance = 0; instance < draw_call.instance_count;
+         ++instance) {
+      for (uint32_t i = 0; i < draw_call.count_per_instance; ++i) {
+        uint32_t sorted_index = 0;
+        uint32_t corner = 0;
+        if (draw_call.is_indexed) {
+          uint32_t id = quad_indices[i];
+          sorted_index = draw_call.first_splat +
+                         instance * render::quads_per_instance +
+                         id / render::vertices_per_quad;
+          corner = id % render::vertices_per_quad;
+          // The last instance is only partially filled.
+          if (sorted_index >= num_splats) {
+            continue;
+          }
+        } else {
+          sorted_index = draw_call.first_splat + i / render::vertices_per_splat;
+          corner = triangle_corners[i % render::vertices_per_splat];
+        }
+        corners[std::min(sorted_index, num_splats)].push_back(corner);
+      }
+    }
+  }
+  return corners;
+}
+
+void check_draw_calls(SplatDrawMode mode, uint32_t num_splats,
+                      const std::vector<SplatDrawCall>& draw_calls,
+                      const std::vector<uint16_t>& quad_indices) {
+  const std::vector<uint32_t> expected = {0, 1, 2, 1, 2, 3};
+  std::vector<std::vector<uint32_t>> corners =
+      replay(mode, num_splats, draw_calls, quad_indices);
+  bool is_valid = corners.back().empty();
+  for (uint32_t splat = 0; splat < num_splats; ++splat) {
+    is_valid &= corners[splat] == expected;
+  }
+  SPLAT_CHECK(is_valid);
+}
+
+float get_factor(BlendFactor factor, float src, float src_alpha,
+                 float dst_alpha) {
+  switch (factor) {
+    case BlendFactor::Zero:
+      return 0.f;
+    case BlendFactor::One:
+      return 1.f;
+    case BlendFactor::SrcAlpha:
+      return src_alpha;
+    case BlendFactor::OneMinusSrcColor:
+      return 1.f - src;
+    case BlendFactor::OneMinusSrcAlpha:
+      return 1.f - src_alpha;
+    case BlendFactor::OneMinusDstAlpha:
+      return 1.f - dst_alpha;
+  }
+  return 0.f;
+}
+
+/**
+ * Blends as graphics APIs do, with an add blend op.
+ */
+void blend(const SplatBlendState& state, const Color& src, Color& dst) {
+  float dst_alpha = dst[3];
+  for (uint32_t channel = 0; channel < 4; ++channel) {
+    bool is_alpha = channel == 3;
+    float src_factor =
+        get_factor(is_alpha ? state.src_alpha : state.src_color, src[channel],
+                   src[3], dst_alpha);
+    float dst_factor =
+        get_factor(is_alpha ? state.dst_alpha : state.dst_color, src[channel],
+                   src[3], dst_alpha);
+    dst[channel] = src[channel] * src_factor + dst[channel] * dst_factor;
+  }
+}
+
+bool is_near(const Color& a, const Color& b) {
+  for (uint32_t channel = 0; channel < 3; ++channel) {
+    if (std::abs(a[channel] - b[channel]) > 1e-4f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void check_blending() {
+  std::mt19937 random(0x5EED);
+  std::uniform_real_distribution<float> unit(0.f, 1.f);
+  SplatBlendState over = render::get_blend_state(SplatBlendMode::BackToFront);
+  SplatBlendState under = render::get_blend_state(SplatBlendMode::FrontToBack);
+  SplatBlendState accumulate =
+      render::get_blend_state(SplatBlendMode::WeightedOIT, 0);
+  SplatBlendState reveal =
+      render::get_blend_state(SplatBlendMode::WeightedOIT, 1);
+
+  for (uint32_t pixel = 0; pixel < 100; ++pixel) {
+    // Opaque scene, then layers from back to front.
+    Color scene = {unit(random), unit(random), unit(random), 1.f};
+    std::vector<Color> layers(1 + pixel % 20);
+    for (Color& layer : layers) {
+      layer = {unit(random), unit(random), unit(random), unit(random)};
+    }
+
+    Color expected = scene;
+    for (const Color& layer : layers) {
+      blend(over, layer, expected);
+    }
+
+    // Premultiplied, into a target cleared to 0, then resolved.
+    Color splats = {};
+    for (auto layer = layers.rbegin(); layer != layers.rend(); ++layer) {
+      Color src = {(*layer)[0] * (*layer)[3], (*layer)[1] * (*layer)[3],
+                   (*layer)[2] * (*layer)[3], (*layer)[3]};
+      blend(under, src, splats);
+    }
+    Color composited = scene;
+    if (splats[3] >= render::min_alpha) {
+      Color resolved = {splats[0] / splats[3], splats[1] / splats[3],
+                        splats[2] / splats[3], splats[3]};
+      blend(over, resolved, composited);
+    }
+    SPLAT_CHECK(is_near(composited, expected));
+
+    // Any weight is exact for a single layer.
+    const Color& layer = layers.front();
+    float weight = layer[3] * (0.1f + unit(random));
+    Color accumulated = {};
+    blend(accumulate,
+          {layer[0] * weight, layer[1] * weight, layer[2] * weight, weight},
+          accumulated);
+    Color revealage = {1.f, 1.f, 1.f, 1.f};
+    blend(reveal, {layer[3], layer[3], layer[3], layer[3]}, revealage);
+    Color single = scene;
+    blend(over, layer, single);
+    composited = scene;
+    blend(over,
+          {accumulated[0] / accumulated[3], accumulated[1] / accumulated[3],
+           accumulated[2] / accumulated[3], 1.f - revealage[0]},
+          composited);
+    SPLAT_CHECK(is_near(composited, single));
+  }
+}
+}  // namespace
+}  // namespace tests
+
+int main() {
+  using namespace tests;
+
+  set_log_recv(count_log);
+
+  std::vector<uint16_t> quad_indices = render::generate_quad_indices();
+  SPLAT_CHECK(quad_indices.size() ==
+              render::quads_per_instance * render::indices_per_quad);
+  for (SplatDrawMode mode :
+       {SplatDrawMode::Triangles, SplatDrawMode::IndexedQuads}) {
+    for (uint32_t num_splats : {0u, 1u, 5u, 16'384u, 16'385u, 50'000u}) {
+      check_draw_calls(mode, num_splats,
+                       {render::get_draw_call(mode, num_splats)},
+                       quad_indices);
+      for (uint32_t splats_per_batch : {0u, 1u, 1'000u, 20'000u}) {
+        check_draw_calls(mode, num_splats,
+                         render::get_batched_draw_calls(mode, num_splats,
+                                                        splats_per_batch),
+                         quad_indices);
+      }
+    }
+  }
+  check_blending();
+  return report("splat_draw_test");
+}
\ No newline at end of file
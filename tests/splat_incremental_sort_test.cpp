@@ -0,0 +1,115 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Tests of `IncrementalSorter`.
+ *
+ * Moves the camera along a path of small steps, then jumps, then stands still,
+ * and checks each frame against a full sort by `SplatSorter`: the same splats
+ * are visible, with the same keys, in ascending key order, followed by all
+ * culled splats. Skipped frames must keep the previous order as-is. Runs the
+ * path with the default `skip_threshold`, then with a threshold of 1 key, and
+ * checks that full sorts, repairs and skips are all exercised.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tests/splat_incremental_sort_test.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_incremental_sort.cpp \
+ *       render/splat_sort.cpp import/splat_logging.cpp \
+ *       import/splat_parallel.cpp import/splat_tracing.cpp \
+ *       import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_incremental_sort_test
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "render/splat_incremental_sort.h"
+#include "render/splat_sort.h"
+#include "tests/splat_test.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tests {
+namespace {
+constexpr uint32_t num_results = 4;
+
+/**
+ * Runs the path with a `skip_threshold`.
+ *
+ * @return Frames per `IncrementalSortResult`.
+ */
+std::vector<uint32_t> run_path(const tools::Scene& scene,
+                               const tools::PackedPositions& packed,
+                               uint32_t skip_threshold) {
+  render::IncrementalSortSettings settings;
+  settings.skip_threshold = skip_threshold;
+  render::IncrementalSorter incremental_sorter(settings);
+  render::SplatSorter sorter;
+  std::vector<render::SortedSplat> expected(packed.positions.size());
+  std::vector<render::SortedSplat> previous;
+
+  // 0.01 degree steps, then a quarter turn, then a still camera.
+  std::vector<tools::View> path;
+  for (uint32_t frame = 0; frame < 20; ++frame) {
+    path.push_back(tools::make_orbit_view(scene, frame, 36'000));
+  }
+  path.push_back(tools::make_orbit_view(scene, 1, 4));
+  path.push_back(path.back());
+
+  std::vector<uint32_t> num_frames(num_results);
+  for (const tools::View& view : path) {
+    render::DistanceParams params =
+        tools::make_distance_params(packed, view, 90.f, 1.f);
+    uint32_t num_visible = incremental_sorter.sort(packed.positions, params);
+    render::IncrementalSortResult result =
+        incremental_sorter.get_stats().result;
+    ++num_frames[static_cast<uint32_t>(result)];
+    std::span<const render::SortedSplat> sorted =
+        incremental_sorter.get_sorted();
+
+    if (result == render::IncrementalSortResult::Skipped) {
+      SPLAT_CHECK(std::equal(sorted.begin(), sorted.end(), previous.begin(),
+                             previous.end(),
+                             [](const render::SortedSplat& a,
+                                const render::SortedSplat& b) {
+                               return a.index == b.index &&
+                                      a.distance == b.distance;
+                             }));
+    } else {
+      uint32_t num_expected = sorter.sort(packed.positions, params, expected);
+      check_sorted(sorted, num_visible, sorter.get_distances(), num_expected,
+                   render::get_distance_not_visible(params));
+    }
+    previous.assign(sorted.begin(), sorted.end());
+  }
+  return num_frames;
+}
+}  // namespace
+}  // namespace tests
+
+int main() {
+  using namespace tests;
+
+  set_log_recv(count_log);
+
+  tools::Scene scene;
+  if (!SPLAT_CHECK(tools::generate_scene(200'000, scene))) {
+    return report("splat_incremental_sort_test");
+  }
+  tools::PackedPositions packed = tools::pack_positions(scene);
+
+  using Result = render::IncrementalSortResult;
+  std::vector<uint32_t> num_frames = run_path(scene, packed, 0);
+  SPLAT_CHECK(num_frames[static_cast<uint32_t>(Result::Full)] >= 2);
+  SPLAT_CHECK(num_frames[static_cast<uint32_t>(Result::Repaired)] > 0);
+  SPLAT_CHECK(num_frames[static_cast<uint32_t>(Result::Skipped)] > 0);
+
+  num_frames = run_path(scene, packed, 1);
+  SPLAT_CHECK(num_frames[static_cast<uint32_t>(Result::Full)] >= 2);
+  SPLAT_CHECK(num_frames[static_cast<uint32_t>(Result::Skipped)] > 1);
+  return report("splat_incremental_sort_test");
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Tests of `KdTree`.
+ *
+ * Builds trees over random points, clustered and partly coincident, with
+ * several leaf sizes, and checks `find_nearest` and `find_within` against
+ * brute force searches, for queries both at points of the tree and elsewhere.
+ * Neighbors at equal distances may be returned in any order, so nearest
+ * neighbors are compared by distance.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tests/splat_kd_tree_test.cpp import/splat_kd_tree.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp -o splat_kd_tree_test
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "import/splat_kd_tree.h"
+#include "tests/splat_test.h"
+
+namespace tests {
+namespace {
+using import::Float3;
+using import::KdNeighbor;
+
+std::vector<Float3> generate_points(uint32_t num_points) {
+  std::mt19937 random(num_points);
+  std::uniform_real_distribution<float> unit(-1.f, 1.f);
+  std::vector<Float3> points;
+  Float3 center;
+  for (uint32_t i = 0; i < num_points; ++i) {
+    // Clusters of 100 points, every tenth point repeating the previous one.
+    if (i % 100 == 0) {
+      center = Float3(10.f * unit(random), 10.f * unit(random),
+                      10.f * unit(random));
+    }
+    if (i % 10 == 9) {
+      points.push_back(points.back());
+    } else {
+      points.push_back(center + Float3(unit(random), unit(random),
+                                       0.1f * unit(random)));
+    }
+  }
+  return points;
+}
+
+std::vector<KdNeighbor> find_all(const std::vector<Float3>& points,
+                                 const Float3& point) {
+  std::vector<KdNeighbor> neighbors(points.size());
+  for (uint32_t i = 0; i < points.size(); ++i) {
+    Float3 d = points[i] - point;
+    neighbors[i] = {dot(d, d), i};
+  }
+  std::stable_sort(neighbors.begin(), neighbors.end(),
+                   [](const KdNeighbor& a, const KdNeighbor& b) {
+                     return a.distance_squared < b.distance_squared;
+                   });
+  return neighbors;
+}
+
+void check_queries(const std::vector<Float3>& points,
+                   uint32_t max_leaf_points) {
+  import::KdTree tree;
+  if (!SPLAT_CHECK(tree.build(points, max_leaf_points))) {
+    return;
+  }
+  SPLAT_CHECK(tree.get_points().size() == points.size());
+
+  std::mt19937 random(max_leaf_points);
+  std::uniform_real_distribution<float> unit(-12.f, 12.f);
+  std::vector<KdNeighbor> neighbors;
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> expected_indices;
+  for (uint32_t query = 0; query < 200; ++query) {
+    Float3 point = query % 2 == 0 && !points.empty()
+                       ? points[random() % points.size()]
+                       : Float3(unit(random), unit(random), unit(random));
+    std::vector<KdNeighbor> all = find_all(points, point);
+
+    for (uint32_t k : {1u, 8u, 30u}) {
+      tree.find_nearest(point, k, neighbors);
+      size_t num_expected = std::min<size_t>(k, points.size());
+      if (!SPLAT_CHECK(neighbors.size() == num_expected)) {
+        continue;
+      }
+      // Each neighbor is at the distance it reports, and the i-th nearest.
+      bool is_valid = true;
+      for (size_t i = 0; i < num_expected && is_valid; ++i) {
+        const KdNeighbor& neighbor = neighbors[i];
+        is_valid &= neighbor.index < points.size();
+        if (is_valid) {
+          Float3 d = points[neighbor.index] - point;
+          is_valid &= neighbor.distance_squared == dot(d, d) &&
+                      neighbor.distance_squared == all[i].distance_squared;
+        }
+      }
+      SPLAT_CHECK(is_valid);
+      indices.clear();
+      for (const KdNeighbor& neighbor : neighbors) {
+        indices.push_back(neighbor.index);
+      }
+      std::sort(indices.begin(), indices.end());
+      SPLAT_CHECK(std::adjacent_find(indices.begin(), indices.end()) ==
+                  indices.end());
+    }
+
+    for (float radius : {0.f, 0.3f, 2.f}) {
+      tree.find_within(point, radius, neighbors);
+      indices.clear();
+      for (const KdNeighbor& neighbor : neighbors) {
+        indices.push_back(neighbor.index);
+      }
+      std::sort(indices.begin(), indices.end());
+      expected_indices.clear();
+      for (const KdNeighbor& neighbor : all) {
+        if (neighbor.distance_squared <= radius * radius) {
+          expected_indices.push_back(neighbor.index);
+        }
+      }
+      std::sort(expected_indices.begin(), expected_indices.end());
+      SPLAT_CHECK(indices == expected_indices);
+    }
+  }
+}
+}  // namespace
+}  // namespace tests
+
+int main() {
+  using namespace tests;
+
+  set_log_recv(count_log);
+
+  for (uint32_t num_points : {0u, 1u, 7u, 20'000u}) {
+    std::vector<import::Float3> points = generate_points(num_points);
+    for (uint32_t max_leaf_points : {1u, 8u, 64u}) {
+      check_queries(points, max_leaf_points);
+    }
+  }
+
+  import::KdTree tree;
+  SPLAT_CHECK(!tree.build(generate_points(10), 0));
+  SPLAT_CHECK(num_logged_errors == 1);
+  return report("splat_kd_tree_test");
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Tests of `build_lod` and `select_lod_cut`.
+ *
+ * Builds hierarchies over random splats, a tenth of them coincident, with the
+ * default and a larger `max_leaf_splats`, and checks the shape of the tree:
+ * every source splat is a leaf exactly once, children are contiguous and one
+ * level deeper, and parents bound their children. Then checks that cuts at
+ * several budgets represent every source splat exactly once.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tests/splat_lod_test.cpp import/splat_lod.cpp import/splat_morton.cpp \
+ *       import/splat_covariance.cpp render/splat_lod.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp -o splat_lod_test
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "import/splat_lod.h"
+#include "render/splat_lod.h"
+#include "tests/splat_test.h"
+
+namespace tests {
+namespace {
+using import::Float3;
+using import::Float4;
+
+struct Splats {
+  std::vector<Float3> positions;
+  std::vector<Float4> rotations;
+  std::vector<Float3> scales;
+  std::vector<Float4> colors;
+};
+
+Splats generate_splats(uint32_t num_splats) {
+  std::mt19937 random(0x5EED);
+  std::uniform_real_distribution<float> unit(-1.f, 1.f);
+  std::uniform_real_distribution<float> log_scale(-7.f, -3.f);
+  Splats splats;
+  for (uint32_t i = 0; i < num_splats; ++i) {
+    // Every tenth splat repeats the previous one, so some cells can't split.
+    if (i % 10 == 9) {
+      splats.positions.push_back(splats.positions.back());
+      splats.rotations.push_back(splats.rotations.back());
+      splats.scales.push_back(splats.scales.back());
+      splats.colors.push_back(splats.colors.back());
+      continue;
+    }
+    splats.positions.emplace_back(10.f * unit(random), 10.f * unit(random),
+                                  2.f * unit(random));
+    Float4 rotation(unit(random), unit(random), unit(random), unit(random));
+    float norm = std::sqrt(rotation.x * rotation.x + rotation.y * rotation.y +
+                           rotation.z * rotation.z + rotation.w * rotation.w);
+    splats.rotations.emplace_back(rotation.x / norm, rotation.y / norm,
+                                  rotation.z / norm, rotation.w / norm);
+    splats.scales.emplace_back(std::exp(log_scale(random)),
+                               std::exp(log_scale(random)),
+                               std::exp(log_scale(random)));
+    splats.colors.emplace_back(0.5f + 0.5f * unit(random),
+                               0.5f + 0.5f * unit(random),
+                               0.5f + 0.5f * unit(random),
+                               0.5f + 0.5f * unit(random));
+  }
+  return splats;
+}
+
+void check_tree(const import::SplatLod& lod,
+                const import::LodSettings& settings, size_t num_splats) {
+  size_t num_nodes = lod.nodes.size();
+  SPLAT_CHECK(lod.positions.size() == num_nodes);
+  SPLAT_CHECK(lod.level_offsets.front() == 0);
+  SPLAT_CHECK(lod.level_offsets.back() == num_nodes);
+
+  std::vector<uint32_t> depths(num_nodes);
+  for (size_t level = 0; level + 1 < lod.level_offsets.size(); ++level) {
+    SPLAT_CHECK(lod.level_offsets[level] < lod.level_offsets[level + 1]);
+    for (uint32_t node = lod.level_offsets[level];
+         node < lod.level_offsets[level + 1]; ++node) {
+      depths[node] = static_cast<uint32_t>(level);
+    }
+  }
+
+  std::vector<uint32_t> leaf_counts(num_splats);
+  std::vector<uint32_t> parent_counts(num_nodes);
+  uint32_t max_children = std::max(settings.max_leaf_splats, 8u);
+  bool is_valid = true;
+  for (uint32_t node = 0; node < num_nodes && is_valid; ++node) {
+    const import::LodNode& parent = lod.nodes[node];
+    if (parent.num_children == 0) {
+      is_valid &= SPLAT_CHECK(parent.source_index < num_splats);
+      if (is_valid) {
+        ++leaf_counts[parent.source_index];
+      }
+      continue;
+    }
+    is_valid &= SPLAT_CHECK(parent.source_index == import::lod_no_source);
+    is_valid &= SPLAT_CHECK(parent.num_children >= 2 &&
+                            parent.num_children <= max_children);
+    is_valid &= SPLAT_CHECK(parent.first_child > node &&
+                            parent.first_child + parent.num_children <=
+                                num_nodes);
+    for (uint32_t child = parent.first_child;
+         is_valid && child < parent.first_child + parent.num_children;
+         ++child) {
+      ++parent_counts[child];
+      is_valid &= SPLAT_CHECK(depths[child] == depths[node] + 1);
+      float reach = length(lod.positions[child] - lod.positions[node]) +
+                    lod.nodes[child].radius;
+      is_valid &= SPLAT_CHECK(reach <= parent.radius * 1.0001f + 1e-6f);
+    }
+  }
+  SPLAT_CHECK(std::all_of(leaf_counts.begin(), leaf_counts.end(),
+                          [](uint32_t count) { return count == 1; }));
+  SPLAT_CHECK(parent_counts[0] == 0);
+  SPLAT_CHECK(std::all_of(parent_counts.begin() + 1, parent_counts.end(),
+                          [](uint32_t count) { return count == 1; }));
+}
+
+void check_cuts(const import::SplatLod& lod, size_t num_splats) {
+  render::LodCutParams params;
+  params.camera_position = Float3(30.f, 0.f, 5.f);
+  params.focal_length = 960.f;
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> stack;
+  std::vector<uint32_t> covered(num_splats);
+  for (uint32_t max_splats : {1u, 100u, 10'000u, 0xFFFFFFFFu}) {
+    params.max_splats = max_splats;
+    render::select_lod_cut(lod.nodes, lod.positions, params, indices);
+    SPLAT_CHECK(!indices.empty() && indices.size() <= max_splats);
+
+    std::fill(covered.begin(), covered.end(), 0);
+    for (uint32_t index : indices) {
+      stack.push_back(index);
+      while (!stack.empty()) {
+        const import::LodNode& node = lod.nodes[stack.back()];
+        stack.pop_back();
+        if (node.num_children == 0) {
+          ++covered[node.source_index];
+        }
+        for (uint32_t child = 0; child < node.num_children; ++child) {
+          stack.push_back(node.first_child + child);
+        }
+      }
+    }
+    SPLAT_CHECK(std::all_of(covered.begin(), covered.end(),
+                            [](uint32_t count) { return count == 1; }));
+  }
+}
+}  // namespace
+}  // namespace tests
+
+int main() {
+  using namespace tests;
+
+  set_log_recv(count_log);
+
+  constexpr uint32_t num_splats = 100'000;
+  Splats splats = generate_splats(num_splats);
+  for (uint32_t max_leaf_splats : {8u, 32u}) {
+    import::LodSettings settings;
+    settings.max_leaf_splats = max_leaf_splats;
+    import::SplatLod lod;
+    if (SPLAT_CHECK(import::build_lod(splats.positions, splats.rotations,
+                                      splats.scales, splats.colors, settings,
+                                      lod))) {
+      check_tree(lod, settings, num_splats);
+      check_cuts(lod, num_splats);
+    }
+  }
+
+  import::LodSettings settings;
+  settings.max_leaf_splats = 1;
+  import::SplatLod lod;
+  SPLAT_CHECK(!import::build_lod(splats.positions, splats.rotations,
+                                 splats.scales, splats.colors, settings, lod));
+  SPLAT_CHECK(num_logged_errors == 1);
+  return report("splat_lod_test");
+}
\ No newline at end of file
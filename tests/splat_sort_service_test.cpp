@@ -0,0 +1,147 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Tests of `SplatSortService`.
+ *
+ * Checks what `acquire` returns before the first sort, after a sort, when
+ * nothing new was sorted, and after a skipped sort: `is_new` is only set for
+ * orders which weren't acquired yet. Then submits views faster than they are
+ * sorted while acquiring from another thread, and checks that each acquired
+ * order is complete and no older than the previous one, and that the last
+ * view is the one sorted in the end. Orders are checked against a full sort
+ * by `SplatSorter`.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tests/splat_sort_service_test.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_sort_service.cpp \
+ *       render/splat_incremental_sort.cpp render/splat_sort.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_sort_service_test
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "render/splat_sort.h"
+#include "render/splat_sort_service.h"
+#include "tests/splat_test.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tests {
+namespace {
+constexpr uint32_t num_path_views = 100;
+
+/**
+ * Checks an acquired order against a full sort for `params`.
+ */
+void check_frame(const render::SortedFrame& frame,
+                 const tools::PackedPositions& packed,
+                 const render::DistanceParams& params) {
+  render::SplatSorter sorter;
+  std::vector<render::SortedSplat> expected(packed.positions.size());
+  uint32_t num_expected = sorter.sort(packed.positions, params, expected);
+  check_sorted(frame.splats, frame.num_visible, sorter.get_distances(),
+               num_expected, render::get_distance_not_visible(params));
+}
+
+void check_acquire(const tools::Scene& scene,
+                   const tools::PackedPositions& packed) {
+  render::SplatSortService service(packed.positions);
+  render::SortedFrame frame = service.acquire(0);
+  SPLAT_CHECK(frame.splats.empty() && !frame.is_new);
+
+  render::DistanceParams params = tools::make_distance_params(
+      packed, tools::make_orbit_view(scene, 0, 4), 90.f, 1.f);
+  service.submit(params, 1);
+  service.wait_idle();
+  frame = service.acquire(1);
+  SPLAT_CHECK(frame.is_new && frame.sorted_frame == 1 && frame.age == 0);
+  check_frame(frame, packed, params);
+
+  // Nothing new.
+  frame = service.acquire(2);
+  SPLAT_CHECK(!frame.is_new && frame.sorted_frame == 1 && frame.age == 1);
+  check_frame(frame, packed, params);
+
+  // The same view again is skipped, and republishes the same order.
+  service.submit(params, 3);
+  service.wait_idle();
+  frame = service.acquire(3);
+  SPLAT_CHECK(frame.stats.result == render::IncrementalSortResult::Skipped);
+  SPLAT_CHECK(!frame.is_new && frame.sorted_frame == 3 && frame.age == 0);
+  check_frame(frame, packed, params);
+
+  params = tools::make_distance_params(
+      packed, tools::make_orbit_view(scene, 1, 4), 90.f, 1.f);
+  service.submit(params, 4);
+  service.wait_idle();
+  frame = service.acquire(4);
+  SPLAT_CHECK(frame.is_new && frame.sorted_frame == 4);
+  check_frame(frame, packed, params);
+}
+
+void check_concurrent(const tools::Scene& scene,
+                      const tools::PackedPositions& packed) {
+  std::vector<render::DistanceParams> views;
+  for (uint32_t view = 0; view < num_path_views; ++view) {
+    views.push_back(tools::make_distance_params(
+        packed, tools::make_orbit_view(scene, view, num_path_views), 90.f,
+        1.f));
+  }
+
+  render::SplatSortService service(packed.positions);
+  std::atomic<bool> is_submitting = true;
+  std::thread render_thread([&] {
+    uint64_t last_frame = 0;
+    uint64_t frame_number = 0;
+    while (is_submitting.load()) {
+      render::SortedFrame frame = service.acquire(++frame_number);
+      if (frame.splats.empty()) {
+        continue;
+      }
+      SPLAT_CHECK(frame.sorted_frame >= last_frame &&
+                  frame.sorted_frame <= num_path_views);
+      if (frame.is_new) {
+        check_frame(frame, packed, views[frame.sorted_frame - 1]);
+      }
+      last_frame = frame.sorted_frame;
+    }
+  });
+
+  // Frame numbers start at 1, so that 0 means no sort.
+  for (uint32_t view = 0; view < num_path_views; ++view) {
+    service.submit(views[view], view + 1);
+    std::this_thread::yield();
+  }
+  service.wait_idle();
+  is_submitting = false;
+  render_thread.join();
+
+  render::SortedFrame frame = service.acquire(num_path_views);
+  SPLAT_CHECK(frame.sorted_frame == num_path_views);
+  check_frame(frame, packed, views.back());
+}
+}  // namespace
+}  // namespace tests
+
+int main() {
+  using namespace tests;
+
+  set_log_recv(count_log);
+
+  tools::Scene scene;
+  if (!SPLAT_CHECK(tools::generate_scene(100'000, scene))) {
+    return report("splat_sort_service_test");
+  }
+  tools::PackedPositions packed = tools::pack_positions(scene);
+  check_acquire(scene, packed);
+  check_concurrent(scene, packed);
+  return report("splat_sort_service_test");
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_sort.h"
+
+/**
+ * Checks a condition, printing it and counting a failure if it doesn't hold,
+ * without stopping the test.
+ *
+ * @return Whether the condition holds.
+ */
+#define SPLAT_CHECK(condition) \
+  ::tests::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+namespace tests {
+/**
+ * Number of failed checks so far.
+ */
+inline uint32_t num_failures = 0;
+
+/**
+ * Number of errors logged so far, e.g. by rejected settings.
+ */
+inline uint32_t num_logged_errors = 0;
+
+inline bool check(bool is_valid, const char* condition, const char* file,
+                  int line) {
+  if (!is_valid) {
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+    ++num_failures;
+  }
+  return is_valid;
+}
+
+/**
+ * Log receiver for `set_log_recv`, counting errors.
+ */
+inline void count_log(Level level, const char* message) {
+  num_logged_errors += level == Level::ERROR;
+  fprintf(stderr, "%s: %s\n", level == Level::ERROR ? "error" : "warning",
+          message);
+}
+
+/**
+ * Checks an order against the keys of a full sort by `SplatSorter`: the same
+ * splats are visible, with the same keys, in ascending key order, and every
+ * splat appears exactly once. Splats with equal keys may be in any order.
+ *
+ * @param sorted - Order to check.
+ * @param num_visible - Its number of visible splats.
+ * @param keys - Keys of the full sort, per splat.
+ * @param num_expected - Visible splats of the full sort.
+ * @param not_visible - Key of culled splats.
+ */
+inline void check_sorted(std::span<const render::SortedSplat> sorted,
+                         uint32_t num_visible, std::span<const uint32_t> keys,
+                         uint32_t num_expected, uint32_t not_visible) {
+  if (!SPLAT_CHECK(sorted.size() == keys.size()) ||
+      !SPLAT_CHECK(num_visible == num_expected)) {
+    return;
+  }
+  std::vector<uint32_t> counts(keys.size());
+  bool is_valid = true;
+  for (uint32_t i = 0; i < sorted.size() && is_valid; ++i) {
+    const render::SortedSplat& splat = sorted[i];
+    is_valid &= splat.index < keys.size();
+    if (!is_valid) {
+      break;
+    }
+    ++counts[splat.index];
+    uint32_t key = keys[splat.index];
+    is_valid &= i < num_visible ? key != not_visible && splat.distance == key
+                                : key == not_visible;
+    is_valid &= i == 0 || i >= num_visible ||
+                sorted[i - 1].distance <= splat.distance;
+  }
+  for (uint32_t count : counts) {
+    is_valid &= count == 1;
+  }
+  SPLAT_CHECK(is_valid);
+}
+
+/**
+ * Prints the outcome of a test.
+ *
+ * @param name - Name of the test, e.g. "splat_lod_test".
+ * @return Exit code: 0 if all checks passed, 1 otherwise.
+ */
+inline int report(const char* name) {
+  if (num_failures != 0) {
+    fprintf(stderr, "%s: %u checks failed\n", name, num_failures);
+    return 1;
+  }
+  printf("%s: ok\n", name);
+  return 0;
+}
+}  // namespace tests
\ No newline at end of file
@@ -0,0 +1,244 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Blend mode comparison.
+ *
+ * Draws a scene from one viewpoint with the reference rasterizer (see
+ * `rasterize_splats`), back-to-front with the over operator, and front-to-back
+ * with the under operator (`FRONT_TO_BACK`). Reports the difference between
+ * the two images, which should be within the error allowed by
+ * `saturation_alpha`, along with how many fragments were shaded by each, i.e.
+ * the fill saved by skipping saturated pixels. Also checks that
+ * `DistanceParams::front_to_back` keys sort in the reverse order.
+ *
+ * Also draws the scene unsorted, with weighted blended order-independent
+ * transparency (`WEIGHTED_OIT`), and reports its difference to back-to-front,
+ * which is approximate, to judge whether an asset can skip sorting.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_blend_compare.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_sort.cpp \
+ *       render/splat_transform.cpp render/splat_rasterizer.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_blend_compare
+ *
+ * Usage:
+ *
+ *   splat_blend_compare (<file.ply> | --synthetic <n>) [--width <pixels>]
+ *                       [--height <pixels>] [--fov <degrees>]
+ *                       [--saturation <alpha>] [--eye <x> <y> <z>]
+ *                       [--target <x> <y> <z>] [--oit-depth-scale <scale>]
+ *
+ * Positions are in meters, in the importer's axes (X+ forward, Y+ right, Z+
+ * up). By default, the camera is the first view of `make_orbit_view`.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_rasterizer.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t width = 1024;
+  uint32_t height = 1024;
+  float fov_y_degrees = 90.f;
+  float saturation_alpha = render::saturation_alpha;
+  float oit_depth_scale = 0.01f;
+  bool has_eye = false;
+  bool has_target = false;
+  Float3 eye;
+  Float3 target;
+};
+
+struct ImageDifference {
+  float max_error = 0.f;
+  double mean_error = 0.;
+};
+
+/**
+ * @return Per channel (RGBA) absolute difference.
+ */
+ImageDifference compare_images(const std::vector<Float4>& a,
+                               const std::vector<Float4>& b) {
+  ImageDifference difference;
+  for (size_t i = 0; i < a.size(); ++i) {
+    for (uint32_t channel = 0; channel < 4; ++channel) {
+      float error = std::abs(a[i][channel] - b[i][channel]);
+      difference.max_error = std::max(difference.max_error, error);
+      difference.mean_error += error;
+    }
+  }
+  if (!a.empty()) {
+    difference.mean_error /= static_cast<double>(a.size() * 4);
+  }
+  return difference;
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--saturation" && i + 1 < argc) {
+      options.saturation_alpha = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--oit-depth-scale" && i + 1 < argc) {
+      options.oit_depth_scale = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--eye") {
+      is_valid = options.has_eye = parse_float3(argc, argv, i, options.eye);
+    } else if (arg == "--target") {
+      is_valid = options.has_target =
+          parse_float3(argc, argv, i, options.target);
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.width > 0 && options.height > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--width <pixels>] "
+            "[--height <pixels>] [--fov <degrees>] [--saturation <alpha>] "
+            "[--eye <x> <y> <z>] [--target <x> <y> <z>] "
+            "[--oit-depth-scale <scale>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  PackedPositions packed = pack_positions(scene);
+  std::vector<render::PackedCovariance> covariances = pack_covariances(scene);
+  std::vector<float> opacities = get_opacities(scene);
+  std::vector<Float4> colors(scene.colors.size());
+  for (size_t i = 0; i < colors.size(); ++i) {
+    const Color& color = scene.colors[i];
+    colors[i] = Float4(color.r / 255.f, color.g / 255.f, color.b / 255.f,
+                       opacities[i]);
+  }
+
+  View view = make_orbit_view(scene, 0, 1);
+  view.eye = options.has_eye ? options.eye : view.eye;
+  view.target = options.has_target ? options.target : view.target;
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+
+  render::TransformParams transform_params = make_transform_params(
+      packed, view, options.fov_y_degrees, options.height);
+  std::vector<render::PackedTransform> transforms(packed.positions.size());
+  render::compute_transforms(packed.positions, covariances, transform_params,
+                             transforms);
+
+  render::DistanceParams distance_params =
+      make_distance_params(packed, view, options.fov_y_degrees, aspect);
+  distance_params.encoding = render::DistanceEncoding::FloatFlip;
+  distance_params.precision = 32;
+
+  render::RasterParams raster_params;
+  raster_params.local_to_clip = distance_params.local_to_clip;
+  raster_params.pos_scale_cm = packed.pos_scale_cm;
+  raster_params.pos_min_cm = packed.pos_min_cm;
+  raster_params.width = options.width;
+  raster_params.height = options.height;
+  raster_params.saturation_alpha = options.saturation_alpha;
+  raster_params.oit_depth_scale = options.oit_depth_scale;
+
+  /**
+   * Splats of equal depth (e.g. sharing a quantized position) may be drawn in
+   * either order, and are drawn in index order by both sorts, so the two
+   * sorts aren't exact reverses. To compare only blending, front-to-back
+   * draws the reverse of the back-to-front order, which front-to-back keys
+   * are checked to agree with.
+   */
+  render::SplatSorter sorter;
+  std::vector<render::SortedSplat> sorted(packed.positions.size());
+  uint32_t num_visible = sorter.sort(packed.positions, distance_params, sorted);
+  sorted.resize(num_visible);
+
+  distance_params.front_to_back = true;
+  std::vector<uint32_t> front_to_back_keys(packed.positions.size());
+  render::compute_distances(packed.positions, distance_params,
+                            front_to_back_keys);
+  uint64_t num_misordered = 0;
+  for (uint32_t i = 1; i < num_visible; ++i) {
+    // Reversed, so keys should not increase along the back-to-front order.
+    num_misordered += front_to_back_keys[sorted[i].index] >
+                      front_to_back_keys[sorted[i - 1].index];
+  }
+
+  std::vector<Float4> images[3];
+  render::RasterStats stats[3];
+  raster_params.blend_mode = render::SplatBlendMode::BackToFront;
+  stats[0] = render::rasterize_splats(packed.positions, transforms, colors,
+                                      sorted, raster_params, images[0]);
+  std::reverse(sorted.begin(), sorted.end());
+  raster_params.blend_mode = render::SplatBlendMode::FrontToBack;
+  stats[1] = render::rasterize_splats(packed.positions, transforms, colors,
+                                      sorted, raster_params, images[1]);
+  // Unsorted, i.e. in index order, leaving culling to the rasterizer.
+  std::vector<render::SortedSplat> unsorted(packed.positions.size());
+  for (uint32_t i = 0; i < unsorted.size(); ++i) {
+    unsorted[i].index = i;
+  }
+  raster_params.blend_mode = render::SplatBlendMode::WeightedOIT;
+  stats[2] = render::rasterize_splats(packed.positions, transforms, colors,
+                                      unsorted, raster_params, images[2]);
+
+  ImageDifference difference = compare_images(images[0], images[1]);
+  ImageDifference oit_difference = compare_images(images[0], images[2]);
+  double num_pixels = static_cast<double>(options.width) * options.height;
+  printf("%zu splats, %u visible, %ux%u pixels\n", packed.positions.size(),
+         num_visible, options.width, options.height);
+  printf("%-14s %14s %14s %10s\n", "mode", "shaded", "skipped", "overdraw");
+  const char* mode_names[3] = {"back_to_front", "front_to_back",
+                               "weighted_oit"};
+  for (uint32_t mode = 0; mode < 3; ++mode) {
+    printf("%-14s %14llu %14llu %10.2f\n", mode_names[mode],
+           static_cast<unsigned long long>(stats[mode].num_shaded),
+           static_cast<unsigned long long>(stats[mode].num_skipped),
+           static_cast<double>(stats[mode].num_shaded) / num_pixels);
+  }
+  printf("difference: max %.6f, mean %.8f (limit %.6f)\n",
+         difference.max_error, difference.mean_error,
+         1. - options.saturation_alpha);
+  printf("weighted_oit difference: max %.6f, mean %.8f\n",
+         oit_difference.max_error, oit_difference.mean_error);
+  printf("front_to_back keys out of order: %llu\n",
+         static_cast<unsigned long long>(num_misordered));
+  return 0;
+}
\ No newline at end of file
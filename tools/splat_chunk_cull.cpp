@@ -0,0 +1,245 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Chunk culling report.
+ *
+ * Groups the splats of a scene into chunks with `build_chunks`, and reorders
+ * them as an importer would. Then, along a camera path, culls chunks with
+ * `cull_chunks`, and reports how many chunks and splats are left, the time
+ * taken to cull, and the time `compute_distances` takes over all splats
+ * versus over the splats of visible chunks only. Each view also checks that
+ * culling is conservative: every splat `compute_distances` keeps must lie in
+ * a visible chunk.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_chunk_cull.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp import/splat_chunks.cpp \
+ *       import/splat_morton.cpp import/splat_covariance.cpp \
+ *       render/splat_chunk_culling.cpp render/splat_stereo_sort.cpp \
+ *       render/splat_sort.cpp import/splat_logging.cpp \
+ *       import/splat_parallel.cpp import/splat_tracing.cpp \
+ *       import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_chunk_cull
+ *
+ * Usage:
+ *
+ *   splat_chunk_cull (<file.ply> | --synthetic <n>) [--objects <n>]
+ *                    [--chunk-size <splats>] [--max-span <scales>]
+ *                    [--width <pixels>] [--height <pixels>]
+ *                    [--fov <degrees>] [--views <n>] [--stereo <ipd cm>]
+ *
+ * The camera path is that of `make_orbit_view`. With `--stereo`, both eyes
+ * are offset from it along the view's right axis, and culled against at once,
+ * as with `WITH_STEREO_SORT`. `--objects` scatters the scene into separate
+ * objects (see `scatter_scene`), and `--max-span` sets
+ * `ChunkSettings::max_span_scales`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "import/splat_chunks.h"
+#include "import/splat_logging.h"
+#include "render/splat_chunk_culling.h"
+#include "render/splat_sort.h"
+#include "render/splat_stereo_sort.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t num_objects = 0;
+  uint32_t splats_per_chunk = import::ChunkSettings().splats_per_chunk;
+  float max_span_scales = import::ChunkSettings().max_span_scales;
+  uint32_t width = 1920;
+  uint32_t height = 1920;
+  float fov_y_degrees = 90.f;
+  uint32_t num_views = 4;
+  float ipd_cm = 0.f;
+};
+
+/**
+ * Reorders `values` by `order`, e.g. `SplatChunks::order`.
+ */
+template <typename T>
+void reorder(std::vector<T>& values, const std::vector<uint32_t>& order) {
+  std::vector<T> reordered(values.size());
+  import::apply_order<T>(values, order, reordered);
+  values.swap(reordered);
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--objects" && i + 1 < argc) {
+      options.num_objects = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--chunk-size" && i + 1 < argc) {
+      options.splats_per_chunk =
+          static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--max-span" && i + 1 < argc) {
+      options.max_span_scales = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--views" && i + 1 < argc) {
+      options.num_views = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--stereo" && i + 1 < argc) {
+      options.ipd_cm = static_cast<float>(atof(argv[++i]));
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.splats_per_chunk > 0;
+  is_valid &= options.max_span_scales >= 0.f;
+  is_valid &= options.width > 0 && options.height > 0 && options.num_views > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  is_valid &= options.ipd_cm >= 0.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--objects <n>] "
+            "[--chunk-size <splats>] [--max-span <scales>] "
+            "[--width <pixels>] [--height <pixels>] [--fov <degrees>] "
+            "[--views <n>] [--stereo <ipd cm>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  if (options.num_objects > 0) {
+    scatter_scene(options.num_objects, scene);
+  }
+  size_t num_splats = scene.positions.size();
+
+  import::ChunkSettings chunk_settings;
+  chunk_settings.splats_per_chunk = options.splats_per_chunk;
+  chunk_settings.max_span_scales = options.max_span_scales;
+  import::SplatChunks chunks;
+  auto start = std::chrono::steady_clock::now();
+  if (!import::build_chunks(scene.positions, scene.rotations, scene.scales,
+                            chunk_settings, chunks)) {
+    return 1;
+  }
+  double build_milliseconds = get_milliseconds(start);
+  reorder(scene.positions, chunks.order);
+  reorder(scene.rotations, chunks.order);
+  reorder(scene.scales, chunks.order);
+  reorder(scene.colors, chunks.order);
+  PackedPositions packed = pack_positions(scene);
+  printf("%zu splats, %zu chunks, built in %.1f ms\n", num_splats,
+         chunks.chunks.size(), build_milliseconds);
+
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+
+  printf("%6s %10s %10s %10s %10s %10s %12s\n", "view", "chunks", "splats",
+         "ranges", "cull_ms", "all_ms", "visible_ms");
+  std::vector<render::ChunkRange> ranges;
+  std::vector<uint32_t> distances(num_splats);
+  std::vector<uint32_t> chunk_distances(num_splats);
+  bool is_conservative = true;
+  for (uint32_t view = 0; view < options.num_views; ++view) {
+    View camera = make_orbit_view(scene, view, options.num_views);
+    render::DistanceParams params =
+        make_distance_params(packed, camera, options.fov_y_degrees, aspect);
+    if (options.ipd_cm > 0.f) {
+      Float3 right = normalize(
+          cross(Float3(0.f, 0.f, 1.f), camera.target - camera.eye));
+      Float3 offset = right * (options.ipd_cm / 200.f);
+      View left_eye{camera.eye - offset, camera.target - offset};
+      View right_eye{camera.eye + offset, camera.target + offset};
+      params = render::make_stereo_distance_params(
+          make_distance_params(packed, left_eye, options.fov_y_degrees, aspect)
+              .local_to_clip,
+          make_distance_params(packed, right_eye, options.fov_y_degrees,
+                               aspect)
+              .local_to_clip,
+          packed.pos_scale_cm, packed.pos_min_cm);
+    }
+
+    start = std::chrono::steady_clock::now();
+    uint64_t num_visible =
+        render::cull_chunks(chunks.chunks, params, 100.f, ranges);
+    double cull_milliseconds = get_milliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    render::compute_distances(packed.positions, params, distances);
+    double all_milliseconds = get_milliseconds(start);
+
+    // Only the splats of visible chunks, into a dense output, as with
+    // `CHUNKED_DISPATCH`.
+    start = std::chrono::steady_clock::now();
+    size_t offset = 0;
+    for (const render::ChunkRange& range : ranges) {
+      render::compute_distances(
+          std::span<const uint32_t>(packed.positions)
+              .subspan(range.first_splat, range.num_splats),
+          params,
+          std::span<uint32_t>(chunk_distances)
+              .subspan(offset, range.num_splats));
+      offset += range.num_splats;
+    }
+    double visible_milliseconds = get_milliseconds(start);
+
+    uint32_t not_visible = render::get_distance_not_visible(params);
+    uint32_t num_visible_chunks = 0;
+    size_t next_range = 0;
+    for (const import::SplatChunk& chunk : chunks.chunks) {
+      while (next_range < ranges.size() &&
+             ranges[next_range].first_splat +
+                     ranges[next_range].num_splats <=
+                 chunk.first_splat) {
+        ++next_range;
+      }
+      bool is_chunk_visible = next_range < ranges.size() &&
+                              ranges[next_range].first_splat <=
+                                  chunk.first_splat;
+      num_visible_chunks += is_chunk_visible;
+      for (uint32_t i = 0; i < chunk.num_splats && !is_chunk_visible; ++i) {
+        if (distances[chunk.first_splat + i] != not_visible) {
+          is_conservative = false;
+        }
+      }
+    }
+
+    printf("%6u %10u %10llu %10zu %10.3f %10.2f %12.2f\n", view,
+           num_visible_chunks, static_cast<unsigned long long>(num_visible),
+           ranges.size(), cull_milliseconds, all_milliseconds,
+           visible_milliseconds);
+  }
+  if (!is_conservative) {
+    fprintf(stderr, "error: a culled chunk holds a visible splat\n");
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,263 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * CPU render of a scene.
+ *
+ * Renders a scene from one viewpoint with `render_splats_tiled`, i.e. the
+ * whole splat pipeline without a GPU, e.g. for thumbnails or golden images.
+ * Reports fragment counts and the distribution of per-pixel overdraw, for
+ * measuring fill rate, and optionally writes the image and an overdraw map.
+ *
+ * Images are binary PPM, over black. Overdraw maps are binary PGM, scaled so
+ * that white is the highest overdraw.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_cpu_render.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_sort.cpp \
+ *       render/splat_transform.cpp render/splat_rasterizer.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_cpu_render
+ *
+ * Usage:
+ *
+ *   splat_cpu_render (<file.ply> | --synthetic <n>) [--width <pixels>]
+ *                    [--height <pixels>] [--fov <degrees>]
+ *                    [--mode (back_to_front | front_to_back | weighted_oit)]
+ *                    [--min-radius <pixels>] [--max-radius <pixels>]
+ *                    [--adaptive-radius]
+ *                    [--eye <x> <y> <z>] [--target <x> <y> <z>]
+ *                    [--output <file.ppm>] [--overdraw <file.pgm>]
+ *
+ * Positions are in meters, in the importer's axes (X+ forward, Y+ right, Z+
+ * up). By default, the camera is the first view of `make_orbit_view`.
+ * `--adaptive-radius` renders as with `OPACITY_ADAPTIVE_RADIUS`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_rasterizer.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t width = 1024;
+  uint32_t height = 1024;
+  float fov_y_degrees = 90.f;
+  render::SplatBlendMode blend_mode = render::SplatBlendMode::BackToFront;
+  float min_radius_pixels = 0.f;
+  float max_radius_pixels = std::numeric_limits<float>::infinity();
+  bool opacity_adaptive_radius = false;
+  bool has_eye = false;
+  bool has_target = false;
+  Float3 eye;
+  Float3 target;
+  const char* output_path = nullptr;
+  const char* overdraw_path = nullptr;
+};
+
+bool parse_blend_mode(const std::string& name, render::SplatBlendMode& mode) {
+  if (name == "back_to_front") {
+    mode = render::SplatBlendMode::BackToFront;
+  } else if (name == "front_to_back") {
+    mode = render::SplatBlendMode::FrontToBack;
+  } else if (name == "weighted_oit") {
+    mode = render::SplatBlendMode::WeightedOIT;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Writes a binary PPM (or PGM, with 1 channel), top row first.
+ *
+ * @param rows - `height` rows of `width` * `channels` bytes, bottom row first.
+ */
+bool write_netpbm(const char* path, uint32_t width, uint32_t height,
+                  uint32_t channels, const std::vector<uint8_t>& rows) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    log_error("Failed to open %s for writing", path);
+    return false;
+  }
+  fprintf(file, "P%c\n%u %u\n255\n", channels == 1 ? '5' : '6', width,
+          height);
+  size_t row_size = static_cast<size_t>(width) * channels;
+  bool is_written = true;
+  for (uint32_t y = height; y-- > 0 && is_written;) {
+    is_written = fwrite(&rows[y * row_size], 1, row_size, file) == row_size;
+  }
+  is_written &= fclose(file) == 0;
+  if (!is_written) {
+    log_error("Failed to write %s", path);
+  }
+  return is_written;
+}
+
+uint8_t to_unorm8(float value) {
+  return static_cast<uint8_t>(std::clamp(value, 0.f, 1.f) * 255.f + .5f);
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--mode" && i + 1 < argc) {
+      is_valid = parse_blend_mode(argv[++i], options.blend_mode);
+    } else if (arg == "--min-radius" && i + 1 < argc) {
+      options.min_radius_pixels = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--max-radius" && i + 1 < argc) {
+      options.max_radius_pixels = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--adaptive-radius") {
+      options.opacity_adaptive_radius = true;
+    } else if (arg == "--eye") {
+      is_valid = options.has_eye = parse_float3(argc, argv, i, options.eye);
+    } else if (arg == "--target") {
+      is_valid = options.has_target =
+          parse_float3(argc, argv, i, options.target);
+    } else if (arg == "--output" && i + 1 < argc) {
+      options.output_path = argv[++i];
+    } else if (arg == "--overdraw" && i + 1 < argc) {
+      options.overdraw_path = argv[++i];
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.width > 0 && options.height > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--width <pixels>] "
+            "[--height <pixels>] [--fov <degrees>] "
+            "[--mode (back_to_front | front_to_back | weighted_oit)] "
+            "[--min-radius <pixels>] [--max-radius <pixels>] "
+            "[--adaptive-radius] [--eye <x> <y> <z>] [--target <x> <y> <z>] "
+            "[--output <file.ppm>] [--overdraw <file.pgm>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  PackedPositions packed = pack_positions(scene);
+  std::vector<render::PackedCovariance> covariances = pack_covariances(scene);
+  std::vector<float> opacities = get_opacities(scene);
+  std::vector<Float4> colors(scene.colors.size());
+  for (size_t i = 0; i < colors.size(); ++i) {
+    const Color& color = scene.colors[i];
+    colors[i] = Float4(color.r / 255.f, color.g / 255.f, color.b / 255.f,
+                       opacities[i]);
+  }
+
+  View view = make_orbit_view(scene, 0, 1);
+  view.eye = options.has_eye ? options.eye : view.eye;
+  view.target = options.has_target ? options.target : view.target;
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+
+  render::TiledRenderParams params;
+  params.distance =
+      make_distance_params(packed, view, options.fov_y_degrees, aspect);
+  params.distance.encoding = render::DistanceEncoding::FloatFlip;
+  params.distance.precision = 32;
+  params.transform = make_transform_params(packed, view, options.fov_y_degrees,
+                                           options.height);
+  params.transform.min_radius_pixels = options.min_radius_pixels;
+  params.transform.max_radius_pixels = options.max_radius_pixels;
+  params.raster.local_to_clip = params.distance.local_to_clip;
+  params.raster.pos_scale_cm = packed.pos_scale_cm;
+  params.raster.pos_min_cm = packed.pos_min_cm;
+  params.raster.width = options.width;
+  params.raster.height = options.height;
+  params.raster.blend_mode = options.blend_mode;
+  params.raster.opacity_adaptive_radius = options.opacity_adaptive_radius;
+
+  size_t num_pixels = static_cast<size_t>(options.width) * options.height;
+  std::vector<Float4> image;
+  std::vector<uint32_t> overdraw(num_pixels);
+  auto start = std::chrono::steady_clock::now();
+  render::RasterStats stats = render::render_splats_tiled(
+      packed.positions, covariances, colors, params, image, overdraw);
+  double milliseconds = get_milliseconds(start);
+
+  std::vector<uint32_t> sorted_overdraw = overdraw;
+  std::sort(sorted_overdraw.begin(), sorted_overdraw.end());
+  auto get_percentile = [&](double percentile) {
+    return sorted_overdraw[static_cast<size_t>(
+        percentile * static_cast<double>(num_pixels - 1))];
+  };
+  printf("%zu splats, %ux%u pixels, %.1f ms\n", packed.positions.size(),
+         options.width, options.height, milliseconds);
+  printf("fragments: %llu shaded, %llu skipped\n",
+         static_cast<unsigned long long>(stats.num_shaded),
+         static_cast<unsigned long long>(stats.num_skipped));
+  printf("overdraw: mean %.2f, p50 %u, p90 %u, p99 %u, max %u\n",
+         static_cast<double>(stats.num_shaded) /
+             static_cast<double>(num_pixels),
+         get_percentile(.5), get_percentile(.9), get_percentile(.99),
+         sorted_overdraw.back());
+
+  if (options.output_path) {
+    std::vector<uint8_t> rows(num_pixels * 3);
+    for (size_t i = 0; i < num_pixels; ++i) {
+      for (uint32_t channel = 0; channel < 3; ++channel) {
+        rows[i * 3 + channel] = to_unorm8(image[i][channel]);
+      }
+    }
+    if (!write_netpbm(options.output_path, options.width, options.height, 3,
+                      rows)) {
+      return 1;
+    }
+  }
+  if (options.overdraw_path) {
+    float scale =
+        1.f / static_cast<float>(std::max(sorted_overdraw.back(), 1u));
+    std::vector<uint8_t> rows(num_pixels);
+    for (size_t i = 0; i < num_pixels; ++i) {
+      rows[i] = to_unorm8(static_cast<float>(overdraw[i]) * scale);
+    }
+    if (!write_netpbm(options.overdraw_path, options.width, options.height, 1,
+                      rows)) {
+      return 1;
+    }
+  }
+  return 0;
+}
\ No newline at end of file
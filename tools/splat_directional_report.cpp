@@ -0,0 +1,353 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Directional order report.
+ *
+ * Precomputes the orders of a scene for a set of view directions with
+ * `build_directional_orders`, and reports their build time and size. Then,
+ * along a distant camera path, orders the scene with `DirectionalSorter`,
+ * and compares it against the exact back-to-front order. Only splats whose
+ * screen footprints overlap can blend wrongly, so errors are over pairs of
+ * splats drawn over the same cell of a screen grid, weighted by the cells
+ * they share: the fraction of pairs whose view depths are out of order
+ * (about 50% for a random order), and the largest inversion, relative to the
+ * scene's radius. The time taken is compared against that of a per-frame
+ * `SplatSorter::sort`.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_directional_report.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp import/splat_directional_orders.cpp \
+ *       render/splat_directional_sort.cpp render/splat_sort.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_directional_report
+ *
+ * Usage:
+ *
+ *   splat_directional_report (<file.ply> | --synthetic <n>)
+ *                             [--directions <n>] [--distance <radii>]
+ *                             [--elevation <degrees>] [--views <n>]
+ *                             [--max-angle <radians>]
+ *
+ * The camera path orbits the center of the scene at `--distance` times the
+ * radius of its bounding sphere (25 by default), `--elevation` above its
+ * center, with `--views` evenly spaced views. Views where the scene is larger
+ * than `--max-angle` fall back to the per-frame sort, and are marked as such.
+ * A last view, `exact`, looks along the direction nearest the first view's,
+ * as a baseline: depths along it sort as its order does, so any errors come
+ * from ties and rounding.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+#include <string>
+#include <vector>
+
+#include "import/splat_directional_orders.h"
+#include "import/splat_logging.h"
+#include "render/splat_constants.h"
+#include "render/splat_directional_sort.h"
+#include "render/splat_sort.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t num_directions = import::DirectionalOrderSettings().num_directions;
+  float distance_radii = 25.f;
+  float elevation_degrees = 20.f;
+  uint32_t num_views = 8;
+  float max_angular_radius = render::DirectionalSortParams().max_angular_radius;
+};
+
+/**
+ * Cells of the screen grid along each axis, over the scene's projection.
+ */
+constexpr uint32_t num_screen_cells = 128;
+
+/**
+ * Errors of a back-to-front order, against exact view depths, over pairs of
+ * splats with overlapping screen footprints.
+ */
+struct OrderErrors {
+  uint64_t num_misordered = 0;
+  uint64_t num_pairs = 0;
+  /**
+   * Largest amount by which a splat is nearer than a later one, in meters.
+   */
+  float max_inversion = 0.f;
+};
+
+/**
+ * Sorts `depths` in descending order.
+ *
+ * @param scratch - Of the same size as `depths`.
+ * @return Number of pairs i < j with depths[i] < depths[j], i.e. out of
+ * back-to-front order.
+ */
+uint64_t count_inversions(std::span<float> depths, std::span<float> scratch) {
+  uint64_t num_inversions = 0;
+  float* src = depths.data();
+  float* dst = scratch.data();
+  size_t size = depths.size();
+  for (size_t width = 1; width < size; width *= 2) {
+    for (size_t begin = 0; begin < size; begin += 2 * width) {
+      size_t middle = std::min(begin + width, size);
+      size_t end = std::min(begin + 2 * width, size);
+      size_t i = begin, j = middle, out = begin;
+      while (i < middle && j < end) {
+        if (src[j] > src[i]) {
+          num_inversions += middle - i;
+          dst[out++] = src[j++];
+        } else {
+          dst[out++] = src[i++];
+        }
+      }
+      out = std::copy(src + i, src + middle, dst + out) - dst;
+      std::copy(src + j, src + end, dst + out);
+    }
+    std::swap(src, dst);
+  }
+  if (src != depths.data()) {
+    std::copy(src, src + size, depths.data());
+  }
+  return num_inversions;
+}
+
+/**
+ * Bins splats, in draw order, into the cells of a screen grid covered by
+ * their footprints (out to `radius_sigma` along their largest axis), and
+ * measures the order of each cell's splats.
+ */
+OrderErrors get_order_errors(std::span<const render::SortedSplat> sorted,
+                             const Scene& scene, const Float3& eye,
+                             const Float3& forward) {
+  Float3 right = normalize(cross(Float3(0.f, 0.f, 1.f), forward));
+  Float3 up = cross(forward, right);
+  // Half the size of the grid, in view-space slope, bounding the scene.
+  float half_size = 1e-6f;
+  for (const Float3& position : scene.positions) {
+    float depth = dot(position - eye, forward);
+    if (depth > 0.f) {
+      half_size = std::max(
+          half_size, std::max(std::abs(dot(position - eye, right)),
+                              std::abs(dot(position - eye, up))) /
+                         depth);
+    }
+  }
+  float cells_per_slope = num_screen_cells / (2.f * half_size);
+
+  // Cells of each splat, then each cell's splats, in draw order.
+  struct Footprint {
+    float depth;
+    uint32_t min_x, max_x, min_y, max_y;
+  };
+  std::vector<Footprint> footprints;
+  std::vector<uint32_t> cell_begins(num_screen_cells * num_screen_cells + 1);
+  for (const render::SortedSplat& splat : sorted) {
+    Float3 offset = scene.positions[splat.index] - eye;
+    float depth = dot(offset, forward);
+    if (!(depth > 0.f)) {
+      continue;
+    }
+    const Float3& scale = scene.scales[splat.index];
+    float radius = render::radius_sigma *
+                   std::max(std::max(scale.x, scale.y), scale.z) / depth;
+    auto get_cell = [&](float slope) {
+      return static_cast<uint32_t>(
+          std::clamp((slope + half_size) * cells_per_slope, 0.f,
+                     static_cast<float>(num_screen_cells - 1)));
+    };
+    float x = dot(offset, right) / depth;
+    float y = dot(offset, up) / depth;
+    Footprint& footprint = footprints.emplace_back(
+        Footprint{depth, get_cell(x - radius), get_cell(x + radius),
+                  get_cell(y - radius), get_cell(y + radius)});
+    for (uint32_t cell_y = footprint.min_y; cell_y <= footprint.max_y;
+         ++cell_y) {
+      for (uint32_t cell_x = footprint.min_x; cell_x <= footprint.max_x;
+           ++cell_x) {
+        ++cell_begins[cell_y * num_screen_cells + cell_x + 1];
+      }
+    }
+  }
+  for (size_t cell = 1; cell < cell_begins.size(); ++cell) {
+    cell_begins[cell] += cell_begins[cell - 1];
+  }
+  std::vector<float> cell_depths(cell_begins.back());
+  std::vector<uint32_t> cell_ends(cell_begins.begin(), cell_begins.end() - 1);
+  for (const Footprint& footprint : footprints) {
+    for (uint32_t cell_y = footprint.min_y; cell_y <= footprint.max_y;
+         ++cell_y) {
+      for (uint32_t cell_x = footprint.min_x; cell_x <= footprint.max_x;
+           ++cell_x) {
+        cell_depths[cell_ends[cell_y * num_screen_cells + cell_x]++] =
+            footprint.depth;
+      }
+    }
+  }
+
+  OrderErrors errors;
+  std::vector<float> scratch(cell_depths.size());
+  for (size_t cell = 0; cell + 1 < cell_begins.size(); ++cell) {
+    std::span<float> depths(cell_depths.data() + cell_begins[cell],
+                            cell_begins[cell + 1] - cell_begins[cell]);
+    if (depths.empty()) {
+      continue;
+    }
+    float nearest = depths[0];
+    for (float depth : depths) {
+      errors.max_inversion = std::max(errors.max_inversion, depth - nearest);
+      nearest = std::min(nearest, depth);
+    }
+    errors.num_pairs += uint64_t{depths.size()} * (depths.size() - 1) / 2;
+    errors.num_misordered += count_inversions(
+        depths, std::span(scratch).subspan(0, depths.size()));
+  }
+  return errors;
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--directions" && i + 1 < argc) {
+      options.num_directions = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--distance" && i + 1 < argc) {
+      options.distance_radii = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--elevation" && i + 1 < argc) {
+      options.elevation_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--views" && i + 1 < argc) {
+      options.num_views = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--max-angle" && i + 1 < argc) {
+      options.max_angular_radius = static_cast<float>(atof(argv[++i]));
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.num_directions > 0 && options.num_views > 0;
+  is_valid &= options.distance_radii > 1.f;
+  is_valid &= std::abs(options.elevation_degrees) < 90.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--directions <n>] "
+            "[--distance <radii>] [--elevation <degrees>] [--views <n>] "
+            "[--max-angle <radians>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  size_t num_splats = scene.positions.size();
+  PackedPositions packed = pack_positions(scene);
+
+  import::DirectionalOrderSettings settings;
+  settings.num_directions = options.num_directions;
+  import::DirectionalOrders orders;
+  auto start = std::chrono::steady_clock::now();
+  if (!import::build_directional_orders(scene.positions, settings, orders)) {
+    return 1;
+  }
+  double build_milliseconds = get_milliseconds(start);
+  printf("%zu splats, %u directions, built in %.1f ms, %.2f bytes per splat "
+         "per direction\n",
+         num_splats, options.num_directions, build_milliseconds,
+         num_splats ? static_cast<double>(orders.data.size()) /
+                          static_cast<double>(num_splats) /
+                          options.num_directions
+                    : 0.0);
+
+  float elevation =
+      options.elevation_degrees * std::numbers::pi_v<float> / 180.f;
+  float distance = options.distance_radii * orders.radius;
+  printf("%6s %10s %12s %12s %12s %10s\n", "view", "direction", "misordered",
+         "inversion", "decode_ms", "sort_ms");
+  render::DirectionalSorter directional_sorter;
+  render::SplatSorter sorter;
+  std::vector<render::SortedSplat> sorted(num_splats);
+  // Reports the view from `orders.center + offset * distance`.
+  auto report_view = [&](const char* label, const Float3& offset) {
+    Float3 eye = orders.center + offset * distance;
+
+    render::DistanceParams params =
+        make_distance_params(packed, View{eye, orders.center}, 90.f, 1.f);
+    start = std::chrono::steady_clock::now();
+    sorter.sort(packed.positions, params, sorted);
+    double sort_milliseconds = get_milliseconds(start);
+
+    render::DirectionalSortParams directional_params;
+    directional_params.camera_position = eye;
+    directional_params.max_angular_radius = options.max_angular_radius;
+    start = std::chrono::steady_clock::now();
+    render::DirectionalSortResult result =
+        directional_sorter.sort(orders, directional_params);
+    double decode_milliseconds = get_milliseconds(start);
+    if (result == render::DirectionalSortResult::NotApplicable) {
+      printf("%6s %10s %12s %12s %12s %10.2f\n", label, "-", "-", "-", "-",
+             sort_milliseconds);
+      return;
+    }
+
+    OrderErrors errors =
+        get_order_errors(directional_sorter.get_sorted(), scene, eye,
+                         Float3(0.f, 0.f, 0.f) - offset);
+    printf("%6s %10u %11.3f%% %11.3f%% %12.2f %10.2f\n", label,
+           directional_sorter.get_direction(),
+           errors.num_pairs
+               ? 100.0 * static_cast<double>(errors.num_misordered) /
+                     static_cast<double>(errors.num_pairs)
+               : 0.0,
+           orders.radius > 0.f ? 100.f * errors.max_inversion / orders.radius
+                               : 0.f,
+           decode_milliseconds, sort_milliseconds);
+  };
+
+  Float3 first_offset;
+  for (uint32_t view = 0; view < options.num_views; ++view) {
+    float angle = 2.f * std::numbers::pi_v<float> * static_cast<float>(view) /
+                  static_cast<float>(options.num_views);
+    Float3 offset(std::cos(angle) * std::cos(elevation),
+                  std::sin(angle) * std::cos(elevation), std::sin(elevation));
+    if (view == 0) {
+      first_offset = offset;
+    }
+    report_view(std::to_string(view).c_str(), offset);
+  }
+
+  // Directions point from the camera towards the scene.
+  Float3 exact_direction = orders.directions[0];
+  for (const Float3& direction : orders.directions) {
+    if (dot(direction, first_offset) < dot(exact_direction, first_offset)) {
+      exact_direction = direction;
+    }
+  }
+  report_view("exact", Float3(0.f, 0.f, 0.f) - exact_direction);
+  return 0;
+}
\ No newline at end of file
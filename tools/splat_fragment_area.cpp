@@ -0,0 +1,283 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Fragment area report for `OPACITY_ADAPTIVE_RADIUS`.
+ *
+ * Projects a scene from one viewpoint as `render_splat.vs.hlsl` does, and sums
+ * the screen area of visible splats' quads with the fixed `radius_sigma`, and
+ * with the opacity-adaptive radius of `get_radius_sigma_over_sqrt_2`. As
+ * splats are blended, fragment shading and blending cost scale with this area,
+ * so the difference is the overdraw saved. Results are broken down by opacity,
+ * as only splats more transparent than ~0.21 shrink.
+ *
+ * `--min-radius` and `--max-radius` apply `FOOTPRINT_LIMITS` (see
+ * `limit_footprint`) to both, and report how many splats each limit affected.
+ *
+ * Areas are in pixels, of quads clipped to the screen by their bounding box
+ * (so approximate for quads crossing its edges), and also given as multiples
+ * of the screen area, i.e. average overdraw.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_fragment_area.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_sort.cpp \
+ *       render/splat_transform.cpp import/splat_logging.cpp \
+ *       import/splat_parallel.cpp import/splat_tracing.cpp \
+ *       import/ply/splat_ply_parsing.cpp import/ply/splat_ply_conversion.cpp \
+ *       -o splat_fragment_area
+ *
+ * Usage:
+ *
+ *   splat_fragment_area (<file.ply> | --synthetic <n>) [--width <pixels>]
+ *                       [--height <pixels>] [--fov <degrees>]
+ *                       [--min-radius <pixels>] [--max-radius <pixels>]
+ *                       [--eye <x> <y> <z>] [--target <x> <y> <z>]
+ *
+ * Positions are in meters, in the importer's axes (X+ forward, Y+ right, Z+
+ * up). By default, the camera is the first view of `make_orbit_view`.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_constants.h"
+#include "render/splat_sort.h"
+#include "render/splat_transform.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t width = 1920;
+  uint32_t height = 1920;
+  float fov_y_degrees = 90.f;
+  float min_radius_pixels = 0.f;
+  float max_radius_pixels = std::numeric_limits<float>::infinity();
+  bool has_eye = false;
+  bool has_target = false;
+  Float3 eye;
+  Float3 target;
+};
+
+/**
+ * Opacity ranges reported separately: too faint to draw, mostly and partially
+ * shrunk, and not shrunk at all.
+ */
+constexpr uint32_t num_opacity_ranges = 4;
+const char* const opacity_range_names[num_opacity_ranges] = {
+    "<= 1/255", "< 0.05", "< saturated", "saturated"};
+
+struct AreaResult {
+  uint64_t num_splats = 0;
+  double fixed_area = 0.;
+  double adaptive_area = 0.;
+};
+
+/**
+ * @return Index into `opacity_range_names`.
+ */
+uint32_t get_opacity_range(float opacity, float saturated_opacity) {
+  if (opacity <= render::min_alpha) {
+    return 0;
+  }
+  if (opacity < 0.05f) {
+    return 1;
+  }
+  return opacity < saturated_opacity ? 2 : 3;
+}
+
+/**
+ * Screen area of a quad of radius `radius` (in σ's, over sqrt(2)), clipped to
+ * the screen by the fraction of its bounding box on it.
+ *
+ * @param center - Splat center, in pixels.
+ * @param t - Transform of the splat, as read by `render_splat.vs.hlsl`.
+ * @param screen - Width and height, in pixels.
+ */
+double get_quad_area(const Float3& center, const Float4& t, float radius,
+                     const Float3& screen) {
+  // Transforms are in pixels * 2, and map corners of (+-radius, +-radius).
+  double area = std::abs(static_cast<double>(t.x) * t.w -
+                         static_cast<double>(t.y) * t.z) *
+                radius * radius;
+  if (area == 0.) {
+    return 0.;
+  }
+
+  float extent[2] = {(std::abs(t.x) + std::abs(t.y)) * radius / 2.f,
+                     (std::abs(t.z) + std::abs(t.w)) * radius / 2.f};
+  double fraction = 1.;
+  for (uint32_t axis = 0; axis < 2; ++axis) {
+    float min = std::max(center[axis] - extent[axis], 0.f);
+    float max = std::min(center[axis] + extent[axis], screen[axis]);
+    fraction *= std::max(max - min, 0.f) / (2.f * extent[axis]);
+  }
+  return area * fraction;
+}
+
+double get_percentage(double value, double total) {
+  return total != 0. ? 100. * value / total : 0.;
+}
+
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--min-radius" && i + 1 < argc) {
+      options.min_radius_pixels = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--max-radius" && i + 1 < argc) {
+      options.max_radius_pixels = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--eye") {
+      is_valid = options.has_eye = parse_float3(argc, argv, i, options.eye);
+    } else if (arg == "--target") {
+      is_valid = options.has_target =
+          parse_float3(argc, argv, i, options.target);
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.width > 0 && options.height > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  is_valid &= options.max_radius_pixels > 0.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--width <pixels>] "
+            "[--height <pixels>] [--fov <degrees>] [--min-radius <pixels>] "
+            "[--max-radius <pixels>] [--eye <x> <y> <z>] "
+            "[--target <x> <y> <z>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  PackedPositions packed = pack_positions(scene);
+  std::vector<render::PackedCovariance> covariances = pack_covariances(scene);
+  std::vector<float> opacities = get_opacities(scene);
+
+  View view = make_orbit_view(scene, 0, 1);
+  view.eye = options.has_eye ? options.eye : view.eye;
+  view.target = options.has_target ? options.target : view.target;
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+
+  render::DistanceParams distance_params =
+      make_distance_params(packed, view, options.fov_y_degrees, aspect);
+  render::TransformParams transform_params = make_transform_params(
+      packed, view, options.fov_y_degrees, options.height);
+  transform_params.min_radius_pixels = options.min_radius_pixels;
+  transform_params.max_radius_pixels = options.max_radius_pixels;
+
+  std::vector<uint32_t> distances(packed.positions.size());
+  std::vector<render::PackedTransform> transforms(packed.positions.size());
+  std::vector<uint16_t> opacity_scales(packed.positions.size());
+  render::FootprintCounts footprint_counts;
+  render::compute_distances_and_transforms(
+      packed.positions, covariances, distance_params, transform_params,
+      distances, transforms, opacity_scales, &footprint_counts);
+
+  Float3 screen(static_cast<float>(options.width),
+                static_cast<float>(options.height), 0.f);
+  float saturated_opacity =
+      std::exp(render::cutoff_radius_sigma_squared_over_2) * render::min_alpha;
+  uint32_t not_visible = render::get_distance_not_visible(distance_params);
+
+  AreaResult results[num_opacity_ranges];
+  AreaResult total;
+  uint64_t num_degenerate = 0;
+  for (size_t i = 0; i < packed.positions.size(); ++i) {
+    if (distances[i] == not_visible) {
+      continue;
+    }
+    Float4 pos_clip =
+        mul(render::unpack_pos(packed.positions[i], packed.pos_scale_cm,
+                               packed.pos_min_cm),
+            distance_params.local_to_clip);
+    Float3 center_pixels((pos_clip.x / pos_clip.w + 1.f) * screen.x / 2.f,
+                         (pos_clip.y / pos_clip.w + 1.f) * screen.y / 2.f, 0.f);
+    const render::PackedTransform& packed_t = transforms[i];
+    Float4 t(render::f16tof32(packed_t.x), render::f16tof32(packed_t.y),
+             render::f16tof32(packed_t.z), render::f16tof32(packed_t.w));
+
+    if (!std::isfinite(t.x * t.w - t.y * t.z)) {
+      ++num_degenerate;
+      continue;
+    }
+
+    // As `render_splat.vs.hlsl` compensates clamped splats.
+    float opacity =
+        std::min(opacities[i] * render::f16tof32(opacity_scales[i]), 1.f);
+    AreaResult& result =
+        results[get_opacity_range(opacity, saturated_opacity)];
+    ++result.num_splats;
+    result.fixed_area += get_quad_area(
+        center_pixels, t, render::radius_sigma_over_sqrt_2, screen);
+    result.adaptive_area += get_quad_area(
+        center_pixels, t, render::get_radius_sigma_over_sqrt_2(opacity),
+        screen);
+  }
+  for (const AreaResult& result : results) {
+    total.num_splats += result.num_splats;
+    total.fixed_area += result.fixed_area;
+    total.adaptive_area += result.adaptive_area;
+  }
+
+  double screen_area = static_cast<double>(screen.x) * screen.y;
+  printf("%zu splats, %llu visible (%llu degenerate), %ux%u pixels\n",
+         packed.positions.size(),
+         static_cast<unsigned long long>(total.num_splats + num_degenerate),
+         static_cast<unsigned long long>(num_degenerate), options.width,
+         options.height);
+  printf("%-12s %10s %14s %14s %8s %8s %7s\n", "opacity", "splats",
+         "fixed_px", "adaptive_px", "fixed_x", "adapt_x", "saved");
+  auto print_row = [&](const char* name, const AreaResult& result) {
+    printf("%-12s %10llu %14.0f %14.0f %8.2f %8.2f %6.2f%%\n", name,
+           static_cast<unsigned long long>(result.num_splats),
+           result.fixed_area, result.adaptive_area,
+           result.fixed_area / screen_area, result.adaptive_area / screen_area,
+           get_percentage(result.fixed_area - result.adaptive_area,
+                          result.fixed_area));
+  };
+  for (uint32_t range = 0; range < num_opacity_ranges; ++range) {
+    print_row(opacity_range_names[range], results[range]);
+  }
+  print_row("total", total);
+  printf("footprint limits: %llu culled, %llu clamped\n",
+         static_cast<unsigned long long>(footprint_counts.num_culled),
+         static_cast<unsigned long long>(footprint_counts.num_clamped));
+  return 0;
+}
\ No newline at end of file
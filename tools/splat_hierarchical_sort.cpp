@@ -0,0 +1,222 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Hierarchical sort report.
+ *
+ * Groups the splats of a scene into chunks with `build_chunks`, and reorders
+ * them as an importer would. Then, along a camera path, sorts them with both
+ * `HierarchicalSorter` and `SplatSorter`, and reports the work each does:
+ * splats whose keys are computed, and splats moved by radix passes (an
+ * estimate for `SplatSorter`, see `num_flat_scattered`), along with the
+ * clusters sorted and the time taken. Each view also checks that
+ * both sorters draw the same splats, in key order.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_hierarchical_sort.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp import/splat_chunks.cpp \
+ *       import/splat_morton.cpp import/splat_covariance.cpp \
+ *       render/splat_hierarchical_sort.cpp render/splat_chunk_culling.cpp \
+ *       render/splat_sort.cpp import/splat_logging.cpp \
+ *       import/splat_parallel.cpp import/splat_tracing.cpp \
+ *       import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_hierarchical_sort
+ *
+ * Usage:
+ *
+ *   splat_hierarchical_sort (<file.ply> | --synthetic <n>) [--objects <n>]
+ *                           [--chunk-size <splats>] [--max-span <scales>]
+ *                           [--width <pixels>] [--height <pixels>]
+ *                           [--fov <degrees>] [--views <n>]
+ *                           [--precision <bits>]
+ *
+ * The camera path is that of `make_orbit_view`. `--objects` scatters the
+ * scene into separate objects (see `scatter_scene`), as in sparse scenes,
+ * where most of the savings are. `--max-span` sets
+ * `ChunkSettings::max_span_scales`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "import/splat_chunks.h"
+#include "import/splat_logging.h"
+#include "render/splat_hierarchical_sort.h"
+#include "render/splat_sort.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t num_objects = 0;
+  uint32_t splats_per_chunk = import::ChunkSettings().splats_per_chunk;
+  float max_span_scales = import::ChunkSettings().max_span_scales;
+  uint32_t width = 1920;
+  uint32_t height = 1920;
+  float fov_y_degrees = 90.f;
+  uint32_t num_views = 4;
+  uint32_t precision = render::distance_precision;
+};
+
+/**
+ * Reorders `values` by `order`, e.g. `SplatChunks::order`.
+ */
+template <typename T>
+void reorder(std::vector<T>& values, const std::vector<uint32_t>& order) {
+  std::vector<T> reordered(values.size());
+  import::apply_order<T>(values, order, reordered);
+  values.swap(reordered);
+}
+
+/**
+ * @return Whether `sorted` and `expected` hold the same `num_visible` splats,
+ * with `sorted` in key order.
+ */
+bool is_same_order(std::span<const render::SortedSplat> sorted,
+                   std::span<const render::SortedSplat> expected,
+                   uint32_t num_visible) {
+  std::vector<uint32_t> keys(num_visible);
+  for (uint32_t i = 0; i < num_visible; ++i) {
+    if (i > 0 && sorted[i].distance < sorted[i - 1].distance) {
+      return false;
+    }
+    keys[i] = sorted[i].index;
+  }
+  std::vector<uint32_t> expected_keys(num_visible);
+  for (uint32_t i = 0; i < num_visible; ++i) {
+    expected_keys[i] = expected[i].index;
+  }
+  std::sort(keys.begin(), keys.end());
+  std::sort(expected_keys.begin(), expected_keys.end());
+  return keys == expected_keys;
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--objects" && i + 1 < argc) {
+      options.num_objects = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--chunk-size" && i + 1 < argc) {
+      options.splats_per_chunk =
+          static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--max-span" && i + 1 < argc) {
+      options.max_span_scales = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--views" && i + 1 < argc) {
+      options.num_views = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--precision" && i + 1 < argc) {
+      options.precision = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.splats_per_chunk > 0;
+  is_valid &= options.max_span_scales >= 0.f;
+  is_valid &= options.width > 0 && options.height > 0 && options.num_views > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  is_valid &= options.precision == 16 || options.precision == 32;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--objects <n>] "
+            "[--chunk-size <splats>] [--max-span <scales>] "
+            "[--width <pixels>] [--height <pixels>] [--fov <degrees>] "
+            "[--views <n>] [--precision <16|32>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  if (options.num_objects > 0) {
+    scatter_scene(options.num_objects, scene);
+  }
+  size_t num_splats = scene.positions.size();
+
+  import::ChunkSettings chunk_settings;
+  chunk_settings.splats_per_chunk = options.splats_per_chunk;
+  chunk_settings.max_span_scales = options.max_span_scales;
+  import::SplatChunks chunks;
+  if (!import::build_chunks(scene.positions, scene.rotations, scene.scales,
+                            chunk_settings, chunks)) {
+    return 1;
+  }
+  reorder(scene.positions, chunks.order);
+  PackedPositions packed = pack_positions(scene);
+  printf("%zu splats, %zu chunks\n", num_splats, chunks.chunks.size());
+
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+
+  printf("%6s %10s %9s %11s %8s %10s %9s %10s %9s\n", "view", "visible",
+         "clusters", "max_cluster", "keyed", "scattered", "flat", "hier_ms",
+         "flat_ms");
+  render::HierarchicalSorter hierarchical_sorter;
+  render::SplatSorter sorter;
+  std::vector<render::SortedSplat> sorted(num_splats);
+  std::vector<render::SortedSplat> expected(num_splats);
+  bool is_valid_order = true;
+  for (uint32_t view = 0; view < options.num_views; ++view) {
+    render::DistanceParams params = make_distance_params(
+        packed, make_orbit_view(scene, view, options.num_views),
+        options.fov_y_degrees, aspect);
+    params.precision = options.precision;
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t num_visible = hierarchical_sorter.sort(
+        packed.positions, chunks.chunks, params, 100.f, sorted);
+    double hierarchical_milliseconds = get_milliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    uint32_t num_expected = sorter.sort(packed.positions, params, expected);
+    double flat_milliseconds = get_milliseconds(start);
+
+    is_valid_order &= num_visible == num_expected &&
+                      is_same_order(sorted, expected, num_visible);
+    const render::HierarchicalSortStats& stats =
+        hierarchical_sorter.get_stats();
+    printf("%6u %10u %9u %11u %7.1f%% %10llu %9llu %10.2f %9.2f\n", view,
+           num_visible, stats.num_clusters, stats.max_cluster_splats,
+           num_splats ? 100.0 * static_cast<double>(stats.num_keyed) /
+                            static_cast<double>(num_splats)
+                      : 0.0,
+           static_cast<unsigned long long>(stats.num_scattered),
+           static_cast<unsigned long long>(stats.num_flat_scattered),
+           hierarchical_milliseconds, flat_milliseconds);
+  }
+  if (!is_valid_order) {
+    fprintf(stderr, "error: hierarchical order differs from the flat sort\n");
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,220 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Incremental sort report.
+ *
+ * Moves the camera slowly along a path, as in VR, and sorts each frame with
+ * both `IncrementalSorter` and `SplatSorter`, once per `skip_threshold`. For
+ * each threshold, reports how the frames' orders were produced, the average
+ * time of each sorter, and the splats culled late: drawn by one sorter but not
+ * the other, as skipped frames keep the previous frame's culling. Frames which
+ * weren't skipped are checked to draw the same splats as the full sort, in key
+ * order.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_incremental_sort.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_incremental_sort.cpp \
+ *       render/splat_sort.cpp import/splat_logging.cpp \
+ *       import/splat_parallel.cpp import/splat_tracing.cpp \
+ *       import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_incremental_sort
+ *
+ * Usage:
+ *
+ *   splat_incremental_sort (<file.ply> | --synthetic <n>) [--frames <n>]
+ *                          [--step <degrees>] [--skip-threshold <keys>]...
+ *                          [--width <pixels>] [--height <pixels>]
+ *                          [--fov <degrees>]
+ *
+ * The camera path is that of `make_orbit_view`, turning by `--step` degrees
+ * per frame (rounded to a whole number of frames per turn). Thresholds
+ * default to 0 and 1.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_incremental_sort.h"
+#include "render/splat_sort.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t num_frames = 100;
+  float step_degrees = 0.1f;
+  std::vector<uint32_t> skip_thresholds;
+  uint32_t width = 1920;
+  uint32_t height = 1920;
+  float fov_y_degrees = 90.f;
+};
+
+constexpr uint32_t num_results = 4;
+
+/**
+ * Totals over the camera path, for one `skip_threshold`.
+ */
+struct PathStats {
+  /**
+   * Frames per `IncrementalSortResult`.
+   */
+  uint32_t num_frames[num_results] = {};
+  double milliseconds = 0.;
+  double full_milliseconds = 0.;
+  /**
+   * Splats drawn by only one of the sorters, summed over frames.
+   */
+  uint64_t num_late = 0;
+  uint64_t max_late = 0;
+  /**
+   * Whether every frame that wasn't skipped matched the full sort.
+   */
+  bool is_valid = true;
+};
+
+PathStats run_path(const Scene& scene, const PackedPositions& packed,
+                   const Options& options, uint32_t skip_threshold) {
+  render::IncrementalSortSettings settings;
+  settings.skip_threshold = skip_threshold;
+  render::IncrementalSorter incremental_sorter(settings);
+  render::SplatSorter sorter;
+  std::vector<render::SortedSplat> expected(packed.positions.size());
+  // Frame (plus one) in which each splat was last drawn by the full sort.
+  std::vector<uint32_t> expected_frame(packed.positions.size());
+
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+  uint32_t frames_per_turn = std::max(
+      static_cast<uint32_t>(std::lround(360.f / options.step_degrees)), 1u);
+
+  PathStats stats;
+  for (uint32_t frame = 0; frame < options.num_frames; ++frame) {
+    render::DistanceParams params = make_distance_params(
+        packed, make_orbit_view(scene, frame, frames_per_turn),
+        options.fov_y_degrees, aspect);
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t num_visible = incremental_sorter.sort(packed.positions, params);
+    stats.milliseconds += get_milliseconds(start);
+    render::IncrementalSortResult result =
+        incremental_sorter.get_stats().result;
+    ++stats.num_frames[static_cast<uint32_t>(result)];
+
+    start = std::chrono::steady_clock::now();
+    uint32_t num_expected = sorter.sort(packed.positions, params, expected);
+    stats.full_milliseconds += get_milliseconds(start);
+
+    for (uint32_t i = 0; i < num_expected; ++i) {
+      expected_frame[expected[i].index] = frame + 1;
+    }
+    std::span<const render::SortedSplat> sorted =
+        incremental_sorter.get_sorted();
+    uint64_t num_shared = 0;
+    bool is_ordered = true;
+    for (uint32_t i = 0; i < num_visible; ++i) {
+      num_shared += expected_frame[sorted[i].index] == frame + 1;
+      is_ordered &= i == 0 || sorted[i - 1].distance <= sorted[i].distance;
+    }
+    uint64_t num_late = num_visible + num_expected - 2 * num_shared;
+    stats.num_late += num_late;
+    stats.max_late = std::max(stats.max_late, num_late);
+    stats.is_valid &= is_ordered;
+    if (result != render::IncrementalSortResult::Skipped) {
+      stats.is_valid &= num_late == 0;
+    }
+  }
+  return stats;
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--frames" && i + 1 < argc) {
+      options.num_frames = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--step" && i + 1 < argc) {
+      options.step_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--skip-threshold" && i + 1 < argc) {
+      options.skip_thresholds.push_back(
+          static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.num_frames > 0 && options.step_degrees > 0.f;
+  is_valid &= options.width > 0 && options.height > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--frames <n>] "
+            "[--step <degrees>] [--skip-threshold <keys>]... "
+            "[--width <pixels>] [--height <pixels>] [--fov <degrees>]\n",
+            argv[0]);
+    return 1;
+  }
+  if (options.skip_thresholds.empty()) {
+    options.skip_thresholds = {0, 1};
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  PackedPositions packed = pack_positions(scene);
+  printf("%zu splats, %u frames, %g degrees per frame\n",
+         packed.positions.size(), options.num_frames, options.step_degrees);
+
+  printf("%9s %8s %9s %8s %6s %9s %9s %10s %9s\n", "threshold", "skipped",
+         "unchanged", "repaired", "full", "inc_ms", "full_ms", "late",
+         "max_late");
+  bool is_valid_order = true;
+  for (uint32_t skip_threshold : options.skip_thresholds) {
+    PathStats stats = run_path(scene, packed, options, skip_threshold);
+    double num_frames = static_cast<double>(options.num_frames);
+    printf("%9u %8u %9u %8u %6u %9.2f %9.2f %10.1f %9llu\n", skip_threshold,
+           stats.num_frames[0], stats.num_frames[1], stats.num_frames[2],
+           stats.num_frames[3], stats.milliseconds / num_frames,
+           stats.full_milliseconds / num_frames,
+           static_cast<double>(stats.num_late) / num_frames,
+           static_cast<unsigned long long>(stats.max_late));
+    is_valid_order &= stats.is_valid;
+  }
+  if (!is_valid_order) {
+    fprintf(stderr, "error: incremental order differs from the full sort\n");
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
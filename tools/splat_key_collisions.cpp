@@ -0,0 +1,289 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Sort key collision report.
+ *
+ * Computes sort keys for a scene from one viewpoint with each distance
+ * encoding (see `DistanceEncoding`), and reports how many visible splats
+ * share their key with another one at a different depth. Splats with equal
+ * keys are drawn in an arbitrary order, which shows up as popping when the
+ * camera moves, so this helps to pick the encoding and precision for a
+ * scene's depth range. Splats closer in depth than `--tolerance` (e.g. due to
+ * position quantization) are considered equally deep, so don't collide.
+ *
+ * Collisions are also broken down by depth quartile (near to far), as
+ * encodings differ mostly in where they spend their precision.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_key_collisions.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_sort.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_key_collisions
+ *
+ * Usage:
+ *
+ *   splat_key_collisions (<file.ply> | --synthetic <n>) [--precision <bits>]
+ *                        [--near <cm>] [--far <cm>] [--tolerance <cm>]
+ *                        [--fov <degrees>] [--eye <x> <y> <z>]
+ *                        [--target <x> <y> <z>]
+ *
+ * Positions are in meters, in the importer's axes (X+ forward, Y+ right, Z+
+ * up). By default, the camera is the first view of `make_orbit_view`.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_sort.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+using render::DistanceEncoding;
+using render::DistanceParams;
+
+constexpr uint32_t num_quartiles = 4;
+
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t precision = render::distance_precision;
+  float near_cm = 10.f;
+  float far_cm = 100000.f;
+  float tolerance_cm = 0.1f;
+  float fov_y_degrees = 90.f;
+  bool has_eye = false;
+  bool has_target = false;
+  Float3 eye;
+  Float3 target;
+};
+
+struct CollisionResult {
+  uint64_t num_visible = 0;
+  uint64_t num_unique_keys = 0;
+  /**
+   * Visible splats sharing their key with at least one other, more than the
+   * depth tolerance away.
+   */
+  uint64_t num_colliding = 0;
+  uint64_t max_bucket_size = 0;
+  uint64_t num_colliding_per_quartile[num_quartiles] = {};
+  uint64_t num_visible_per_quartile[num_quartiles] = {};
+};
+
+const char* get_encoding_name(DistanceEncoding encoding) {
+  switch (encoding) {
+    case DistanceEncoding::ClipDepth:
+      return "clip_depth";
+    case DistanceEncoding::LinearDepth:
+      return "linear_depth";
+    case DistanceEncoding::LogDepth:
+      return "log_depth";
+    case DistanceEncoding::FloatFlip:
+      return "float_flip";
+  }
+  return "unknown";
+}
+
+/**
+ * @param depths - Per splat, exact view depth.
+ * @param depth_ranks - Per splat, rank of its view depth among visible splats
+ * (nearest first).
+ */
+CollisionResult measure_collisions(const std::vector<uint32_t>& keys,
+                                   uint32_t not_visible,
+                                   const std::vector<float>& depths,
+                                   const std::vector<uint32_t>& depth_ranks,
+                                   uint64_t num_visible, float tolerance_cm) {
+  struct Entry {
+    uint32_t key;
+    uint32_t index;
+  };
+  std::vector<Entry> entries;
+  entries.reserve(num_visible);
+  for (uint32_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] != not_visible) {
+      entries.push_back({keys[i], i});
+    }
+  }
+  std::sort(entries.begin(), entries.end(),
+            [&](const Entry& a, const Entry& b) {
+              return a.key != b.key ? a.key < b.key
+                                    : depths[a.index] < depths[b.index];
+            });
+
+  CollisionResult result;
+  result.num_visible = entries.size();
+  auto get_quartile = [&](uint32_t index) {
+    return static_cast<uint32_t>(depth_ranks[index] * num_quartiles /
+                                 num_visible);
+  };
+  for (const Entry& entry : entries) {
+    ++result.num_visible_per_quartile[get_quartile(entry.index)];
+  }
+
+  for (size_t begin = 0, end = 0; begin < entries.size(); begin = end) {
+    end = begin + 1;
+    while (end < entries.size() && entries[end].key == entries[begin].key) {
+      ++end;
+    }
+    ++result.num_unique_keys;
+    uint64_t bucket_size = end - begin;
+    result.max_bucket_size = std::max(result.max_bucket_size, bucket_size);
+    // Sorted by depth within buckets, so the furthest apart splats of a
+    // bucket are at its ends.
+    float min_depth = depths[entries[begin].index];
+    float max_depth = depths[entries[end - 1].index];
+    for (size_t i = begin; i < end; ++i) {
+      float depth = depths[entries[i].index];
+      if (depth - min_depth > tolerance_cm ||
+          max_depth - depth > tolerance_cm) {
+        ++result.num_colliding;
+        ++result.num_colliding_per_quartile[get_quartile(entries[i].index)];
+      }
+    }
+  }
+  return result;
+}
+
+double get_percentage(uint64_t count, uint64_t total) {
+  return total != 0 ? 100. * static_cast<double>(count) /
+                          static_cast<double>(total)
+                    : 0.;
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--precision" && i + 1 < argc) {
+      options.precision = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--near" && i + 1 < argc) {
+      options.near_cm = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--far" && i + 1 < argc) {
+      options.far_cm = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--tolerance" && i + 1 < argc) {
+      options.tolerance_cm = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--eye") {
+      is_valid = options.has_eye = parse_float3(argc, argv, i, options.eye);
+    } else if (arg == "--target") {
+      is_valid = options.has_target =
+          parse_float3(argc, argv, i, options.target);
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.precision >= 1 && options.precision <= 24;
+  is_valid &= options.near_cm > 0.f && options.far_cm > options.near_cm;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--precision <1-24>] "
+            "[--near <cm>] [--far <cm>] [--tolerance <cm>] [--fov <degrees>] "
+            "[--eye <x> <y> <z>] [--target <x> <y> <z>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  PackedPositions packed = pack_positions(scene);
+
+  View view = make_orbit_view(scene, 0, 1);
+  view.eye = options.has_eye ? options.eye : view.eye;
+  view.target = options.has_target ? options.target : view.target;
+
+  DistanceParams params = make_distance_params(
+      packed, view, options.fov_y_degrees, 1.f, options.near_cm);
+  params.distance_near_cm = options.near_cm;
+  params.distance_far_cm = options.far_cm;
+
+  // Rank visible splats by exact view depth (clip space w), from the same
+  // quantized positions the keys are computed from.
+  std::vector<uint32_t> keys(packed.positions.size());
+  render::compute_distances(packed.positions, params, keys);
+  uint32_t default_not_visible = render::get_distance_not_visible(params);
+  std::vector<uint32_t> visible;
+  std::vector<float> depths(packed.positions.size());
+  for (uint32_t i = 0; i < packed.positions.size(); ++i) {
+    if (keys[i] != default_not_visible) {
+      Float4 pos_local = render::unpack_pos(
+          packed.positions[i], params.pos_scale_cm, params.pos_min_cm);
+      depths[i] = mul(pos_local, params.local_to_clip).w;
+      visible.push_back(i);
+    }
+  }
+  std::sort(visible.begin(), visible.end(),
+            [&](uint32_t a, uint32_t b) { return depths[a] < depths[b]; });
+  std::vector<uint32_t> depth_ranks(packed.positions.size());
+  for (uint32_t rank = 0; rank < visible.size(); ++rank) {
+    depth_ranks[visible[rank]] = rank;
+  }
+
+  printf("%zu splats, %zu visible, depth %.0f - %.0f cm\n",
+         packed.positions.size(), visible.size(),
+         visible.empty() ? 0. : depths[visible.front()],
+         visible.empty() ? 0. : depths[visible.back()]);
+  printf("%-13s %5s %12s %9s %10s %8s %8s %8s %8s\n", "encoding", "bits",
+         "unique_keys", "colliding", "max_bucket", "q0_near", "q1", "q2",
+         "q3_far");
+
+  struct Config {
+    DistanceEncoding encoding;
+    uint32_t precision;
+  };
+  std::vector<Config> configs = {
+      {DistanceEncoding::ClipDepth, options.precision},
+      {DistanceEncoding::LinearDepth, options.precision},
+      {DistanceEncoding::LogDepth, options.precision},
+      {DistanceEncoding::FloatFlip, options.precision},
+      {DistanceEncoding::FloatFlip, 32},
+  };
+  for (const Config& config : configs) {
+    params.encoding = config.encoding;
+    params.precision = config.precision;
+    render::compute_distances(packed.positions, params, keys);
+    CollisionResult result = measure_collisions(
+        keys, render::get_distance_not_visible(params), depths, depth_ranks,
+        visible.size(), options.tolerance_cm);
+
+    printf("%-13s %5u %12llu %8.2f%% %10llu",
+           get_encoding_name(config.encoding), config.precision,
+           static_cast<unsigned long long>(result.num_unique_keys),
+           get_percentage(result.num_colliding, result.num_visible),
+           static_cast<unsigned long long>(result.max_bucket_size));
+    for (uint32_t quartile = 0; quartile < num_quartiles; ++quartile) {
+      printf(" %7.2f%%",
+             get_percentage(result.num_colliding_per_quartile[quartile],
+                            result.num_visible_per_quartile[quartile]));
+    }
+    printf("\n");
+  }
+  return 0;
+}
\ No newline at end of file
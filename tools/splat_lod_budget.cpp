@@ -0,0 +1,190 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Level of detail report.
+ *
+ * Builds the LOD hierarchy of a scene with `build_lod`, and reports its levels
+ * and build time. Then, along a camera path, selects a cut within a splat
+ * budget with `select_lod_cut`, and sorts it with `SplatSorter::sort_subset`,
+ * reporting the size of each cut, the largest projected error left in it, and
+ * the time taken by each step.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_lod_budget.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp import/splat_lod.cpp \
+ *       import/splat_morton.cpp import/splat_covariance.cpp \
+ *       render/splat_lod.cpp render/splat_sort.cpp import/splat_logging.cpp \
+ *       import/splat_parallel.cpp import/splat_tracing.cpp \
+ *       import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_lod_budget
+ *
+ * Usage:
+ *
+ *   splat_lod_budget (<file.ply> | --synthetic <n>) [--budget <splats>]
+ *                    [--max-error <pixels>] [--width <pixels>]
+ *                    [--height <pixels>] [--fov <degrees>] [--views <n>]
+ *
+ * Positions are in meters, in the importer's axes (X+ forward, Y+ right, Z+
+ * up). The camera path is that of `make_orbit_view`, with `--views` views.
+ * The budget defaults to a quarter of the splats.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_lod.h"
+#include "render/splat_sort.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t budget = 0;
+  float max_error_pixels = 1.f;
+  uint32_t width = 1920;
+  uint32_t height = 1920;
+  float fov_y_degrees = 90.f;
+  uint32_t num_views = 4;
+};
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--budget" && i + 1 < argc) {
+      options.budget = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--max-error" && i + 1 < argc) {
+      options.max_error_pixels = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--views" && i + 1 < argc) {
+      options.num_views = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.width > 0 && options.height > 0 && options.num_views > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--budget <splats>] "
+            "[--max-error <pixels>] [--width <pixels>] [--height <pixels>] "
+            "[--fov <degrees>] [--views <n>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  size_t num_splats = scene.positions.size();
+  if (options.budget == 0) {
+    options.budget = static_cast<uint32_t>(std::max<size_t>(num_splats / 4, 1));
+  }
+
+  std::vector<float> opacities = get_opacities(scene);
+  std::vector<Float4> colors(num_splats);
+  for (size_t i = 0; i < num_splats; ++i) {
+    const Color& color = scene.colors[i];
+    colors[i] = Float4(color.r / 255.f, color.g / 255.f, color.b / 255.f,
+                       opacities[i]);
+  }
+
+  import::SplatLod lod;
+  auto start = std::chrono::steady_clock::now();
+  if (!import::build_lod(scene.positions, scene.rotations, scene.scales,
+                         colors, import::LodSettings(), lod)) {
+    return 1;
+  }
+  double build_milliseconds = get_milliseconds(start);
+  printf("%zu splats, %zu nodes, %zu levels, built in %.1f ms\n", num_splats,
+         lod.nodes.size(), lod.level_offsets.size() - 1, build_milliseconds);
+  for (size_t level = 0; level + 1 < lod.level_offsets.size(); ++level) {
+    uint32_t num_leaves = 0;
+    for (uint32_t node = lod.level_offsets[level];
+         node < lod.level_offsets[level + 1]; ++node) {
+      num_leaves += lod.nodes[node].num_children == 0;
+    }
+    printf("  level %2zu: %10u nodes, %10u leaves\n", level,
+           lod.level_offsets[level + 1] - lod.level_offsets[level],
+           num_leaves);
+  }
+
+  // Pack all nodes, as an asset would.
+  Scene lod_scene;
+  lod_scene.positions = lod.positions;
+  lod_scene.rotations = lod.rotations;
+  lod_scene.scales = lod.scales;
+  lod_scene.min = scene.min;
+  lod_scene.max = scene.max;
+  PackedPositions packed = pack_positions(lod_scene);
+
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+
+  printf("budget %u splats, max error %g pixels\n", options.budget,
+         options.max_error_pixels);
+  printf("%6s %10s %10s %10s %12s %10s %10s\n", "view", "cut", "visible",
+         "visited", "error_px", "select_ms", "sort_ms");
+  render::SplatSorter sorter;
+  std::vector<uint32_t> indices;
+  std::vector<render::SortedSplat> sorted;
+  for (uint32_t view = 0; view < options.num_views; ++view) {
+    View camera = make_orbit_view(scene, view, options.num_views);
+
+    render::LodCutParams cut_params;
+    cut_params.camera_position = camera.eye;
+    cut_params.focal_length =
+        get_two_focal_length(options.fov_y_degrees, options.height) / 2.f;
+    cut_params.max_error_pixels = options.max_error_pixels;
+    cut_params.max_splats = options.budget;
+    start = std::chrono::steady_clock::now();
+    render::LodCutStats stats =
+        render::select_lod_cut(lod.nodes, lod.positions, cut_params, indices);
+    double select_milliseconds = get_milliseconds(start);
+
+    render::DistanceParams distance_params =
+        make_distance_params(packed, camera, options.fov_y_degrees, aspect);
+    sorted.resize(indices.size());
+    start = std::chrono::steady_clock::now();
+    uint32_t num_visible = sorter.sort_subset(packed.positions, indices,
+                                              distance_params, sorted);
+    double sort_milliseconds = get_milliseconds(start);
+
+    printf("%6u %10zu %10u %10llu %12.3g %10.2f %10.2f\n", view,
+           indices.size(), num_visible,
+           static_cast<unsigned long long>(stats.num_visited),
+           stats.max_error_pixels, select_milliseconds, sort_milliseconds);
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,245 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * Pruning report.
+ *
+ * Classifies the splats of a scene with `classify_splats`, removes those
+ * dropped with `compact_kept`, then merges near-duplicates among the rest with
+ * `merge_duplicates`, and finds outliers with a `KdTree` and `mark_outliers`,
+ * removing those after each step, as an importer would.
+ * Reports how many splats were dropped for each reason, how much the bounds
+ * of the scene shrink, and the time taken by each step.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_prune_report.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp import/splat_pruning.cpp \
+ *       import/splat_kd_tree.cpp import/splat_duplicates.cpp \
+ *       import/splat_covariance.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_prune_report
+ *
+ * Usage:
+ *
+ *   splat_prune_report (<file.ply> | --synthetic <n>)
+ *                      [--min-distance <meters>] [--focal-length <pixels>]
+ *                      [--min-radius <pixels>] [--min-contribution <pixels>]
+ *                      [--neighbors <k>] [--max-std-devs <n>]
+ *                      [--duplicate-cell <meters>]
+ *
+ * Options default to those of `PruneSettings`, `OutlierSettings` and
+ * `DuplicateSettings`. Thresholds of 0 disable the corresponding checks, and a
+ * duplicate cell size of 0 disables merging.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "import/splat_duplicates.h"
+#include "import/splat_logging.h"
+#include "import/splat_pruning.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  import::PruneSettings settings;
+  import::OutlierSettings outlier_settings;
+  import::DuplicateSettings duplicate_settings;
+};
+
+/**
+ * Removes dropped splats from all of `scene`'s arrays.
+ */
+size_t compact_scene(Scene& scene,
+                     std::span<const import::PruneReason> reasons) {
+  size_t num_kept = import::compact_kept<Float3>(scene.positions, reasons);
+  import::compact_kept<Float4>(scene.rotations, reasons);
+  import::compact_kept<Float3>(scene.scales, reasons);
+  import::compact_kept<Color>(scene.colors, reasons);
+  scene.positions.resize(num_kept);
+  scene.rotations.resize(num_kept);
+  scene.scales.resize(num_kept);
+  scene.colors.resize(num_kept);
+  return num_kept;
+}
+
+/**
+ * @return Diagonal of the bounds of `positions`, in meters.
+ */
+float get_bounds_diagonal(const std::vector<Float3>& positions) {
+  if (positions.empty()) {
+    return 0.f;
+  }
+  Float3 min = positions[0];
+  Float3 max = positions[0];
+  for (const Float3& position : positions) {
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], position[axis]);
+      max[axis] = std::max(max[axis], position[axis]);
+    }
+  }
+  return length(max - min);
+}
+
+/**
+ * Moves `count` splats from kept to `reason` in `stats`.
+ */
+void mark(import::PruneStats& stats, import::PruneReason reason,
+          uint64_t count) {
+  stats.counts[static_cast<uint32_t>(import::PruneReason::Kept)] -= count;
+  stats.counts[static_cast<uint32_t>(reason)] += count;
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  import::PruneSettings& settings = options.settings;
+  import::OutlierSettings& outlier_settings = options.outlier_settings;
+  import::DuplicateSettings& duplicate_settings = options.duplicate_settings;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--min-distance" && i + 1 < argc) {
+      settings.min_view_distance = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--focal-length" && i + 1 < argc) {
+      settings.focal_length_pixels = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--min-radius" && i + 1 < argc) {
+      settings.min_radius_pixels = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--min-contribution" && i + 1 < argc) {
+      settings.min_contribution = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--neighbors" && i + 1 < argc) {
+      outlier_settings.num_neighbors =
+          static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--max-std-devs" && i + 1 < argc) {
+      outlier_settings.max_std_devs = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--duplicate-cell" && i + 1 < argc) {
+      duplicate_settings.cell_size = static_cast<float>(atof(argv[++i]));
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= settings.min_view_distance > 0.f;
+  is_valid &= settings.focal_length_pixels > 0.f;
+  is_valid &= duplicate_settings.cell_size >= 0.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) "
+            "[--min-distance <meters>] [--focal-length <pixels>] "
+            "[--min-radius <pixels>] [--min-contribution <pixels>] "
+            "[--neighbors <k>] [--max-std-devs <n>] "
+            "[--duplicate-cell <meters>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  size_t num_splats = scene.positions.size();
+  float diagonal = get_bounds_diagonal(scene.positions);
+  std::vector<float> opacities = get_opacities(scene);
+
+  std::vector<import::PruneReason> reasons(num_splats);
+  auto start = std::chrono::steady_clock::now();
+  import::PruneStats stats =
+      import::classify_splats(scene.positions, scene.rotations, scene.scales,
+                              opacities, settings, reasons);
+  double classify_milliseconds = get_milliseconds(start);
+
+  start = std::chrono::steady_clock::now();
+  size_t num_kept = compact_scene(scene, reasons);
+  double compact_milliseconds = get_milliseconds(start);
+
+  // Colors as floats, and back, for merged splats.
+  start = std::chrono::steady_clock::now();
+  reasons.assign(num_kept, import::PruneReason::Kept);
+  uint64_t num_duplicates = 0;
+  if (duplicate_settings.cell_size > 0.f) {
+    std::vector<Float4> colors(num_kept);
+    for (size_t i = 0; i < num_kept; ++i) {
+      const Color& color = scene.colors[i];
+      colors[i] = Float4(color.r / 255.f, color.g / 255.f, color.b / 255.f,
+                         color.a / 255.f);
+    }
+    num_duplicates =
+        import::merge_duplicates(scene.positions, scene.rotations,
+                                 scene.scales, colors, duplicate_settings,
+                                 reasons);
+    for (size_t i = 0; i < num_kept; ++i) {
+      auto to_u8 = [](float value) {
+        return static_cast<uint8_t>(
+            std::lround(std::clamp(value, 0.f, 1.f) * 255.f));
+      };
+      scene.colors[i] = Color(to_u8(colors[i].x), to_u8(colors[i].y),
+                              to_u8(colors[i].z), to_u8(colors[i].w));
+    }
+  }
+  mark(stats, import::PruneReason::Duplicate, num_duplicates);
+  double duplicate_milliseconds = get_milliseconds(start);
+  start = std::chrono::steady_clock::now();
+  num_kept = compact_scene(scene, reasons);
+  compact_milliseconds += get_milliseconds(start);
+
+  start = std::chrono::steady_clock::now();
+  import::KdTree tree;
+  if (!tree.build(scene.positions)) {
+    return 1;
+  }
+  double build_milliseconds = get_milliseconds(start);
+
+  start = std::chrono::steady_clock::now();
+  reasons.assign(num_kept, import::PruneReason::Kept);
+  uint64_t num_outliers =
+      import::mark_outliers(tree, outlier_settings, reasons);
+  mark(stats, import::PruneReason::Outlier, num_outliers);
+  double outlier_milliseconds = get_milliseconds(start);
+  start = std::chrono::steady_clock::now();
+  num_kept = compact_scene(scene, reasons);
+  compact_milliseconds += get_milliseconds(start);
+
+  printf("%zu splats, seen from %g m at %g px focal length\n", num_splats,
+         settings.min_view_distance, settings.focal_length_pixels);
+  printf("%-18s %12s %8s\n", "reason", "splats", "percent");
+  for (uint32_t reason = 0; reason < import::num_prune_reasons; ++reason) {
+    uint64_t count = stats.counts[reason];
+    printf("%-18s %12llu %7.2f%%\n",
+           import::get_prune_reason_name(
+               static_cast<import::PruneReason>(reason)),
+           static_cast<unsigned long long>(count),
+           num_splats ? 100.0 * static_cast<double>(count) /
+                            static_cast<double>(num_splats)
+                      : 0.0);
+  }
+  printf("%zu splats kept, bounds diagonal %.3g m -> %.3g m\n", num_kept,
+         diagonal, get_bounds_diagonal(scene.positions));
+  printf("classify %.1f ms, duplicates %.1f ms, k-d tree %.1f ms, "
+         "outliers %.1f ms, compact %.1f ms\n",
+         classify_milliseconds, duplicate_milliseconds, build_milliseconds,
+         outlier_milliseconds, compact_milliseconds);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#include "splat_tool_scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <span>
+
+#include "bench/splat_ply_generator.h"
+#include "import/ply/splat_ply_conversion.h"
+#include "import/ply/splat_ply_parsing.h"
+
+namespace tools {
+namespace {
+bool parse_scene(std::span<const uint8_t> file, Scene& scene) {
+  import::ply::SplatParserPly parser;
+  import::Metadata metadata;
+  if (!parser.parse_metadata(file, metadata) ||
+      !import::ply::validate_metadata(metadata)) {
+    return false;
+  }
+
+  scene.positions.resize(metadata.num_splats);
+  scene.rotations.resize(metadata.num_splats);
+  scene.scales.resize(metadata.num_splats);
+  scene.colors.resize(metadata.num_splats);
+  if (!parser.parse_data([&](uint64_t index, import::GetPropertyFn get) {
+        import::ply::convert_splat<Float3, Float4, Color>(
+            index, get, scene.positions, scene.rotations, scene.scales,
+            scene.colors);
+      })) {
+    return false;
+  }
+
+  if (scene.positions.empty()) {
+    log_error("Scene has no splats.");
+    return false;
+  }
+  scene.min = scene.max = scene.positions[0];
+  for (const Float3& position : scene.positions) {
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      scene.min[axis] = std::min(scene.min[axis], position[axis]);
+      scene.max[axis] = std::max(scene.max[axis], position[axis]);
+    }
+  }
+  return true;
+}
+
+/**
+ * Inverse of `unpack_f16`, truncating the dropped significand bits.
+ */
+uint32_t pack_f16(uint32_t s, uint32_t e, uint32_t m, float value,
+                  uint32_t offset) {
+  uint32_t shift = 15 - e - m;
+  uint32_t mask = (1u << (s + e + m)) - 1;
+  return ((render::f32tof16(value) >> shift) & mask) << offset;
+}
+}  // namespace
+
+void print_log(Level level, const char* message) {
+  fprintf(stderr, "%s: %s\n", level == Level::ERROR ? "error" : "warning",
+          message);
+}
+
+bool parse_float3(int argc, char** argv, int& i, Float3& value) {
+  if (i + 3 >= argc) {
+    return false;
+  }
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    value[axis] = static_cast<float>(atof(argv[++i]));
+  }
+  return true;
+}
+
+double get_milliseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+bool load_scene(const char* path, Scene& scene) {
+  std::error_code ec;
+  uintmax_t file_size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    log_error("Unable to open %s.", path);
+    return false;
+  }
+
+  std::vector<uint8_t> file(file_size);
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream.read(reinterpret_cast<char*>(file.data()), file.size())) {
+    log_error("Unable to read %s.", path);
+    return false;
+  }
+  return parse_scene(file, scene);
+}
+
+bool generate_scene(uint64_t num_splats, Scene& scene) {
+  std::vector<uint8_t> file =
+      bench::generate_ply(bench::PlySettings{.num_splats = num_splats});
+  return parse_scene(file, scene);
+}
+
+void scatter_scene(uint32_t num_objects, Scene& scene) {
+  Float3 center = get_center(scene);
+  Float3 size = scene.max - scene.min;
+  float extent = std::max(std::max(size.x, size.y), size.z) * 10.f;
+
+  // Object centers, from a fixed-seed LCG.
+  std::vector<Float3> offsets(num_objects);
+  uint64_t state = 0x5CA77E5ull;
+  for (Float3& offset : offsets) {
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      float t = static_cast<float>(state >> 40) / static_cast<float>(1 << 24);
+      offset[axis] = (t - 0.5f) * extent;
+    }
+  }
+
+  for (size_t i = 0; i < scene.positions.size(); ++i) {
+    Float3& position = scene.positions[i];
+    position = center + offsets[i % num_objects] + (position - center) * 0.1f;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      scene.min[axis] = i == 0 ? position[axis]
+                               : std::min(scene.min[axis], position[axis]);
+      scene.max[axis] = i == 0 ? position[axis]
+                               : std::max(scene.max[axis], position[axis]);
+    }
+  }
+}
+
+PackedPositions pack_positions(const Scene& scene) {
+  constexpr uint32_t unorm_max[3] = {(1 << 11) - 1, (1 << 11) - 1,
+                                     (1 << 10) - 1};
+  constexpr uint32_t shift[3] = {0, 11, 22};
+
+  PackedPositions packed;
+  packed.positions.resize(scene.positions.size());
+  packed.pos_min_cm = scene.min * 100.f;
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    packed.pos_scale_cm[axis] = (scene.max[axis] - scene.min[axis]) * 100.f /
+                                static_cast<float>(unorm_max[axis]);
+  }
+
+  for (size_t i = 0; i < scene.positions.size(); ++i) {
+    uint32_t value = 0;
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+      float extent = scene.max[axis] - scene.min[axis];
+      float t = extent > 0.f
+                    ? (scene.positions[i][axis] - scene.min[axis]) / extent
+                    : 0.f;
+      uint32_t unorm = static_cast<uint32_t>(
+          std::lround(std::clamp(t, 0.f, 1.f) * unorm_max[axis]));
+      value |= unorm << shift[axis];
+    }
+    packed.positions[i] = value;
+  }
+  return packed;
+}
+
+std::vector<render::PackedCovariance> pack_covariances(const Scene& scene) {
+  std::vector<render::PackedCovariance> covariances(scene.positions.size());
+  for (size_t i = 0; i < covariances.size(); ++i) {
+    const Float4& q = scene.rotations[i];
+    Float3 scale_cm = scene.scales[i] * 100.f;
+
+    // Columns of R * S.
+    float rotation[3][3] = {
+        {1 - 2 * (q.y * q.y + q.z * q.z), 2 * (q.x * q.y - q.w * q.z),
+         2 * (q.x * q.z + q.w * q.y)},
+        {2 * (q.x * q.y + q.w * q.z), 1 - 2 * (q.x * q.x + q.z * q.z),
+         2 * (q.y * q.z - q.w * q.x)},
+        {2 * (q.x * q.z - q.w * q.y), 2 * (q.y * q.z + q.w * q.x),
+         1 - 2 * (q.x * q.x + q.y * q.y)}};
+    float M[3][3];
+    for (uint32_t r = 0; r < 3; ++r) {
+      for (uint32_t c = 0; c < 3; ++c) {
+        M[r][c] = rotation[r][c] * scale_cm[c];
+      }
+    }
+    // Σ = M * M^T.
+    auto sig = [&](uint32_t r, uint32_t c) {
+      return M[r][0] * M[c][0] + M[r][1] * M[c][1] + M[r][2] * M[c][2];
+    };
+
+    covariances[i].y = pack_f16(0, 5, 5, sig(0, 0), 22) |
+                       pack_f16(1, 5, 5, sig(0, 1), 11) |
+                       pack_f16(1, 5, 5, sig(0, 2), 0);
+    covariances[i].x = pack_f16(0, 5, 5, sig(1, 1), 22) |
+                       pack_f16(1, 5, 5, sig(1, 2), 11) |
+                       pack_f16(0, 5, 6, sig(2, 2), 0);
+  }
+  return covariances;
+}
+
+std::vector<float> get_opacities(const Scene& scene) {
+  std::vector<float> opacities(scene.colors.size());
+  for (size_t i = 0; i < opacities.size(); ++i) {
+    opacities[i] = scene.colors[i].a / 255.f;
+  }
+  return opacities;
+}
+
+Float3 get_center(const Scene& scene) { return (scene.min + scene.max) * 0.5f; }
+
+View make_orbit_view(const Scene& scene, uint32_t index, uint32_t num_views) {
+  Float3 center = get_center(scene);
+  Float3 start = Float3(scene.min.x, scene.min.y, center.z) - center;
+  float angle = 2.f * std::numbers::pi_v<float> * static_cast<float>(index) /
+                static_cast<float>(num_views);
+  float c = std::cos(angle);
+  float s = std::sin(angle);
+  return View{center + Float3(start.x * c - start.y * s,
+                              start.x * s + start.y * c, start.z),
+              center};
+}
+
+float get_two_focal_length(float fov_y_degrees, uint32_t height) {
+  float f = 1.f / std::tan(fov_y_degrees * std::numbers::pi_v<float> / 360.f);
+  return f * static_cast<float>(height);
+}
+
+render::DistanceParams make_distance_params(const PackedPositions& packed,
+                                            const View& view,
+                                            float fov_y_degrees, float aspect,
+                                            float near_cm) {
+  render::DistanceParams params;
+  params.local_to_clip = make_look_at_local_to_clip(
+      view.eye * 100.f, view.target * 100.f, fov_y_degrees, aspect, near_cm);
+  params.pos_scale_cm = packed.pos_scale_cm;
+  params.pos_min_cm = packed.pos_min_cm;
+  return params;
+}
+
+render::TransformParams make_transform_params(const PackedPositions& packed,
+                                              const View& view,
+                                              float fov_y_degrees,
+                                              uint32_t height) {
+  render::TransformParams params;
+  params.local_to_view =
+      make_look_at_local_to_view(view.eye * 100.f, view.target * 100.f);
+  params.two_focal_length = get_two_focal_length(fov_y_degrees, height);
+  params.pos_scale_cm = packed.pos_scale_cm;
+  params.pos_min_cm = packed.pos_min_cm;
+  return params;
+}
+
+Float4x4 make_look_at_local_to_view(const Float3& eye_cm,
+                                    const Float3& target_cm) {
+  Float3 forward = normalize(target_cm - eye_cm);
+  Float3 right = normalize(cross(Float3(0.f, 0.f, 1.f), forward));
+  Float3 up = cross(forward, right);
+  Float3 axes[3] = {right, up, forward};
+
+  Float4x4 local_to_view = Float4x4::identity();
+  for (uint32_t c = 0; c < 3; ++c) {
+    for (uint32_t r = 0; r < 3; ++r) {
+      local_to_view.m[r][c] = axes[c][r];
+    }
+    local_to_view.m[3][c] = -dot(axes[c], eye_cm);
+  }
+  return local_to_view;
+}
+
+Float4x4 make_look_at_local_to_clip(const Float3& eye_cm,
+                                    const Float3& target_cm,
+                                    float fov_y_degrees, float aspect,
+                                    float near_cm) {
+  Float4x4 local_to_clip = make_look_at_local_to_view(eye_cm, target_cm);
+
+  // Scale x and y to the field of view, move view depth to w, and replace z
+  // with the near plane distance.
+  float f = 1.f / std::tan(fov_y_degrees * std::numbers::pi_v<float> / 360.f);
+  for (uint32_t r = 0; r < 4; ++r) {
+    local_to_clip.m[r][0] *= f / aspect;
+    local_to_clip.m[r][1] *= f;
+    local_to_clip.m[r][3] = local_to_clip.m[r][2];
+    local_to_clip.m[r][2] = 0.f;
+  }
+  local_to_clip.m[3][2] = near_cm;
+  return local_to_clip;
+}
+}  // namespace tools
\ No newline at end of file
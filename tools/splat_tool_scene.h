@@ -0,0 +1,219 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "import/splat_math.h"
+#include "render/splat_sort.h"
+#include "render/splat_transform.h"
+
+namespace tools {
+using import::Float3;
+using import::Float4;
+using import::Float4x4;
+
+/**
+ * Minimal stand-in for an engine color type, as accepted by `convert_splat`.
+ */
+struct Color {
+  Color() = default;
+  Color(uint8_t r, uint8_t g, uint8_t b, uint8_t a) : r(r), g(g), b(b), a(a) {}
+  uint8_t r = 0, g = 0, b = 0, a = 0;
+};
+
+/**
+ * Splats as converted by `convert_splat`, i.e. in meters, with X+ forward,
+ * Y+ right and Z+ up.
+ */
+struct Scene {
+  std::vector<Float3> positions;
+  std::vector<Float4> rotations;
+  std::vector<Float3> scales;
+  std::vector<Color> colors;
+  Float3 min;
+  Float3 max;
+};
+
+/**
+ * Positions packed as the x11y11z10 `positions` buffer read by the shaders,
+ * along with the constants to unpack them (in cm).
+ */
+struct PackedPositions {
+  std::vector<uint32_t> positions;
+  Float3 pos_scale_cm;
+  Float3 pos_min_cm;
+};
+
+/**
+ * Camera of a view, in meters.
+ */
+struct View {
+  Float3 eye;
+  Float3 target;
+};
+
+/**
+ * Near plane distance of the tools' projections.
+ */
+constexpr float default_near_cm = 10.f;
+
+/**
+ * Prints log messages to stderr. Pass to `set_log_recv`.
+ */
+void print_log(Level level, const char* message);
+
+/**
+ * Parses the three values following argument `i`, e.g. of `--eye <x> <y> <z>`.
+ *
+ * @param i - Index of the option. Advanced to its last value.
+ * @param value - Output.
+ * @return Whether there were three values.
+ */
+bool parse_float3(int argc, char** argv, int& i, Float3& value);
+
+/**
+ * @return Time since `start`.
+ */
+double get_milliseconds(std::chrono::steady_clock::time_point start);
+
+/**
+ * Loads a 3DGS `.ply` file. Errors are logged.
+ *
+ * @param path - File to load.
+ * @param scene - Output.
+ * @return Whether the file was loaded.
+ */
+bool load_scene(const char* path, Scene& scene);
+
+/**
+ * Generates a deterministic synthetic scene (see
+ * `bench/splat_ply_generator.h`): splats spread uniformly over a 100m cube.
+ *
+ * @param num_splats - Number of splats.
+ * @param scene - Output.
+ * @return Whether the scene was generated.
+ */
+bool generate_scene(uint64_t num_splats, Scene& scene);
+
+/**
+ * Rearranges a scene into separate objects, e.g. to measure sparse scenes.
+ * Splats are assigned to objects in turn. Each object holds its splats at
+ * their positions in the scene, shrunk 10 times about its center, and
+ * objects are placed at deterministic random points over a cube 10 times the
+ * scene's size. Scales are kept.
+ *
+ * @param num_objects - Number of objects.
+ * @param scene - Input and output. Bounds are updated.
+ */
+void scatter_scene(uint32_t num_objects, Scene& scene);
+
+/**
+ * Quantizes positions over the bounds of the scene.
+ *
+ * @param scene - Scene to pack.
+ * @return Packed positions.
+ */
+PackedPositions pack_positions(const Scene& scene);
+
+/**
+ * Computes each splat's covariance (in cm^2) from its rotation and scale, and
+ * packs it as the `covariances` buffer read by the shaders.
+ *
+ * @param scene - Scene to pack.
+ * @return Packed covariances, one per splat.
+ */
+std::vector<render::PackedCovariance> pack_covariances(const Scene& scene);
+
+/**
+ * @param scene - Scene, for its alpha.
+ * @return Per splat, opacity in [0, 1].
+ */
+std::vector<float> get_opacities(const Scene& scene);
+
+/**
+ * @return Center of the scene's bounds.
+ */
+Float3 get_center(const Scene& scene);
+
+/**
+ * Makes a view of a camera path orbiting the scene about Z+: views look at the
+ * center of the scene from its mid height, evenly spaced around the circle
+ * through its corner nearest X- and Y-. View 0 is at that corner, and is the
+ * tools' default view.
+ *
+ * @param scene - Scene to orbit.
+ * @param index - View index, in [0, num_views).
+ * @param num_views - Number of views of the path.
+ */
+View make_orbit_view(const Scene& scene, uint32_t index, uint32_t num_views);
+
+/**
+ * @param fov_y_degrees - Vertical field of view.
+ * @param height - Screen height, in pixels.
+ * @return Twice the focal length, in pixels, as
+ * `TransformParams::two_focal_length`.
+ */
+float get_two_focal_length(float fov_y_degrees, uint32_t height);
+
+/**
+ * Sets up keys of `packed` seen from `view`, with the projection of
+ * `make_look_at_local_to_clip`. Other parameters keep their defaults.
+ *
+ * @param packed - Positions, for their unpacking constants.
+ * @param view - Camera.
+ * @param fov_y_degrees - Vertical field of view.
+ * @param aspect - Width / height.
+ * @param near_cm - Near plane distance.
+ */
+render::DistanceParams make_distance_params(
+    const PackedPositions& packed, const View& view, float fov_y_degrees,
+    float aspect, float near_cm = default_near_cm);
+
+/**
+ * Sets up transforms of `packed` seen from `view`. Other parameters keep their
+ * defaults.
+ *
+ * @param packed - Positions, for their unpacking constants.
+ * @param view - Camera.
+ * @param fov_y_degrees - Vertical field of view.
+ * @param height - Screen height, in pixels.
+ */
+render::TransformParams make_transform_params(const PackedPositions& packed,
+                                              const View& view,
+                                              float fov_y_degrees,
+                                              uint32_t height);
+
+/**
+ * Builds a view transform: x is right, y is up, and z is the view depth.
+ *
+ * @param eye_cm - Camera position.
+ * @param target_cm - Point the camera looks at. Must not be straight above or
+ * below `eye_cm`.
+ * @return Local (cm) to view (cm) transform.
+ */
+Float4x4 make_look_at_local_to_view(const Float3& eye_cm,
+                                    const Float3& target_cm);
+
+/**
+ * Builds a reversed-Z projection with an infinite far plane, as used by the
+ * engine: clip space w is the view depth, and z is the near plane distance.
+ *
+ * @param eye_cm - Camera position.
+ * @param target_cm - Point the camera looks at. Must not be straight above or
+ * below `eye_cm`.
+ * @param fov_y_degrees - Vertical field of view.
+ * @param aspect - Width / height.
+ * @param near_cm - Near plane distance.
+ * @return Local (cm) to clip space transform.
+ */
+Float4x4 make_look_at_local_to_clip(const Float3& eye_cm,
+                                    const Float3& target_cm,
+                                    float fov_y_degrees, float aspect,
+                                    float near_cm);
+}  // namespace tools
\ No newline at end of file
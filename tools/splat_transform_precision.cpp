@@ -0,0 +1,282 @@
+/*
+  Copyright (c) 2025 PICO Technology Co., Ltd. See LICENSE.md.
+*/
+
+/**
+ * float16 precision report for `compute_transform` in `transform.hlsl`.
+ *
+ * Views a scene along a camera path, and evaluates the transforms of visible
+ * splats with `compute_transform_emulated`, with each stage (see
+ * `TransformStage`) in float32 or float16, against a float64 reference. For
+ * each combination of stages tried, reports the distribution of the relative
+ * error of the drawn ellipses, and how many splats exceed a tolerance, or
+ * become non-finite (e.g. from overflow past 65504).
+ *
+ * Tries all float32 (the error of packing the result alone), all float16,
+ * each stage alone in float16, and all but each stage in float16. Finally,
+ * stages are greedily moved to float16 in order, while the 99th percentile
+ * error stays within the tolerance and no further splats become non-finite,
+ * giving a recommended combination.
+ *
+ * Build (no engine required), e.g.:
+ *
+ *   c++ -std=c++20 -O2 -DSPLAT_EXPORT_API= -I. -pthread \
+ *       tools/splat_transform_precision.cpp tools/splat_tool_scene.cpp \
+ *       bench/splat_ply_generator.cpp render/splat_sort.cpp \
+ *       render/splat_transform.cpp render/splat_transform_precision.cpp \
+ *       import/splat_logging.cpp import/splat_parallel.cpp \
+ *       import/splat_tracing.cpp import/ply/splat_ply_parsing.cpp \
+ *       import/ply/splat_ply_conversion.cpp -o splat_transform_precision
+ *
+ * Usage:
+ *
+ *   splat_transform_precision (<file.ply> | --synthetic <n>)
+ *                             [--width <pixels>] [--height <pixels>]
+ *                             [--fov <degrees>] [--views <n>]
+ *                             [--tolerance <relative error>]
+ *
+ * Positions are in meters, in the importer's axes (X+ forward, Y+ right, Z+
+ * up). The camera path is that of `make_orbit_view`, with `--views` views.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "import/splat_logging.h"
+#include "render/splat_sort.h"
+#include "render/splat_transform_precision.h"
+#include "tools/splat_tool_scene.h"
+
+namespace tools {
+namespace {
+struct Options {
+  const char* path = nullptr;
+  uint64_t num_synthetic_splats = 0;
+  uint32_t width = 1920;
+  uint32_t height = 1920;
+  float fov_y_degrees = 90.f;
+  uint32_t num_views = 4;
+  float tolerance = 0.01f;
+};
+
+/**
+ * A view of the camera path.
+ */
+struct PathView {
+  render::TransformParams transform_params;
+  /**
+   * Whether each splat is inside the view's frustum.
+   */
+  std::vector<bool> is_visible;
+};
+
+/**
+ * Error distribution of a combination of stages, over all views.
+ */
+struct ErrorSummary {
+  uint64_t num_measured = 0;
+  uint64_t num_non_finite = 0;
+  uint64_t num_over_tolerance = 0;
+  double mean = 0.;
+  float p50 = 0.f;
+  float p99 = 0.f;
+  float max = 0.f;
+};
+
+ErrorSummary measure(const PackedPositions& packed,
+                     const std::vector<render::PackedCovariance>& covariances,
+                     const std::vector<PathView>& views,
+                     render::TransformPrecision precision, float tolerance) {
+  ErrorSummary summary;
+  std::vector<float> errors(packed.positions.size());
+  std::vector<float> finite_errors;
+  for (const PathView& view : views) {
+    render::compute_transform_errors(packed.positions, covariances,
+                                     view.transform_params, precision, errors);
+    for (size_t i = 0; i < errors.size(); ++i) {
+      if (!view.is_visible[i] || std::isnan(errors[i])) {
+        continue;
+      }
+      ++summary.num_measured;
+      summary.num_over_tolerance += errors[i] > tolerance;
+      if (std::isinf(errors[i])) {
+        ++summary.num_non_finite;
+      } else {
+        finite_errors.push_back(errors[i]);
+        summary.mean += errors[i];
+      }
+    }
+  }
+  if (finite_errors.empty()) {
+    return summary;
+  }
+  summary.mean /= static_cast<double>(finite_errors.size());
+  auto get_percentile = [&](double percentile) {
+    auto it = finite_errors.begin() +
+              static_cast<ptrdiff_t>(
+                  percentile * static_cast<double>(finite_errors.size() - 1));
+    std::nth_element(finite_errors.begin(), it, finite_errors.end());
+    return *it;
+  };
+  summary.p50 = get_percentile(.5);
+  summary.p99 = get_percentile(.99);
+  summary.max = *std::max_element(finite_errors.begin(), finite_errors.end());
+  return summary;
+}
+
+/**
+ * @return Names of the float16 stages of `precision`, e.g. for reports.
+ */
+std::string get_precision_name(render::TransformPrecision precision) {
+  if (precision == render::transform_all_float32) {
+    return "float32";
+  }
+  if (precision == render::transform_all_float16) {
+    return "float16";
+  }
+  std::string name;
+  for (uint32_t i = 0; i < render::num_transform_stages; ++i) {
+    auto stage = static_cast<render::TransformStage>(i);
+    if (precision & render::get_stage_bit(stage)) {
+      name += name.empty() ? "" : "+";
+      name += render::get_transform_stage_name(stage);
+    }
+  }
+  return name;
+}
+
+void print_summary(const std::string& name, const ErrorSummary& summary) {
+  double over_tolerance =
+      static_cast<double>(summary.num_over_tolerance) /
+      static_cast<double>(std::max<uint64_t>(summary.num_measured, 1));
+  printf("%-40s %10.2e %10.2e %10.2e %10.2e %9.4f%% %10llu\n", name.c_str(),
+         summary.mean, summary.p50, summary.p99, summary.max,
+         100. * over_tolerance,
+         static_cast<unsigned long long>(summary.num_non_finite));
+}
+}  // namespace
+}  // namespace tools
+
+int main(int argc, char** argv) {
+  using namespace tools;
+
+  Options options;
+  bool is_valid = true;
+  for (int i = 1; i < argc && is_valid; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--synthetic" && i + 1 < argc) {
+      options.num_synthetic_splats = strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--width" && i + 1 < argc) {
+      options.width = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--height" && i + 1 < argc) {
+      options.height = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--fov" && i + 1 < argc) {
+      options.fov_y_degrees = static_cast<float>(atof(argv[++i]));
+    } else if (arg == "--views" && i + 1 < argc) {
+      options.num_views = static_cast<uint32_t>(atoi(argv[++i]));
+    } else if (arg == "--tolerance" && i + 1 < argc) {
+      options.tolerance = static_cast<float>(atof(argv[++i]));
+    } else if (arg[0] != '-' && !options.path) {
+      options.path = argv[i];
+    } else {
+      is_valid = false;
+    }
+  }
+  is_valid &= (options.path != nullptr) != (options.num_synthetic_splats != 0);
+  is_valid &= options.width > 0 && options.height > 0 && options.num_views > 0;
+  is_valid &= options.fov_y_degrees > 0.f && options.fov_y_degrees < 180.f;
+  if (!is_valid) {
+    fprintf(stderr,
+            "Usage: %s (<file.ply> | --synthetic <n>) [--width <pixels>] "
+            "[--height <pixels>] [--fov <degrees>] [--views <n>] "
+            "[--tolerance <relative error>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  set_log_recv(print_log);
+
+  Scene scene;
+  if (options.path ? !load_scene(options.path, scene)
+                   : !generate_scene(options.num_synthetic_splats, scene)) {
+    return 1;
+  }
+  PackedPositions packed = pack_positions(scene);
+  std::vector<render::PackedCovariance> covariances = pack_covariances(scene);
+
+  float aspect =
+      static_cast<float>(options.width) / static_cast<float>(options.height);
+
+  std::vector<PathView> views(options.num_views);
+  std::vector<uint32_t> distances(packed.positions.size());
+  uint64_t num_visible = 0;
+  for (uint32_t i = 0; i < options.num_views; ++i) {
+    View camera = make_orbit_view(scene, i, options.num_views);
+    views[i].transform_params = make_transform_params(
+        packed, camera, options.fov_y_degrees, options.height);
+    render::DistanceParams distance_params =
+        make_distance_params(packed, camera, options.fov_y_degrees, aspect);
+    render::compute_distances(packed.positions, distance_params, distances);
+    uint32_t not_visible = render::get_distance_not_visible(distance_params);
+    views[i].is_visible.resize(distances.size());
+    for (size_t j = 0; j < distances.size(); ++j) {
+      views[i].is_visible[j] = distances[j] != not_visible;
+      num_visible += views[i].is_visible[j];
+    }
+  }
+
+  printf("%zu splats, %u views, %llu visible splat views, tolerance %g\n",
+         packed.positions.size(), options.num_views,
+         static_cast<unsigned long long>(num_visible), options.tolerance);
+  printf("%-40s %10s %10s %10s %10s %10s %10s\n", "float16 stages", "mean",
+         "p50", "p99", "max", "over_tol", "non_finite");
+
+  auto report = [&](render::TransformPrecision precision,
+                    const std::string& name) {
+    ErrorSummary summary =
+        measure(packed, covariances, views, precision, options.tolerance);
+    print_summary(name, summary);
+    return summary;
+  };
+
+  ErrorSummary baseline =
+      report(render::transform_all_float32,
+             get_precision_name(render::transform_all_float32));
+  report(render::transform_all_float16,
+         get_precision_name(render::transform_all_float16));
+  for (uint32_t i = 0; i < render::num_transform_stages; ++i) {
+    auto stage = static_cast<render::TransformStage>(i);
+    report(render::get_stage_bit(stage),
+           render::get_transform_stage_name(stage));
+  }
+  for (uint32_t i = 0; i < render::num_transform_stages; ++i) {
+    auto stage = static_cast<render::TransformStage>(i);
+    report(render::transform_all_float16 & ~render::get_stage_bit(stage),
+           std::string("all but ") + render::get_transform_stage_name(stage));
+  }
+
+  printf("greedy:\n");
+  render::TransformPrecision recommended = render::transform_all_float32;
+  for (uint32_t i = 0; i < render::num_transform_stages; ++i) {
+    auto stage = static_cast<render::TransformStage>(i);
+    render::TransformPrecision candidate =
+        recommended | render::get_stage_bit(stage);
+    ErrorSummary summary =
+        report(candidate, std::string("+ ") +
+                              render::get_transform_stage_name(stage));
+    if (summary.p99 <= options.tolerance &&
+        summary.num_non_finite <= baseline.num_non_finite) {
+      recommended = candidate;
+    }
+  }
+  printf("recommended float16 stages: %s\n",
+         recommended == render::transform_all_float32
+             ? "none"
+             : get_precision_name(recommended).c_str());
+  return 0;
+}
\ No newline at end of file